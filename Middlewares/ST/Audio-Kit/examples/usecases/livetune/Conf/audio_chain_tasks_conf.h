@@ -58,6 +58,9 @@ extern "C" {
 #define AudioChain_control_IRQHandler               I2C3_ER_IRQHandler
 #define AudioChain_control_IRQ                      I2C3_ER_IRQn
 
+/* control & low-level process run to completion in the slack left by each process pass */
+#define AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+
 
 #define AUDIO_CHAIN_TASK_DATAINOUT_PRIO 14UL
 
@@ -52,6 +52,8 @@
 #define ST_STATE_FLG_LOG_VERBOSE_OS       (1UL << 4UL)
 #define ST_STATE_FLG_LOG_VERBOSE_CYCLES   (1UL << 5UL)
 
+#define ST_REGISTRY_NB_TASKS              4U  /* AUDIO_CHAIN_TASK_NB */
+
 
 ST_ALIGN_START
 typedef struct st_project_storage
@@ -60,7 +62,10 @@ typedef struct st_project_storage
   uint32_t stateStorage;
   uint8_t  iChunkMemoryPool;
   uint8_t  iAlgoMemoryPool;
-  uint8_t  futurExtention[100 - 2];
+  uint8_t  tTaskQueueDeepness[ST_REGISTRY_NB_TASKS];    /* audio chain tasks sizing set by "tasksize apply", 0: not set */
+  uint8_t  reserved[2];
+  uint32_t tTaskStackSize[ST_REGISTRY_NB_TASKS];        /* bytes, 0: not set */
+  uint8_t  futurExtention[100 - 2 - ST_REGISTRY_NB_TASKS - 2 - (4 * ST_REGISTRY_NB_TASKS)];
 } st_project_storage;
 ST_ALIGN_STOP
 
@@ -74,7 +74,9 @@ void main_hooks_audioInit(void)
 #endif /* USE_BLE_SPEAKER */
 
   AudioChainInstance_init(&params);
+  AudioChainInstance_bootStart();     /* boot-to-first-sample measure, traced at first idle after the first audio run */
   AudioChainInstance_initGraph();
+  AudioChainInstance_bootGraphBuilt();
   AudioChainInstance_initTuning();
 
 #ifdef USE_BLE_SPEAKER
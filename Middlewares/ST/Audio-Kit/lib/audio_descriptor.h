@@ -41,6 +41,7 @@ extern "C" {
 #define AUDIO_ALGO_FLAGS_MISC_IGNORE_ALGO_PARAMS  (1U << 4)     /* params already present in the json plugin and are stronger than the algo exposed to (to allow devel overload) */
 #define AUDIO_ALGO_FLAGS_MISC_DISABLE_AUTO_MOUNT  (1U << 5)     /* The element must have a be mounted by a specific livetune plugin */
 #define AUDIO_ALGO_FLAGS_MISC_SINGLE_INSTANCE     (1U << 6)     /* The Element must be present only once in the graph */
+#define AUDIO_ALGO_FLAGS_MISC_IN_PLACE            (1U << 7)     /* The output chunk may share the input chunk buffer: each sample is read before the same index is written */
 
 /* Exported types ------------------------------------------------------------*/
 typedef uint32_t audio_descriptor_param_flag_t;
@@ -877,7 +877,35 @@ int32_t acPipePlay(acPipe hPipe, acState_t state)
       {
         case AC_START:
         {
-          error = AudioChain_configPendingChunks(hPipe);
+          uint32_t bAutoPrioPlacement = 0UL;
+          uint32_t bOptimChunksType   = 0UL;
+          uint32_t bInPlaceChunks     = 0UL;
+
+          error = acEnvGetConfig("bAutoPrioPlacement", &bAutoPrioPlacement);
+          if (acErrorIsOk(error) && bAutoPrioPlacement)
+          {
+            error = AudioChainInstance_placeAlgos(hPipe);
+          }
+          if (acErrorIsOk(error))
+          {
+            error = acEnvGetConfig("bOptimChunksType", &bOptimChunksType);
+          }
+          if (acErrorIsOk(error) && bOptimChunksType)
+          {
+            error = AudioChainInstance_optimizeChunksType(hPipe);
+          }
+          if (acErrorIsOk(error))
+          {
+            error = AudioChain_configPendingChunks(hPipe);
+          }
+          if (acErrorIsOk(error))
+          {
+            error = acEnvGetConfig("bInPlaceChunks", &bInPlaceChunks);
+          }
+          if (acErrorIsOk(error) && bInPlaceChunks)
+          {
+            error = AudioChainInstance_aliasInPlaceChunks(hPipe);
+          }
 
           if (acErrorIsOk(error))
           {
@@ -905,7 +933,9 @@ int32_t acPipePlay(acPipe hPipe, acState_t state)
           else
           {
             error = AudioError_update(error, AudioChain_deinitTuning(hPipe));
+            error = AudioError_update(error, AudioChainInstance_restoreInPlaceChunks());
             error = AudioError_update(error, AudioChain_deinitGraph(hPipe));
+            AudioChainInstance_resetPlacement();
           }
           if (bLogMalloc)
           {
@@ -919,7 +949,9 @@ int32_t acPipePlay(acPipe hPipe, acState_t state)
         {
           error = acEnvSetConfig("bTraceAsyncronous", AC_FALSE);
           error = AudioError_update(error, AudioChain_deinitTuning(hPipe));
+          error = AudioError_update(error, AudioChainInstance_restoreInPlaceChunks());
           error = AudioError_update(error, AudioChain_deinitGraph(hPipe));
+          AudioChainInstance_resetPlacement();
 
           if (bLogMalloc)
           {
@@ -41,6 +41,38 @@ static const audio_descriptor_param_t s_delay_staticParamsDesc[] =
     .pDefault        = "0.0",
     .pName           = "delay",
     AUDIO_DESC_PARAM_F(delay_static_config_t, delay, 0.0f, 1.0f)
+  },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Delay line length in second (upper bound of the run time delay adjustment); 0 means delay"),
+    .pControl        = AUDIO_ALGO_OPT_STR("slidershort"),
+    .pDefault        = "0.0",
+    .pName           = "maxDelay",
+    AUDIO_DESC_PARAM_F(delay_static_config_t, maxDelay, 0.0f, 1.0f)
+  },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Fractional delay with 3rd order Lagrange interpolation (PCM fixed16, fixed32 and float only); delays below 2 samples are raised to 2 samples"),
+    .pControl        = AUDIO_ALGO_OPT_STR("checkbox"),
+    .pDefault        = "0",
+    .pName           = "interpolation",
+    AUDIO_DESC_PARAM_U8(delay_static_config_t, interpolation, 0U, 1U)
+  }
+};
+
+static const audio_descriptor_param_t s_delay_dynamicParamsDesc[] =
+{
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Delay adjustment in second added to the static delay (negative shortens it); the resulting delay is clamped to [0, maxDelay], [2 samples, maxDelay] with interpolation"),
+    .pControl        = AUDIO_ALGO_OPT_STR("slider"),
+    .pDefault        = "0.0",
+    .pName           = "delayAdjust",
+    AUDIO_DESC_PARAM_F(delay_dynamic_config_t, delayAdjust, -1.0f, 1.0f)
+  },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Delay change ramp duration in second (fractional delay only, integer delay changes are immediate)"),
+    .pControl        = AUDIO_ALGO_OPT_STR("slidershort"),
+    .pDefault        = "0.05",
+    .pName           = "rampTime",
+    AUDIO_DESC_PARAM_F(delay_dynamic_config_t, rampTime, 0.0f, 1.0f)
   }
 };
 
@@ -54,12 +86,19 @@ static const audio_descriptor_params_t s_delay_staticParamTemplate =
   .szBytes           = sizeof(delay_static_config_t)
 };
 
+static const audio_descriptor_params_t s_delay_dynamicParamTemplate =
+{
+  .pParam            = (audio_descriptor_param_t *)s_delay_dynamicParamsDesc,
+  .nbParams          = sizeof(s_delay_dynamicParamsDesc) / sizeof(s_delay_dynamicParamsDesc[0]),
+  .szBytes           = sizeof(delay_dynamic_config_t)
+};
+
 #endif  // AUDIO_CHAIN_ACSDK_USED || AUDIO_CHAIN_CONF_TUNING_CLI_USED
 
 const audio_algo_factory_t AudioChainWrp_delay_factory =
 {
   .pStaticParamTemplate  = AUDIO_ALGO_OPT_TUNING(&s_delay_staticParamTemplate),
-  .pDynamicParamTemplate = AUDIO_ALGO_OPT_TUNING(NULL),
+  .pDynamicParamTemplate = AUDIO_ALGO_OPT_TUNING(&s_delay_dynamicParamTemplate),
   .pControlTemplate      = AUDIO_ALGO_OPT_TUNING(NULL),
   .pCapabilities         = &AudioChainWrp_delay_common,
   .pExecutionCbs         = &AudioChainWrp_delay_cbs
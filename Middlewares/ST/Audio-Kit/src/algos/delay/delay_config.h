@@ -28,11 +28,20 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 typedef struct
 {
-  float   delay; /* Specifies the delay, unit is second */
-  uint8_t ramType;
+  float   delay;         /* Specifies the delay, unit is second */
+  uint8_t ramType;       /* Memory pool of the delay line (long lines are expected in RAMEXT or NOCACHED) */
+  float   maxDelay;      /* Specifies the delay line length, unit is second; 0 means delay */
+  uint8_t interpolation; /* 0: integer delay (truncated), 1: fractional delay with 3rd order Lagrange interpolation, minimum delay is 2 samples */
 }
 delay_static_config_t;
 
+typedef struct
+{
+  float delayAdjust;     /* Delay offset applied at run time on top of the static delay, unit is second; the sum is clamped to [0, maxDelay] ([2 samples, maxDelay] when interpolated) */
+  float rampTime;        /* Duration of the delay change ramp, unit is second (fractional delay only) */
+}
+delay_dynamic_config_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
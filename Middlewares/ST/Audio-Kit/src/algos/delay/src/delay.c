@@ -27,22 +27,42 @@ typedef struct
   bool      isPdmType;          // true if samples are PDM
   bool      isPdmMsbFirst;      // true if samples are PDM MSB first
   bool      isPdmInterleaved;   // true if samples are PDM interleaved (and nbChannels > 1)
+  bool      isFractional;       // true if fractional delay with Lagrange interpolation is used (PCM fixed16, fixed32, float only)
+  uint8_t   sampleType;         // audio_buffer_type_t of input/output buffer
   uint8_t   sampleSize;         // PCM: sample size multiplied by nbChannels if all channels may be copied by block (if interleaved or 1 channel); PDM: 1
   uint8_t   nbChannels;         // number of channels of input/output buffer or 1 if all channels may be copied by block (if interleaved or 1 channel)
   uint32_t  nbSamples;          // number of samples of input/output buffer
   uint32_t  samplesOffset;      // samples offset of input/output buffer
+  uint32_t  fs;                 // sampling frequency
   uint32_t  delaySamples;       // current delay value
+  uint32_t  maxDelaySamples;    // maximum delay value (delay line length without the frame and interpolation margins)
   uint32_t  allocDelaySamples;  // allocated delay size in samples (must be multiplied by nbChannels and sample size to obtain allocated buffer size)
   uint32_t  chDelaySize;        // byte size of 1 channel of delay buffer
   uint32_t  writePos;           // write position inside delay buffer
+  float     staticDelay;        // delay from static config in samples (reference for delayAdjust)
+  float     curDelay;           // fractional delay: current delay in samples
+  float     targetDelay;        // fractional delay: delay to be reached at the end of the ramp in samples
+  float     delayStep;          // fractional delay: delay increment per sample during the ramp
+  float    *pHot;               // fractional delay: float copy of the delay buffer segment read during the frame (TCM)
   uint8_t  *pBuff;              // delay buffer pointer
-  memPool_t memPool;
+  memPool_t memPool;            // delay buffer memory pool
 } delay_context_t;
 
 /* Private defines -----------------------------------------------------------*/
+#define DELAY_CONTEXT_MEM_POOL      AUDIO_MEM_TCM /* context and hot segment are read every sample: keep them close to the core */
+#define DELAY_FRACTIONAL_MIN_DELAY  2.0f          /* Lagrange taps x[n-d-1..n-d+2] must have been received */
+#define DELAY_FRACTIONAL_MARGIN     3UL           /* extra delay buffer samples for interpolation taps */
+#define DELAY_HOT_MARGIN            6UL           /* hot segment = frame + delay ramp over the frame (up to 1 sample/sample) + taps */
+
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static int32_t s_delay_integerDataInOut(audio_algo_t *const pAlgo);
+static void s_delay_fractionalDataInOut(delay_context_t *const pContext, audio_chunk_t const *const pChunkIn, audio_chunk_t const *const pChunkOut);
+
+static inline int16_t s_saturate_int16(float const sampleFloat) { return (sampleFloat <= -32768.0f)      ? (int16_t) -32768       : ((sampleFloat >= 32767.0f)      ? 32767       : (int16_t)sampleFloat); }
+static inline int32_t s_saturate_int32(float const sampleFloat) { return (sampleFloat <= -2147483648.0f) ? (int32_t) -2147483648L : ((sampleFloat >= 2147483647.0f) ? 2147483647L : (int32_t)sampleFloat); }
+
 /* Global variables ----------------------------------------------------------*/
 /* Functions Definition ------------------------------------------------------*/
 int32_t delay_init(audio_algo_t *const pAlgo, bool const delayInSeconds)
@@ -60,13 +80,18 @@ int32_t delay_init(audio_algo_t *const pAlgo, bool const delayInSeconds)
   bool                  const isPdmType         = AudioBuffer_isPdmType(pBuffIn);
   bool                  const isPdmMsbFirst     = (sampleType == ABUFF_FORMAT_PDM_MSB_FIRST);
   bool                  const isInterleaved     = (AudioBuffer_getInterleaved(pBuffIn) == ABUFF_FORMAT_INTERLEAVED);
-  bool                  const blockCopy         = !isPdmType && (isInterleaved || (nbChannels == 1U));  // block copy is not possible for PDM samples
+  bool                  const isPcmType         = (sampleType == ABUFF_FORMAT_FIXED16) || (sampleType == ABUFF_FORMAT_FIXED32) || (sampleType == ABUFF_FORMAT_FLOAT);
+  bool                        isFractional      = false;
+  bool                        blockCopy         = false;
+  float                       staticDelay       = 0.0f;
   uint32_t                    delaySamples      = 0UL;
+  uint32_t                    maxDelaySamples   = 0UL;
   uint32_t                    allocDelaySamples = 0UL;
   uint32_t                    chDelaySize       = 0UL;
-  uint32_t                    buffSize          = 0UL;
+  size_t                      buffSize          = 0UL;
   size_t                      allocSize         = sizeof(delay_context_t);
   delay_context_t            *pContext          = NULL;
+  uint8_t                    *pBuff             = NULL;
   memPool_t                   memPool           = AUDIO_MEM_UNKNOWN;
 
   if (pStaticConfigVoid == NULL)
@@ -81,28 +106,62 @@ int32_t delay_init(audio_algo_t *const pAlgo, bool const delayInSeconds)
     {
       delay_static_config_t const *const pStaticConfig     = (delay_static_config_t const *)pStaticConfigVoid;
       float                        const delaySamplesFloat = pStaticConfig->delay * (float)fs;
+      float                        const maxDelay          = (pStaticConfig->maxDelay > pStaticConfig->delay) ? pStaticConfig->maxDelay : pStaticConfig->delay;
 
-      delaySamples = (uint32_t)delaySamplesFloat;
-      memPool      = (memPool_t)pStaticConfig->ramType;
+      staticDelay     = delaySamplesFloat;
+      delaySamples    = (uint32_t)delaySamplesFloat;
+      maxDelaySamples = (uint32_t)(maxDelay * (float)fs);
+      memPool         = (memPool_t)pStaticConfig->ramType;
+      if (pStaticConfig->interpolation != 0U)
+      {
+        if (isPcmType)
+        {
+          isFractional    = true;
+          maxDelaySamples = (maxDelaySamples < (uint32_t)DELAY_FRACTIONAL_MIN_DELAY) ? (uint32_t)DELAY_FRACTIONAL_MIN_DELAY : maxDelaySamples + 1UL; // ceil
+        }
+        else
+        {
+          AudioAlgo_trace(pAlgo, TRACE_LVL_WARNING, NULL, 0, "interpolation not supported for this sample type: integer delay is used");
+        }
+      }
     }
     else
     {
       delay_samples_static_config_t const *const pStaticConfig = (delay_samples_static_config_t const *)pStaticConfigVoid;
 
-      delaySamples = pStaticConfig->delay;
-      memPool      = (memPool_t)pStaticConfig->ramType;
+      delaySamples    = pStaticConfig->delay;
+      staticDelay     = (float)delaySamples;
+      maxDelaySamples = delaySamples;
+      memPool         = (memPool_t)pStaticConfig->ramType;
     }
 
     // compute delay buffer allocation size
-    allocDelaySamples = nbSamples + (isPdmType ? (((delaySamples + 7UL) >> 3U) << 3U) : delaySamples);  // round it to upper multiple of 8 in case of PDM samples
-    chDelaySize       = isPdmType ? (allocDelaySamples >> 3U) : (allocDelaySamples * (uint32_t)sampleSize);
-    buffSize          = (size_t)nbChannels * (size_t)chDelaySize;
-    allocSize        += buffSize;
-    pContext          = (delay_context_t *)AudioAlgo_malloc(allocSize, memPool);
-    if (pContext == NULL)
+    blockCopy = !isPdmType && !isFractional && (isInterleaved || (nbChannels == 1U));   // block copy is not possible for PDM samples nor for interpolation
+    if (isFractional)
+    {
+      allocDelaySamples = nbSamples + maxDelaySamples + DELAY_FRACTIONAL_MARGIN;
+      allocSize        += (nbSamples * 2UL + DELAY_HOT_MARGIN) * sizeof(float);
+    }
+    else
+    {
+      allocDelaySamples = nbSamples + (isPdmType ? (((maxDelaySamples + 7UL) >> 3U) << 3U) : maxDelaySamples);  // round it to upper multiple of 8 in case of PDM samples
+    }
+    chDelaySize = isPdmType ? (allocDelaySamples >> 3U) : (allocDelaySamples * (uint32_t)sampleSize);
+    buffSize    = (size_t)nbChannels * (size_t)chDelaySize;
+    pContext    = (delay_context_t *)AudioAlgo_malloc(allocSize, DELAY_CONTEXT_MEM_POOL);
+    pBuff       = (uint8_t *)AudioAlgo_malloc(buffSize, memPool);
+    if ((pContext == NULL) || (pBuff == NULL))
     {
       AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "Alloc failed !");
       error = AUDIO_ERR_MGNT_ALLOCATION;
+      if (pContext != NULL)
+      {
+        AudioAlgo_free(pContext, DELAY_CONTEXT_MEM_POOL);
+      }
+      if (pBuff != NULL)
+      {
+        AudioAlgo_free(pBuff, memPool);
+      }
     }
   }
 
@@ -110,19 +169,35 @@ int32_t delay_init(audio_algo_t *const pAlgo, bool const delayInSeconds)
   {
     memset(pContext, 0, sizeof(delay_context_t));
     pContext->memPool           = memPool;
-    pContext->pBuff             = (uint8_t *)&pContext[1];
+    pContext->pBuff             = pBuff;
+    pContext->pHot              = isFractional ? (float *)&pContext[1] : NULL;
     pContext->isPdmType         = isPdmType;
     pContext->isPdmMsbFirst     = isPdmMsbFirst;
     pContext->isPdmInterleaved  = isPdmType && isInterleaved && (nbChannels > 1U);    // to know if PDM samples of the same channel are interleaved or not
+    pContext->isFractional      = isFractional;
+    pContext->sampleType        = (uint8_t)sampleType;
     pContext->chDelaySize       = chDelaySize;
+    pContext->fs                = fs;
     pContext->delaySamples      = delaySamples;
+    pContext->maxDelaySamples   = maxDelaySamples;
     pContext->allocDelaySamples = allocDelaySamples;
     pContext->sampleSize        = blockCopy ? (sampleSize * nbChannels) : sampleSize; // for PCM samples only (see blockCopy definition):
     pContext->nbChannels        = blockCopy ? 1U : nbChannels;                        // if blockCopy, consider 1 channel of nbChannels bigger sampleSize
     pContext->nbSamples         = nbSamples;
     pContext->samplesOffset     = samplesOffset;
+    pContext->staticDelay       = staticDelay;
+    pContext->targetDelay       = (staticDelay < DELAY_FRACTIONAL_MIN_DELAY) ? DELAY_FRACTIONAL_MIN_DELAY : staticDelay;
     memset(pContext->pBuff, (int)AudioBuffer_getSilenceFillByte(pBuffIn), buffSize); // fill delay buffer with silence
     AudioAlgo_setWrapperContext(pAlgo, pContext);
+
+    if (delayInSeconds)
+    {
+      error = delay_configure(pAlgo);
+    }
+    pContext->curDelay  = pContext->targetDelay;  // no ramp at start
+    pContext->delayStep = 0.0f;
+
+    AudioAlgo_trace(pAlgo, TRACE_LVL_LOG, NULL, 0, "%s delay line: %lu bytes per channel in mem pool %d", isFractional ? "fractional" : "integer", chDelaySize, (int)memPool);
   }
 
   if (AudioError_isError(error))
@@ -144,7 +219,44 @@ int32_t delay_deinit(audio_algo_t *const pAlgo)
     memPool_t memPool = pContext->memPool;
 
     AudioAlgo_setWrapperContext(pAlgo, NULL);
-    AudioAlgo_free(pContext, memPool);
+    AudioAlgo_free(pContext->pBuff, memPool);
+    AudioAlgo_free(pContext, DELAY_CONTEXT_MEM_POOL);
+  }
+
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+int32_t delay_configure(audio_algo_t *const pAlgo)
+{
+  delay_context_t              *const pContext       = (delay_context_t *)AudioAlgo_getWrapperContext(pAlgo);
+  delay_dynamic_config_t const *const pDynamicConfig = (delay_dynamic_config_t const *)AudioAlgo_getDynamicConfig(pAlgo);
+
+  // dynamic config is optional: without it, the static delay applies
+  if ((pContext != NULL) && (pDynamicConfig != NULL))
+  {
+    float const maxDelay = (float)pContext->maxDelaySamples;
+    float       delay    = pContext->staticDelay + (pDynamicConfig->delayAdjust * (float)pContext->fs);
+
+    if (pContext->isFractional)
+    {
+      float const rampSamples = pDynamicConfig->rampTime * (float)pContext->fs;
+      float       step;
+
+      // below 2 samples the interpolation taps are not all received yet: shorter delays are raised to the minimum
+      delay = (delay < DELAY_FRACTIONAL_MIN_DELAY) ? DELAY_FRACTIONAL_MIN_DELAY : ((delay > maxDelay) ? maxDelay : delay);
+      step  = (delay - pContext->curDelay) / ((rampSamples > 1.0f) ? rampSamples : 1.0f);
+      step  = (step > 1.0f) ? 1.0f : ((step < -1.0f) ? -1.0f : step);   // delay slope is limited to 1 sample per sample (hot segment size)
+
+      pContext->delayStep   = 0.0f;   // freeze the ramp while target is updated
+      pContext->targetDelay = delay;
+      pContext->delayStep   = step;
+    }
+    else
+    {
+      delay = (delay < 0.0f) ? 0.0f : ((delay > maxDelay) ? maxDelay : delay);
+      pContext->delaySamples = (uint32_t)delay;
+    }
   }
 
   return AUDIO_ERR_MGNT_NONE;
@@ -152,6 +264,25 @@ int32_t delay_deinit(audio_algo_t *const pAlgo)
 
 
 int32_t delay_dataInOut(audio_algo_t *const pAlgo)
+{
+  delay_context_t *const pContext = (delay_context_t *)AudioAlgo_getWrapperContext(pAlgo);
+  int32_t                error    = AUDIO_ERR_MGNT_NONE;
+
+  if (pContext->isFractional)
+  {
+    s_delay_fractionalDataInOut(pContext, AudioAlgo_getChunkPtrIn(pAlgo, 0U), AudioAlgo_getChunkPtrOut(pAlgo, 0U));
+  }
+  else
+  {
+    error = s_delay_integerDataInOut(pAlgo);
+  }
+
+  return error;
+}
+
+
+/* Private Functions Definition ----------------------------------------------*/
+static int32_t s_delay_integerDataInOut(audio_algo_t *const pAlgo)
 {
   int32_t                    error             = AUDIO_ERR_MGNT_NONE;
   delay_context_t     *const pContext          = (delay_context_t *)AudioAlgo_getWrapperContext(pAlgo);
@@ -363,3 +494,171 @@ int32_t delay_dataInOut(audio_algo_t *const pAlgo)
 
   return error;
 }
+
+
+static void s_delay_fractionalDataInOut(delay_context_t *const pContext, audio_chunk_t const *const pChunkIn, audio_chunk_t const *const pChunkOut)
+{
+  uint8_t             const nbChannels        = pContext->nbChannels;
+  uint32_t            const nbSamples         = pContext->nbSamples;
+  uint32_t            const samplesOffset     = pContext->samplesOffset;
+  uint32_t            const allocDelaySamples = pContext->allocDelaySamples;
+  uint32_t            const writePos          = pContext->writePos;
+  audio_buffer_type_t const sampleType        = (audio_buffer_type_t)pContext->sampleType;
+  float               const targetDelay       = pContext->targetDelay;
+  float               const delayStep         = pContext->delayStep;
+  float               const startDelay        = pContext->curDelay;
+  float                     endDelay          = startDelay + (delayStep * (float)nbSamples);
+  float                     minDelay, maxDelay;
+  uint32_t                  hotBack, hotStart, hotSize, size1;
+
+  // delay ramp over the frame: delay is monotonic so its bounds are the frame start and end values
+  if (((delayStep > 0.0f) && (endDelay >= targetDelay)) || ((delayStep < 0.0f) && (endDelay <= targetDelay)) || (delayStep == 0.0f))
+  {
+    endDelay = targetDelay;
+  }
+  minDelay = (startDelay < endDelay) ? startDelay : endDelay;
+  maxDelay = (startDelay < endDelay) ? endDelay   : startDelay;
+
+  // hot segment: delay buffer samples [writePos - hotBack, writePos + nbSamples - 1 - floor(minDelay) + 2] read by the interpolation
+  hotBack  = (uint32_t)maxDelay + 2UL;
+  hotStart = (writePos + allocDelaySamples - hotBack) % allocDelaySamples;
+  hotSize  = nbSamples + hotBack + 2UL - (uint32_t)minDelay;
+  size1    = ((hotStart + hotSize) <= allocDelaySamples) ? hotSize : (allocDelaySamples - hotStart);
+
+  for (uint8_t ch = 0U; ch < nbChannels; ch++)
+  {
+    void  const *const pIn   = AudioChunk_getReadPtr(pChunkIn,   ch, 0UL);
+    void        *const pOut  = AudioChunk_getWritePtr(pChunkOut, ch, 0UL);
+    uint8_t     *const pLine = pContext->pBuff + ((uint32_t)ch * pContext->chDelaySize);
+    float       *const pHot  = pContext->pHot;
+    float              delay = startDelay;
+    uint32_t           pos   = writePos;
+
+    // First step: copy input frame into delay buffer (non-interleaved, native sample type)
+    // then copy hot segment from delay buffer (possibly in external RAM) into TCM as float
+    switch (sampleType)
+    {
+      case ABUFF_FORMAT_FIXED16:
+      {
+        int16_t const *const pSplIn  = (int16_t const *)pIn;
+        int16_t       *const pSplBuf = (int16_t *)pLine;
+
+        for (uint32_t i = 0UL; i < nbSamples; i++)
+        {
+          pSplBuf[pos] = pSplIn[i * samplesOffset];
+          pos          = (pos == (allocDelaySamples - 1UL)) ? 0UL : (pos + 1UL);
+        }
+        for (uint32_t i = 0UL; i < size1; i++)
+        {
+          pHot[i] = (float)pSplBuf[hotStart + i] * (1.0f / 32768.0f);
+        }
+        for (uint32_t i = size1; i < hotSize; i++)
+        {
+          pHot[i] = (float)pSplBuf[i - size1] * (1.0f / 32768.0f);
+        }
+        break;
+      }
+      case ABUFF_FORMAT_FIXED32:
+      {
+        int32_t const *const pSplIn  = (int32_t const *)pIn;
+        int32_t       *const pSplBuf = (int32_t *)pLine;
+
+        for (uint32_t i = 0UL; i < nbSamples; i++)
+        {
+          pSplBuf[pos] = pSplIn[i * samplesOffset];
+          pos          = (pos == (allocDelaySamples - 1UL)) ? 0UL : (pos + 1UL);
+        }
+        for (uint32_t i = 0UL; i < size1; i++)
+        {
+          pHot[i] = (float)pSplBuf[hotStart + i] * (1.0f / 2147483648.0f);
+        }
+        for (uint32_t i = size1; i < hotSize; i++)
+        {
+          pHot[i] = (float)pSplBuf[i - size1] * (1.0f / 2147483648.0f);
+        }
+        break;
+      }
+      default:
+      {
+        float const *const pSplIn  = (float const *)pIn;
+        float       *const pSplBuf = (float *)pLine;
+
+        for (uint32_t i = 0UL; i < nbSamples; i++)
+        {
+          pSplBuf[pos] = pSplIn[i * samplesOffset];
+          pos          = (pos == (allocDelaySamples - 1UL)) ? 0UL : (pos + 1UL);
+        }
+        memcpy(pHot,         &pSplBuf[hotStart], size1             * sizeof(float));
+        memcpy(&pHot[size1], pSplBuf,            (hotSize - size1) * sizeof(float));
+        break;
+      }
+    }
+
+    // Second step: 3rd order Lagrange interpolation (nodes -1, 0, 1, 2) in the hot segment, in place
+    // output sample n is read at hot segment position hotBack + n - delay (>= 1 by construction)
+    for (uint32_t n = 0UL; n < nbSamples; n++)
+    {
+      float    const pos_f = (float)(hotBack + n) - delay;
+      uint32_t const k     = (uint32_t)pos_f;
+      float    const f     = pos_f - (float)k;
+      float    const fp1   = f + 1.0f;
+      float    const fm1   = f - 1.0f;
+      float    const fm2   = f - 2.0f;
+      float    const hm1   = -f   * fm1 * fm2 * (1.0f / 6.0f);
+      float    const h0    =  fp1 * fm1 * fm2 * 0.5f;
+      float    const h1    = -fp1 * f   * fm2 * 0.5f;
+      float    const h2    =  fp1 * f   * fm1 * (1.0f / 6.0f);
+
+      // hot segment positions below k - 1 are not read anymore: output is stored there before being converted
+      pHot[n] = (hm1 * pHot[k - 1UL]) + (h0 * pHot[k]) + (h1 * pHot[k + 1UL]) + (h2 * pHot[k + 2UL]);
+
+      if (delay != endDelay)
+      {
+        delay += delayStep;
+        delay  = (((delayStep > 0.0f) && (delay > endDelay)) || ((delayStep < 0.0f) && (delay < endDelay))) ? endDelay : delay;
+      }
+    }
+
+    // Third step: store output with saturation
+    switch (sampleType)
+    {
+      case ABUFF_FORMAT_FIXED16:
+      {
+        int16_t *const pSplOut = (int16_t *)pOut;
+
+        for (uint32_t n = 0UL; n < nbSamples; n++)
+        {
+          pSplOut[n * samplesOffset] = s_saturate_int16(pHot[n] * 32768.0f);
+        }
+        break;
+      }
+      case ABUFF_FORMAT_FIXED32:
+      {
+        int32_t *const pSplOut = (int32_t *)pOut;
+
+        for (uint32_t n = 0UL; n < nbSamples; n++)
+        {
+          pSplOut[n * samplesOffset] = s_saturate_int32(pHot[n] * 2147483648.0f);
+        }
+        break;
+      }
+      default:
+      {
+        float *const pSplOut = (float *)pOut;
+
+        for (uint32_t n = 0UL; n < nbSamples; n++)
+        {
+          pSplOut[n * samplesOffset] = pHot[n];
+        }
+        break;
+      }
+    }
+  }
+
+  pContext->writePos = (writePos + nbSamples) % allocDelaySamples;
+  pContext->curDelay = endDelay;
+  if ((endDelay == targetDelay) && (pContext->targetDelay == targetDelay))
+  {
+    pContext->delayStep = 0.0f;   // ramp completed (unless a new target has just been configured)
+  }
+}
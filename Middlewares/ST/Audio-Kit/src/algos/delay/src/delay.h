@@ -32,6 +32,7 @@ extern "C" {
 /* Exported functions ------------------------------------------------------- */
 int32_t delay_init(audio_algo_t *const pAlgo, bool const delayInSeconds);
 int32_t delay_deinit(audio_algo_t *const pAlgo);
+int32_t delay_configure(audio_algo_t *const pAlgo);
 int32_t delay_dataInOut(audio_algo_t *const pAlgo);
 
 #ifdef __cplusplus
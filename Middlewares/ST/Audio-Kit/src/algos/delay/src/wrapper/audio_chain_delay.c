@@ -27,6 +27,7 @@
 /* Private function prototypes -----------------------------------------------*/
 static int32_t s_delay_deinit(audio_algo_t    *const pAlgo);
 static int32_t s_delay_init(audio_algo_t      *const pAlgo);
+static int32_t s_delay_configure(audio_algo_t *const pAlgo);
 static int32_t s_delay_dataInOut(audio_algo_t *const pAlgo);
 
 /* Global variables ----------------------------------------------------------*/
@@ -51,14 +52,14 @@ const audio_algo_common_t AudioChainWrp_delay_common =
   .iosOut.interleaving       = AUDIO_CAPABILITY_INTERLEAVING_BOTH,
   .iosOut.time_freq          = AUDIO_CAPABILITY_TIME,
   .iosOut.type               = AUDIO_CAPABILITY_TYPE_ALL,
-  .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("Add a Delay")
+  .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("Add a Delay, optionally fractional and adjustable at run time")
 };
 
 audio_algo_cbs_t AudioChainWrp_delay_cbs =
 {
   .init                       = s_delay_init,
   .deinit                     = s_delay_deinit,
-  .configure                  = NULL,
+  .configure                  = s_delay_configure,
   .dataInOut                  = s_delay_dataInOut,
   .process                    = NULL,
   .control                    = NULL,
@@ -81,6 +82,12 @@ static int32_t s_delay_deinit(audio_algo_t *const pAlgo)
 }
 
 
+static int32_t s_delay_configure(audio_algo_t *const pAlgo)
+{
+  return delay_configure(pAlgo);
+}
+
+
 static int32_t s_delay_dataInOut(audio_algo_t *const pAlgo)
 {
   return delay_dataInOut(pAlgo);
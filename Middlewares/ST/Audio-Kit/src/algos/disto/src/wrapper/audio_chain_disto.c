@@ -85,6 +85,7 @@ const audio_algo_common_t AudioChainWrp_disto_common =
 {
   .pName                     = "disto",
   .misc.pAlgoDesc            = "Guitar distortion",
+  .misc.flags                = AUDIO_ALGO_FLAGS_MISC_IN_PLACE,
   .prio_level                = AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_NORMAL,
   .chunks_consistency.in_out = ABUFF_PARAM_ALL,
   .chunks_consistency.in     = ABUFF_PARAM_NOT_APPLICABLE,
@@ -37,6 +37,15 @@ static const audio_descriptor_param_t s_faust_flanger_staticParamsDesc[] =
     .pName            = "ramType",
     AUDIO_DESC_PARAM_U8(faust_flanger_static_config_t, ramType, 0U, AUDIO_ALGO_RAM_TYPES_NB - 1U)
   },
+  {
+    .pDescription     = AUDIO_ALGO_OPT_STR("RAM type of the delay lines (sized from the sampling rate)"),
+    .pControl         = AUDIO_ALGO_OPT_STR("droplist"),
+    .pKeyValue        = tRamTypeKeyValue,
+    .pDefault         = AUDIOCHAINFACTORY_INT2STR(AUDIO_MEM_RAMINT),
+    .iParamFlag       = AUDIO_DESC_PARAM_TYPE_FLAG_DEFINE_KEY,
+    .pName            = "delayRamType",
+    AUDIO_DESC_PARAM_U8(faust_flanger_static_config_t, delayRamType, 0U, AUDIO_ALGO_RAM_TYPES_NB - 1U)
+  },
 };
 
 static const audio_descriptor_param_t s_faust_flanger_dynamicParamsDesc[] =
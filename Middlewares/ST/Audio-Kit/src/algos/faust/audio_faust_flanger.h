@@ -35,6 +35,7 @@ extern "C" {
 typedef struct
 {
   uint8_t ramType;
+  uint8_t delayRamType;
 } faust_flanger_static_config_t;
 
 typedef struct
@@ -19,11 +19,13 @@
 /* Includes ------------------------------------------------------------------*/
 #include "faust/audio_chain_faust_distortion.h"
 #include <assert.h>
+#include <stdbool.h>
 /*cstat -MISRAC2012-* CMSIS not misra compliant */
 #include <arm_math.h>
 /*cstat +MISRAC2012-* */
 #include "sfc.h"
 #include "common/commonMath.h"
+#include "audio_chain_faust_wrapper.h"
 
 /* ARM CMSIS DSP optimization */
 #define sinf  arm_sin_f32
@@ -49,6 +51,7 @@ typedef struct
   sfcContext_t         sfcOutContext;
   FAUSTFLOAT          *pScratchSample[2];
   memPool_t            memPool;
+  bool                 bDirect;
 
   mydsp               dsp;
   const faust_distortion_dynamic_config_t *pDynamic;
@@ -176,13 +179,14 @@ static void s_save_scratch(const faust_distortionCtx_t *pCtx)
 /**
 * @brief Transform the buffer
 *
-* @param pAlgo the algo instance
-* @return int32_t error code
+* @param pCtx the class context instance
+* @param pIn  dsp inputs
+* @param pOut dsp outputs
 */
-static void  plugin_processing_transform(faust_distortionCtx_t *pCtx)
+static void  plugin_processing_transform(faust_distortionCtx_t *pCtx, FAUSTFLOAT **pIn, FAUSTFLOAT **pOut)
 {
   s_dsp_update(&pCtx->dsp, pCtx->pDynamic);
-  computemydsp(&pCtx->dsp, (int)pCtx->szBuffer, pCtx->pScratchSample, pCtx->pScratchSample);
+  computemydsp(&pCtx->dsp, (int)pCtx->szBuffer, pIn, pOut);
 }
 
 
@@ -234,6 +238,11 @@ static int32_t s_faust_distortion_init(audio_algo_t *const pAlgo)
     pCtx->pChunkIn   = AudioAlgo_getChunkPtrIn(pAlgo,  0U);
     pCtx->pChunkOut  = AudioAlgo_getChunkPtrOut(pAlgo, 0U);
 
+    pCtx->bDirect    = AudioChainWrp_faust_isDirect(pBuffIn, pCtx->nbChannels, getNumInputsmydsp(&pCtx->dsp));
+  }
+
+  if (AudioError_isOk(error) && !pCtx->bDirect)
+  {
     // create pCtx->faustAudioBuffer (for sfcSetContext purpose and for FAUST processing purpose) to be compliant with pScratchSample samples format (float, non-interleaved, stereo)
     error = AudioBuffer_create(&pCtx->faustAudioBuffer, 2U, fsIn, pCtx->szBuffer, ABUFF_FORMAT_TIME, ABUFF_FORMAT_FLOAT, ABUFF_FORMAT_NON_INTERLEAVED, memPool);
     if (AudioError_isError(error))
@@ -242,7 +251,7 @@ static int32_t s_faust_distortion_init(audio_algo_t *const pAlgo)
     }
   }
 
-  if (AudioError_isOk(error))
+  if (AudioError_isOk(error) && !pCtx->bDirect)
   {
     pCtx->pScratchSample[0] = AudioBuffer_getPdataCh(&pCtx->faustAudioBuffer, 0);
     pCtx->pScratchSample[1] = AudioBuffer_getPdataCh(&pCtx->faustAudioBuffer, 1);
@@ -254,7 +263,7 @@ static int32_t s_faust_distortion_init(audio_algo_t *const pAlgo)
     }
   }
 
-  if (AudioError_isOk(error))
+  if (AudioError_isOk(error) && !pCtx->bDirect)
   {
     error = sfcSetContext(&pCtx->sfcOutContext, &pCtx->faustAudioBuffer, pBuffOut, false, 1.0f, pUtilsHandle);
     if (AudioError_isError(error))
@@ -320,8 +329,19 @@ static int32_t s_faust_distortion_dataInOut(audio_algo_t *const pAlgo)
   int32_t error = AUDIO_ERR_MGNT_NONE;
   faust_distortionCtx_t *const pCtx = (faust_distortionCtx_t *)AudioAlgo_getWrapperContext(pAlgo);
 
-  s_load_scratch(pCtx);
-  plugin_processing_transform(pCtx);
-  s_save_scratch(pCtx);
+  if (pCtx->bDirect)
+  {
+    FAUSTFLOAT *pIn[2];
+    FAUSTFLOAT *pOut[2];
+
+    AudioChainWrp_faust_getChunkIos(pCtx->pChunkIn, pCtx->pChunkOut, pCtx->nbChannels, pIn, pOut);
+    plugin_processing_transform(pCtx, pIn, pOut);
+  }
+  else
+  {
+    s_load_scratch(pCtx);
+    plugin_processing_transform(pCtx, pCtx->pScratchSample, pCtx->pScratchSample);
+    s_save_scratch(pCtx);
+  }
   return error;
 }
@@ -19,11 +19,13 @@
 /* Includes ------------------------------------------------------------------*/
 #include "faust/audio_chain_faust_flanger.h"
 #include <assert.h>
+#include <stdbool.h>
 /*cstat -MISRAC2012-* CMSIS not misra compliant */
 #include <arm_math.h>
 /*cstat +MISRAC2012-* */
 #include "sfc.h"
 #include "common/commonMath.h"
+#include "audio_chain_faust_wrapper.h"
 
 /* ARM CMSIS DSP optimization */
 #define sinf  arm_sin_f32
@@ -49,12 +51,19 @@ typedef struct
   sfcContext_t         sfcOutContext;
   FAUSTFLOAT          *pScratchSample[2];
   memPool_t            memPool;
+  bool                 bDirect;
+  float               *pDelayLines;
+  memPool_t            delayMemPool;
 
   mydsp               dsp;
   const faust_flanger_dynamic_config_t *pDynamic;
 }  faust_flangerCtx_t;
 
 /* Private defines -----------------------------------------------------------*/
+/* longest modulated delay reachable from the dynamic params: delay_offset (20 ms) + flange_delay (20 ms) */
+#define FAUST_FLANGER_MAX_DELAY_S        0.04f
+/* clamp of the delay index in the generated code */
+#define FAUST_FLANGER_MAX_DELAY_SAMPLES  2049
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 const audio_algo_common_t  AudioChainWrp_faust_flanger_common =
@@ -152,6 +161,34 @@ __weak int32_t AudioChainWrp_faust_flanger_init_ext(audio_algo_t *const pAlgo)
 }
 
 
+/**
+* @brief Size the delay lines from the sample rate (power of 2 length for the index mask)
+*
+* @param pDsp the dsp instance
+* @param fs the sampling rate
+* @return uint32_t the length of one delay line in samples
+*/
+static uint32_t s_delay_lines_size(mydsp *pDsp, uint32_t const fs)
+{
+  uint32_t length   = 1UL;
+  int      delayMax = (int)ceilf(FAUST_FLANGER_MAX_DELAY_S * (float)fs) + 1;
+
+  if (delayMax > FAUST_FLANGER_MAX_DELAY_SAMPLES)
+  {
+    delayMax = FAUST_FLANGER_MAX_DELAY_SAMPLES;
+  }
+  /* the interpolation reads delay and delay + 1 */
+  while (length <= ((uint32_t)delayMax + 1UL))
+  {
+    length <<= 1;
+  }
+  pDsp->iDelayMax  = delayMax;
+  pDsp->iDelayMask = (int)length - 1;
+
+  return length;
+}
+
+
 /**
 * @brief Load the scratch buffer and convert it
 *
@@ -181,13 +218,14 @@ static void s_save_scratch(const faust_flangerCtx_t *pCtx)
 /**
 * @brief Transform the buffer
 *
-* @param pAlgo the algo instance
-* @return int32_t error code
+* @param pCtx the class context instance
+* @param pIn  dsp inputs
+* @param pOut dsp outputs
 */
-static void  plugin_processing_transform(faust_flangerCtx_t *pCtx)
+static void  plugin_processing_transform(faust_flangerCtx_t *pCtx, FAUSTFLOAT **pIn, FAUSTFLOAT **pOut)
 {
   s_dsp_update(&pCtx->dsp, pCtx->pDynamic);
-  computemydsp(&pCtx->dsp, (int)pCtx->szBuffer, pCtx->pScratchSample, pCtx->pScratchSample);
+  computemydsp(&pCtx->dsp, (int)pCtx->szBuffer, pIn, pOut);
 }
 
 
@@ -239,6 +277,11 @@ static int32_t s_faust_flanger_init(audio_algo_t *const pAlgo)
     pCtx->pChunkIn   = AudioAlgo_getChunkPtrIn(pAlgo,  0U);
     pCtx->pChunkOut  = AudioAlgo_getChunkPtrOut(pAlgo, 0U);
 
+    pCtx->bDirect    = AudioChainWrp_faust_isDirect(pBuffIn, pCtx->nbChannels, getNumInputsmydsp(&pCtx->dsp));
+  }
+
+  if (AudioError_isOk(error) && !pCtx->bDirect)
+  {
     // create pCtx->faustAudioBuffer (for sfcSetContext purpose and for FAUST processing purpose) to be compliant with pScratchSample samples format (float, non-interleaved, stereo)
     error = AudioBuffer_create(&pCtx->faustAudioBuffer, 2U, fsIn, pCtx->szBuffer, ABUFF_FORMAT_TIME, ABUFF_FORMAT_FLOAT, ABUFF_FORMAT_NON_INTERLEAVED, memPool);
     if (AudioError_isError(error))
@@ -247,7 +290,7 @@ static int32_t s_faust_flanger_init(audio_algo_t *const pAlgo)
     }
   }
 
-  if (AudioError_isOk(error))
+  if (AudioError_isOk(error) && !pCtx->bDirect)
   {
     pCtx->pScratchSample[0] = AudioBuffer_getPdataCh(&pCtx->faustAudioBuffer, 0);
     pCtx->pScratchSample[1] = AudioBuffer_getPdataCh(&pCtx->faustAudioBuffer, 1);
@@ -259,7 +302,7 @@ static int32_t s_faust_flanger_init(audio_algo_t *const pAlgo)
     }
   }
 
-  if (AudioError_isOk(error))
+  if (AudioError_isOk(error) && !pCtx->bDirect)
   {
     error = sfcSetContext(&pCtx->sfcOutContext, &pCtx->faustAudioBuffer, pBuffOut, false, 1.0f, pUtilsHandle);
     if (AudioError_isError(error))
@@ -268,6 +311,24 @@ static int32_t s_faust_flanger_init(audio_algo_t *const pAlgo)
     }
   }
 
+  if (AudioError_isOk(error))
+  {
+    uint32_t const delayLength = s_delay_lines_size(&pCtx->dsp, fsIn);
+
+    pCtx->delayMemPool = (memPool_t)pStaticConfig->delayRamType;
+    pCtx->pDelayLines  = (float *)AudioAlgo_malloc(2UL * delayLength * sizeof(float), pCtx->delayMemPool);
+    if (pCtx->pDelayLines == NULL)
+    {
+      AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "delay lines malloc failed !");
+      error = AUDIO_ERR_MGNT_ALLOCATION;
+    }
+    else
+    {
+      pCtx->dsp.fVec1 = &pCtx->pDelayLines[0];
+      pCtx->dsp.fVec2 = &pCtx->pDelayLines[delayLength];
+    }
+  }
+
   if (AudioError_isOk(error))
   {
     initmydsp(&pCtx->dsp, (int32_t)fsIn);
@@ -307,6 +368,10 @@ static int32_t s_faust_flanger_deinit(audio_algo_t *const pAlgo)
     AudioAlgo_setWrapperContext(pAlgo, NULL);
     AudioChainWrp_faust_flanger_deinit_ext(pAlgo);
     AudioBuffer_deinit(&pCtx->faustAudioBuffer);
+    if (pCtx->pDelayLines != NULL)
+    {
+      AudioAlgo_free(pCtx->pDelayLines, pCtx->delayMemPool);
+    }
     AudioAlgo_free(pCtx, memPool);
   }
 
@@ -325,8 +390,19 @@ static int32_t s_faust_flanger_dataInOut(audio_algo_t *const pAlgo)
   int32_t error = AUDIO_ERR_MGNT_NONE;
   faust_flangerCtx_t *const pCtx = (faust_flangerCtx_t *)AudioAlgo_getWrapperContext(pAlgo);
 
-  s_load_scratch(pCtx);
-  plugin_processing_transform(pCtx);
-  s_save_scratch(pCtx);
+  if (pCtx->bDirect)
+  {
+    FAUSTFLOAT *pIn[2];
+    FAUSTFLOAT *pOut[2];
+
+    AudioChainWrp_faust_getChunkIos(pCtx->pChunkIn, pCtx->pChunkOut, pCtx->nbChannels, pIn, pOut);
+    plugin_processing_transform(pCtx, pIn, pOut);
+  }
+  else
+  {
+    s_load_scratch(pCtx);
+    plugin_processing_transform(pCtx, pCtx->pScratchSample, pCtx->pScratchSample);
+    s_save_scratch(pCtx);
+  }
   return error;
 }
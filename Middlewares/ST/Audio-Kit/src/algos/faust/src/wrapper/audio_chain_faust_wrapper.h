@@ -0,0 +1,77 @@
+/**
+******************************************************************************
+* @file    audio_chain_faust_wrapper.h
+* @author  MCD Application Team
+* @brief   helpers common to the faust algos wrappers
+*******************************************************************************
+* @attention
+*
+* Copyright (c) 2019(-2022) STMicroelectronics.
+* All rights reserved.
+*
+* This software is licensed under terms that can be found in the LICENSE file
+* in the root directory of this software component.
+* If no LICENSE file comes with this software, it is provided AS-IS.
+*
+********************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __AUDIO_CHAIN_FAUST_WRAPPER_H
+#define __AUDIO_CHAIN_FAUST_WRAPPER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "audio_chain.h"
+
+/* Exported constants --------------------------------------------------------*/
+#ifndef FAUSTFLOAT
+  #define FAUSTFLOAT float
+#endif
+
+/* Exported functions ------------------------------------------------------- */
+/**
+* @brief Check if the dsp may process the chunk samples directly: the dsp works on float non-interleaved
+*        buffers, when the chunk layout already matches the dsp ios neither scratch buffer nor sample
+*        conversion is needed
+*
+* @param pBuffIn     input buffer info (output has the same layout)
+* @param nbChannels  number of channels
+* @param nbDspInputs number of inputs of the dsp
+* @return true if the chunks can be processed directly
+*/
+static inline bool AudioChainWrp_faust_isDirect(audio_buffer_t const *const pBuffIn, uint8_t const nbChannels, int const nbDspInputs)
+{
+  return (AudioBuffer_getType(pBuffIn) == ABUFF_FORMAT_FLOAT) &&
+         ((AudioBuffer_getInterleaved(pBuffIn) == ABUFF_FORMAT_NON_INTERLEAVED) || (nbChannels == 1U)) &&
+         ((int)nbChannels == nbDspInputs);
+}
+
+
+/**
+* @brief Get the dsp ios pointing on the chunks samples, for a direct processing
+*
+* @param pChunkIn   input chunk
+* @param pChunkOut  output chunk
+* @param nbChannels number of channels
+* @param pIn        returned dsp inputs (NULL for missing channels)
+* @param pOut       returned dsp outputs (NULL for missing channels)
+*/
+static inline void AudioChainWrp_faust_getChunkIos(audio_chunk_t const *const pChunkIn, audio_chunk_t const *const pChunkOut, uint8_t const nbChannels, FAUSTFLOAT *pIn[2], FAUSTFLOAT *pOut[2])
+{
+  for (uint8_t ch = 0U; ch < 2U; ch++)
+  {
+    pIn[ch]  = (ch < nbChannels) ? (FAUSTFLOAT *)AudioChunk_getReadPtr(pChunkIn,   ch, 0UL) : NULL;
+    pOut[ch] = (ch < nbChannels) ? (FAUSTFLOAT *)AudioChunk_getWritePtr(pChunkOut, ch, 0UL) : NULL;
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __AUDIO_CHAIN_FAUST_WRAPPER_H */
@@ -4,6 +4,8 @@ name: "faust_flanger", "flanger"
 version: "0.0"
 Code generated with Faust 2.60.0 (https://faust.grame.fr)
 Compilation options: -lang c -ct 1 -es 1 -mcd 16 -single -ftz 0
+Delay lines fVec1/fVec2 moved out of the dsp struct: they are allocated and
+sized from the sample rate by the wrapper (iDelayMask/iDelayMax)
 ------------------------------------------------------------ */
 
 #ifndef  __mydsp_H__
@@ -54,12 +56,14 @@ typedef struct
   FAUSTFLOAT fHslider2;
   FAUSTFLOAT fHslider3;
   int IOTA0;
-  float fVec1[4096];
+  float *fVec1;
   FAUSTFLOAT fHslider4;
   FAUSTFLOAT fHslider5;
   float fRec0[2];
-  float fVec2[4096];
+  float *fVec2;
   float fRec3[2];
+  int iDelayMask;
+  int iDelayMax;
 } mydsp;
 
 static mydsp *newmydsp()
@@ -175,7 +179,7 @@ static void instanceClearmydsp(mydsp *dsp)
   /* C99 loop */
   {
     int l3;
-    for (l3 = 0; l3 < 4096; l3 = l3 + 1)
+    for (l3 = 0; l3 <= dsp->iDelayMask; l3 = l3 + 1)
     {
       dsp->fVec1[l3] = 0.0f;
     }
@@ -191,7 +195,7 @@ static void instanceClearmydsp(mydsp *dsp)
   /* C99 loop */
   {
     int l5;
-    for (l5 = 0; l5 < 4096; l5 = l5 + 1)
+    for (l5 = 0; l5 <= dsp->iDelayMask; l5 = l5 + 1)
     {
       dsp->fVec2[l5] = 0.0f;
     }
@@ -305,20 +309,20 @@ static void computemydsp(mydsp *dsp, int count, FAUSTFLOAT **RESTRICT inputs, FA
       float fTemp0 = (float)(input0[i0]);
       float fTemp1 = fSlow6 * ((iSlow0) ? 0.0f : fTemp0);
       float fTemp2 = fSlow7 * dsp->fRec0[1] - fTemp1;
-      dsp->fVec1[dsp->IOTA0 & 4095] = fTemp2;
+      dsp->fVec1[dsp->IOTA0 & dsp->iDelayMask] = fTemp2;
       float fTemp3 = dsp->fConst0 * (fSlow9 + fSlow8 * (dsp->fRec1[0] + 1.0f));
       int iTemp4 = (int)(fTemp3);
       float fTemp5 = floorf(fTemp3);
-      dsp->fRec0[0] = dsp->fVec1[(dsp->IOTA0 - min(2049, max(0, iTemp4))) & 4095] * (fTemp5 + (1.0f - fTemp3)) + (fTemp3 - fTemp5) * dsp->fVec1[(dsp->IOTA0 - min(2049, max(0, iTemp4 + 1))) & 4095];
+      dsp->fRec0[0] = dsp->fVec1[(dsp->IOTA0 - min(dsp->iDelayMax, max(0, iTemp4))) & dsp->iDelayMask] * (fTemp5 + (1.0f - fTemp3)) + (fTemp3 - fTemp5) * dsp->fVec1[(dsp->IOTA0 - min(dsp->iDelayMax, max(0, iTemp4 + 1))) & dsp->iDelayMask];
       output0[i0] = (FAUSTFLOAT)(((iSlow0) ? fTemp0 : 0.5f * (fTemp1 + dsp->fRec0[0] * fSlow2)));
       float fTemp6 = (float)(input1[i0]);
       float fTemp7 = fSlow6 * ((iSlow0) ? 0.0f : fTemp6);
       float fTemp8 = fSlow7 * dsp->fRec3[1] - fTemp7;
-      dsp->fVec2[dsp->IOTA0 & 4095] = fTemp8;
+      dsp->fVec2[dsp->IOTA0 & dsp->iDelayMask] = fTemp8;
       float fTemp9 = dsp->fConst0 * (fSlow9 + fSlow8 * (dsp->fRec2[0] + 1.0f));
       int iTemp10 = (int)(fTemp9);
       float fTemp11 = floorf(fTemp9);
-      dsp->fRec3[0] = dsp->fVec2[(dsp->IOTA0 - min(2049, max(0, iTemp10))) & 4095] * (fTemp11 + (1.0f - fTemp9)) + (fTemp9 - fTemp11) * dsp->fVec2[(dsp->IOTA0 - min(2049, max(0, iTemp10 + 1))) & 4095];
+      dsp->fRec3[0] = dsp->fVec2[(dsp->IOTA0 - min(dsp->iDelayMax, max(0, iTemp10))) & dsp->iDelayMask] * (fTemp11 + (1.0f - fTemp9)) + (fTemp9 - fTemp11) * dsp->fVec2[(dsp->IOTA0 - min(dsp->iDelayMax, max(0, iTemp10 + 1))) & dsp->iDelayMask];
       output1[i0] = (FAUSTFLOAT)(((iSlow0) ? fTemp6 : 0.5f * (fTemp7 + dsp->fRec3[0] * fSlow2)));
       dsp->iVec0[1] = dsp->iVec0[0];
       dsp->fRec1[1] = dsp->fRec1[0];
@@ -19,14 +19,16 @@
 /* Includes ------------------------------------------------------------------*/
 #include <math.h>
 #include "gain/audio_chain_gain.h"
+#include "passthrough/audio_chain_passThrough.h"
 #include "sfc.h"
 
 /* Private typedef -----------------------------------------------------------*/
 typedef struct
 {
-  int          nbChannels;
-  int          nbElements;
-  sfcContext_t sfcContext;
+  int                  nbChannels;
+  int                  nbElements;
+  sfcContext_t         sfcContext;
+  passThrough_bypass_t bypass;
 } gainCtx_t;
 
 /* Private defines -----------------------------------------------------------*/
@@ -62,6 +64,7 @@ const audio_algo_common_t AudioChainWrp_gain_common =
   .iosOut.type               = AUDIO_CAPABILITY_TYPE_FIXED16_FIXED32_FLOAT_G711,
 
   .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("Apply a gain"),
+  .misc.flags                = AUDIO_ALGO_FLAGS_MISC_IN_PLACE
 };
 
 audio_algo_cbs_t AudioChainWrp_gain_cbs =
@@ -108,17 +111,21 @@ static int32_t s_gain_init(audio_algo_t *const pAlgo)
 
     pContext->nbChannels = (int)AudioBuffer_getNbChannels(pBuffIn);
     pContext->nbElements  = (int)AudioBuffer_getNbElements(pBuffIn);
+    error = AudioChainWrp_passThrough_bypassInit(&pContext->bypass, pAlgo);
 
-    sfcResetContext(&pContext->sfcContext);
-    error = sfcSetContext(&pContext->sfcContext,
-                          pBuffIn,
-                          pBuffOut,
-                          false,
-                          1.0f,
-                          AudioAlgo_getUtilsHdle(pAlgo));
-    if (AudioError_isError(error))
+    if (AudioError_isOk(error))
     {
-      AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "sfc issue !");
+      sfcResetContext(&pContext->sfcContext);
+      error = sfcSetContext(&pContext->sfcContext,
+                            pBuffIn,
+                            pBuffOut,
+                            false,
+                            1.0f,
+                            AudioAlgo_getUtilsHdle(pAlgo));
+      if (AudioError_isError(error))
+      {
+        AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "sfc issue !");
+      }
     }
   }
   if (AudioError_isOk(error))
@@ -143,6 +150,7 @@ static int32_t s_gain_deinit(audio_algo_t *const pAlgo)
   {
     /* disconnect context from Algo first: insure algo won't be executed during deinit */
     AudioAlgo_setWrapperContext(pAlgo, NULL);
+    AudioChainWrp_passThrough_bypassDeinit(&pContext->bypass);
     AudioAlgo_free(pContext, AUDIO_MEM_RAMINT);
   }
 
@@ -161,6 +169,8 @@ static int32_t s_gain_configure(audio_algo_t *const pAlgo)
   {
     AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "sfc config issue !");
   }
+  /* 0 dB gain: sample format conversion is an identity, algo is bypassed */
+  AudioChainWrp_passThrough_bypassSetNeutral(&pContext->bypass, fabsf(pDynamicConfig->gain) < 0.001f);
 
   return error;
 }
@@ -168,17 +178,27 @@ static int32_t s_gain_configure(audio_algo_t *const pAlgo)
 
 static int32_t s_gain_dataInOut(audio_algo_t *const pAlgo)
 {
+  int32_t          error       = AUDIO_ERR_MGNT_NONE;
   gainCtx_t *const pContext    = (gainCtx_t *)AudioAlgo_getWrapperContext(pAlgo);
   void      *const pSamplesIn  = AudioChunk_getReadPtr0(AudioAlgo_getChunkPtrIn(pAlgo,   0U));
   void      *const pSamplesOut = AudioChunk_getWritePtr0(AudioAlgo_getChunkPtrOut(pAlgo, 0U));
+  uint32_t   const startCycles = AudioChainWrp_passThrough_bypassStart(&pContext->bypass);
 
-  sfcSampleBufferConvert(&pContext->sfcContext,
-                         pSamplesIn,
-                         pSamplesOut,
-                         pContext->nbChannels,
-                         pContext->nbElements);
+  if (AudioChainWrp_passThrough_bypassIsOn(&pContext->bypass))
+  {
+    error = AudioChainWrp_passThrough_bypassDataInOut(&pContext->bypass, startCycles);
+  }
+  else
+  {
+    sfcSampleBufferConvert(&pContext->sfcContext,
+                           pSamplesIn,
+                           pSamplesOut,
+                           pContext->nbChannels,
+                           pContext->nbElements);
+    AudioChainWrp_passThrough_bypassKernelDone(&pContext->bypass, startCycles);
+  }
 
-  return AUDIO_ERR_MGNT_NONE;
+  return error;
 }
 
 
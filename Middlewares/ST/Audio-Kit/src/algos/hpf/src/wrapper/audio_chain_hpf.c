@@ -268,7 +268,8 @@ const audio_algo_common_t AudioChainWrp_hpf_common =
   .iosOut.type               = AUDIO_CAPABILITY_TYPE_FIXED16_FIXED32_FLOAT,
 
   .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("Direct current remover (cut frequency 50 Hz, pass frequency 200 Hz)"),
-  .misc.pAlgoHelp            = AUDIO_ALGO_OPT_STR("hpf")
+  .misc.pAlgoHelp            = AUDIO_ALGO_OPT_STR("hpf"),
+  .misc.flags                = AUDIO_ALGO_FLAGS_MISC_IN_PLACE
 };
 
 audio_algo_cbs_t AudioChainWrp_hpf_cbs =
@@ -30,6 +30,11 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 #define MIX_NB_INPUTS 4U  // 10U maxi
 
+/* 1U: fixed16/fixed32/float inputs are converted, scaled (with per-sample gain ramp) and accumulated in a single pass
+   0U: each input goes through sfc conversion + mix into output buffer (useful for cycles comparison, see also
+       src/wrapper/mix_fused_bench.c); fixed-point outputs of the fused kernel are rounded to nearest before saturation */
+#define MIX_FUSED_KERNEL 1U
+
 /* Exported types ------------------------------------------------------------*/
 typedef struct
 {
@@ -20,14 +20,34 @@
 #include <math.h>
 #include "mix/audio_chain_mix.h"
 #include "audio_assert.h"
+#include "passthrough/audio_chain_passThrough.h"
 #include "sfc.h"
+#include "mix_fused_kernel.h"
 
 /* Private typedef -----------------------------------------------------------*/
 typedef struct
 {
-  int           nbChannels;
-  int           nbElements;
-  sfcContext_t *pSfcContext;
+  audio_chunk_t      *pChunk;
+  audio_buffer_type_t type;
+  int                 chOffset;
+  int                 splOffset;
+  float               typeGain;     // input type to float normalization merged with float to output type scaling
+  float               targetGain;   // linear gain (including typeGain) computed at configure
+  float               currentGain;  // linear gain (including typeGain) applied at end of last frame
+} mixInput_t;
+
+typedef struct
+{
+  int                 nbChannels;
+  int                 nbElements;
+  int                 nbInputs;
+  bool                fused;         // true if fused conversion + gain + mix kernel is used instead of sfc
+  int                 chOffsetOut;
+  int                 splOffsetOut;
+  audio_buffer_type_t typeOut;
+  mixInput_t         *pInputs;
+  sfcContext_t       *pSfcContext;
+  passThrough_bypass_t bypass;       // single input at 0 dB: mix is a copy of this input
 } mixCtx_t;
 
 /* Private defines -----------------------------------------------------------*/
@@ -39,6 +59,11 @@ static int32_t s_mix_init(audio_algo_t      *const pAlgo);
 static int32_t s_mix_configure(audio_algo_t *const pAlgo);
 static int32_t s_mix_dataInOut(audio_algo_t *const pAlgo);
 
+static bool    s_mix_isFusedType(audio_buffer_t const *const pBuff);
+static float   s_mix_getTypeGain(audio_buffer_type_t const type, bool const isInput);
+static mixFusedType_t s_mix_fusedType(audio_buffer_type_t const type);
+static void    s_mix_fusedProcess(mixCtx_t *const pContext, void *const pSamplesOut);
+
 /* Global variables ----------------------------------------------------------*/
 const audio_algo_common_t AudioChainWrp_mix_common =
 {
@@ -116,7 +141,7 @@ static int32_t s_mix_init(audio_algo_t *const pAlgo)
 {
   int32_t                     error          = AUDIO_ERR_MGNT_NONE;
   uint8_t               const nbChunkIn      = AudioChunkList_getNbElements(AudioAlgo_getChunksIn(pAlgo));
-  mixCtx_t             *const pContext       = (mixCtx_t *)AudioAlgo_malloc(sizeof(mixCtx_t) + (nbChunkIn * sizeof(sfcContext_t)), AUDIO_MEM_RAMINT);
+  mixCtx_t             *const pContext       = (mixCtx_t *)AudioAlgo_malloc(sizeof(mixCtx_t) + (nbChunkIn * (sizeof(mixInput_t) + sizeof(sfcContext_t))), AUDIO_MEM_RAMINT);
   mix_dynamic_config_t *const pDynamicConfig = (mix_dynamic_config_t *)AudioAlgo_getDynamicConfig(pAlgo);
 
   if (AudioError_isOk(error))
@@ -145,27 +170,60 @@ static int32_t s_mix_init(audio_algo_t *const pAlgo)
 
     AudioAlgo_setWrapperContext(pAlgo, pContext);
 
-    pContext->pSfcContext = (sfcContext_t *)&pContext[1];
-    pContext->nbChannels  = (int)AudioBuffer_getNbChannels(pBuffOut);
-    pContext->nbElements  = (int)AudioBuffer_getNbElements(pBuffOut);
+    pContext->pInputs      = (mixInput_t *)&pContext[1];
+    pContext->pSfcContext  = (sfcContext_t *)&pContext->pInputs[nbChunkIn];
+    pContext->nbChannels   = (int)AudioBuffer_getNbChannels(pBuffOut);
+    pContext->nbElements   = (int)AudioBuffer_getNbElements(pBuffOut);
+    pContext->chOffsetOut  = (int)AudioBuffer_getChannelsOffset(pBuffOut);
+    pContext->splOffsetOut = (int)AudioBuffer_getSamplesOffset(pBuffOut);
+    pContext->typeOut      = AudioBuffer_getType(pBuffOut);
+    pContext->fused        = (MIX_FUSED_KERNEL != 0U) && s_mix_isFusedType(pBuffOut);
+    for (audio_chunk_list_t *pChunkInList = AudioAlgo_getChunksIn(pAlgo); pChunkInList != NULL; pChunkInList = pChunkInList->next)
+    {
+      if (pChunkInList->pChunk != NULL)
+      {
+        pContext->fused = pContext->fused && s_mix_isFusedType(AudioChunk_getBuffInfo(pChunkInList->pChunk));
+      }
+    }
+
     for (audio_chunk_list_t *pChunkInList = AudioAlgo_getChunksIn(pAlgo); AudioError_isOk(error) && (pChunkInList != NULL); pChunkInList = pChunkInList->next)
     {
       if (pChunkInList->pChunk != NULL)
       {
-        sfcResetContext(&pContext->pSfcContext[chunkId]);
-        error = sfcSetContext(&pContext->pSfcContext[chunkId],
-                              AudioChunk_getBuffInfo(pChunkInList->pChunk),
-                              pBuffOut,
-                              false,
-                              1.0f,
-                              pUtilsHdle);
-        if (AudioError_isError(error))
+        audio_buffer_t const *const pBuffIn = AudioChunk_getBuffInfo(pChunkInList->pChunk);
+        mixInput_t           *const pInput  = &pContext->pInputs[chunkId];
+
+        pInput->pChunk      = pChunkInList->pChunk;
+        pInput->type        = AudioBuffer_getType(pBuffIn);
+        pInput->chOffset    = (int)AudioBuffer_getChannelsOffset(pBuffIn);
+        pInput->splOffset   = (int)AudioBuffer_getSamplesOffset(pBuffIn);
+        pInput->typeGain    = s_mix_getTypeGain(pInput->type, true) * s_mix_getTypeGain(pContext->typeOut, false);
+        pInput->targetGain  = pInput->typeGain;
+        pInput->currentGain = pInput->typeGain;
+
+        if (!pContext->fused)
         {
-          AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "sfc input %d issue !", chunkId);
+          sfcResetContext(&pContext->pSfcContext[chunkId]);
+          error = sfcSetContext(&pContext->pSfcContext[chunkId],
+                                pBuffIn,
+                                pBuffOut,
+                                false,
+                                1.0f,
+                                pUtilsHdle);
+          if (AudioError_isError(error))
+          {
+            AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "sfc input %d issue !", chunkId);
+          }
         }
         chunkId++;
       }
     }
+    pContext->nbInputs = chunkId;
+  }
+
+  if (AudioError_isOk(error))
+  {
+    error = AudioChainWrp_passThrough_bypassInit(&pContext->bypass, pAlgo);
   }
 
   if (AudioError_isOk(error))
@@ -173,6 +231,15 @@ static int32_t s_mix_init(audio_algo_t *const pAlgo)
     error = s_mix_configure(pAlgo);
   }
 
+  if (AudioError_isOk(error))
+  {
+    /* no gain ramp on first frame */
+    for (int i = 0; i < pContext->nbInputs; i++)
+    {
+      pContext->pInputs[i].currentGain = pContext->pInputs[i].targetGain;
+    }
+  }
+
   if (AudioError_isError(error))
   {
     s_mix_deinit(pAlgo);
@@ -190,6 +257,7 @@ static int32_t s_mix_deinit(audio_algo_t *const pAlgo)
   {
     /* disconnect context from Algo first: insure algo won't be executed during deinit */
     AudioAlgo_setWrapperContext(pAlgo, NULL);
+    AudioChainWrp_passThrough_bypassDeinit(&pContext->bypass);
     AudioAlgo_free(pContext, AUDIO_MEM_RAMINT);
   }
 
@@ -204,6 +272,7 @@ static int32_t s_mix_configure(audio_algo_t *const pAlgo)
   mix_dynamic_config_t *const pDynamicConfig = (mix_dynamic_config_t *)AudioAlgo_getDynamicConfig(pAlgo);
   float                *const pGain          = &pDynamicConfig->gain0;
   bool                        mix            = false; // no mix for first input chunk
+  bool                        neutral        = false; // single input chunk at 0 dB
   int                         confId         = 0;
   int                         chunkId        = 0;
 
@@ -211,16 +280,28 @@ static int32_t s_mix_configure(audio_algo_t *const pAlgo)
   {
     if (pChunkInList->pChunk != NULL)
     {
-      error = sfcUpdateContext(&pContext->pSfcContext[chunkId], mix, powf(10.0f, pGain[confId] / 20.0f)); /*cstat !MISRAC2012-Rule-22.8 no issue with powf(10, ...) => errno check is useless*/
-      mix   = true;  // mix for next input chunks
-      if (AudioError_isError(error))
+      float const linearGain = powf(10.0f, pGain[confId] / 20.0f); /*cstat !MISRAC2012-Rule-22.8 no issue with powf(10, ...) => errno check is useless*/
+
+      if (pContext->fused)
       {
-        AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "config input %d issue!", chunkId);
+        /* new gain will be reached through a per-sample ramp during next frame */
+        pContext->pInputs[chunkId].targetGain = linearGain * pContext->pInputs[chunkId].typeGain;
       }
+      else
+      {
+        error = sfcUpdateContext(&pContext->pSfcContext[chunkId], mix, linearGain);
+        mix   = true;  // mix for next input chunks
+        if (AudioError_isError(error))
+        {
+          AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "config input %d issue!", chunkId);
+        }
+      }
+      neutral = (pContext->nbInputs == 1) && (pChunkInList->pChunk == AudioAlgo_getChunkPtrIn(pAlgo, 0U)) && (fabsf(pGain[confId]) < 0.001f);
       chunkId++;
     }
     confId++;
   }
+  AudioChainWrp_passThrough_bypassSetNeutral(&pContext->bypass, neutral);
 
   return error;
 }
@@ -228,24 +309,126 @@ static int32_t s_mix_configure(audio_algo_t *const pAlgo)
 
 static int32_t s_mix_dataInOut(audio_algo_t *const pAlgo)
 {
+  int32_t         error       = AUDIO_ERR_MGNT_NONE;
   mixCtx_t *const pContext    = (mixCtx_t *)AudioAlgo_getWrapperContext(pAlgo);
   void     *const pSamplesOut = AudioChunk_getWritePtr0(AudioAlgo_getChunkPtrOut(pAlgo, 0U));
+  uint32_t  const startCycles = AudioChainWrp_passThrough_bypassStart(&pContext->bypass);
+  /* with fused kernel, bypass only once the gain ramp toward 0 dB is over */
+  bool      const bypassed    = AudioChainWrp_passThrough_bypassIsOn(&pContext->bypass) && (!pContext->fused || (pContext->pInputs[0].currentGain == pContext->pInputs[0].targetGain));  /*cstat !MISRAC2012-Rule-13.5 no side effect*/
   int             chunkId     = 0;
 
-  for (audio_chunk_list_t *pChunkInList = AudioAlgo_getChunksIn(pAlgo); pChunkInList != NULL; pChunkInList = pChunkInList->next)
+  if (bypassed)
   {
-    if (pChunkInList->pChunk != NULL)
+    error = AudioChainWrp_passThrough_bypassDataInOut(&pContext->bypass, startCycles);
+  }
+  else if (pContext->fused)
+  {
+    s_mix_fusedProcess(pContext, pSamplesOut);
+  }
+  else
+  {
+    for (audio_chunk_list_t *pChunkInList = AudioAlgo_getChunksIn(pAlgo); pChunkInList != NULL; pChunkInList = pChunkInList->next)
     {
-      sfcSampleBufferConvert(&pContext->pSfcContext[chunkId],
-                             AudioChunk_getReadPtr0(pChunkInList->pChunk),
-                             pSamplesOut,
-                             pContext->nbChannels,
-                             pContext->nbElements);
-      chunkId++;
+      if (pChunkInList->pChunk != NULL)
+      {
+        sfcSampleBufferConvert(&pContext->pSfcContext[chunkId],
+                               AudioChunk_getReadPtr0(pChunkInList->pChunk),
+                               pSamplesOut,
+                               pContext->nbChannels,
+                               pContext->nbElements);
+        chunkId++;
+      }
     }
   }
+  if (!bypassed)
+  {
+    AudioChainWrp_passThrough_bypassKernelDone(&pContext->bypass, startCycles);
+  }
 
-  return AUDIO_ERR_MGNT_NONE;
+  return error;
+}
+
+
+/**
+ * @brief  check if buffer samples may be handled by fused kernel
+ * @param  pBuff: pointer to the audio buffer
+ * @retval true for fixed16/fixed32/float time-domain samples; G711 and spectral buffers go through sfc
+ */
+static bool s_mix_isFusedType(audio_buffer_t const *const pBuff)
+{
+  audio_buffer_type_t const type = AudioBuffer_getType(pBuff);
+
+  return (AudioBuffer_getTimeFreq(pBuff) == ABUFF_FORMAT_TIME) &&
+         ((type == ABUFF_FORMAT_FIXED16) || (type == ABUFF_FORMAT_FIXED32) || (type == ABUFF_FORMAT_FLOAT));
+}
+
+
+/**
+ * @brief  get scaling factor between samples type and normalized float samples
+ * @param  type:    samples type
+ * @param  isInput: true for type to float conversion, false for float to type conversion
+ * @retval scaling factor
+ */
+static float s_mix_getTypeGain(audio_buffer_type_t const type, bool const isInput)
+{
+  float typeGain = 1.0f;
+
+  switch (type)
+  {
+    case ABUFF_FORMAT_FIXED16:
+      typeGain = isInput ? (1.0f / 32768.0f) : 32768.0f;
+      break;
+    case ABUFF_FORMAT_FIXED32:
+      typeGain = isInput ? (1.0f / 2147483648.0f) : 2147483648.0f;
+      break;
+    default:
+      /* float: no scaling */
+      break;
+  }
+
+  return typeGain;
 }
 
 
+/**
+ * @brief  get fused kernel samples type
+ * @param  type: samples type, fixed16, fixed32 or float
+ * @retval fused kernel samples type
+ */
+static mixFusedType_t s_mix_fusedType(audio_buffer_type_t const type)
+{
+  return (type == ABUFF_FORMAT_FIXED16) ? MIX_FUSED_FIXED16 : ((type == ABUFF_FORMAT_FIXED32) ? MIX_FUSED_FIXED32 : MIX_FUSED_FLOAT);
+}
+
+
+/**
+ * @brief  fused conversion + gain + mix of all inputs (see mix_fused_kernel.h)
+ * @note   gain changes are linearly ramped over the frame following the configure
+ * @param  pContext:    mix context
+ * @param  pSamplesOut: output samples pointer
+ * @retval None
+ */
+static void s_mix_fusedProcess(mixCtx_t *const pContext, void *const pSamplesOut)
+{
+  float         const invNbElements = 1.0f / (float)pContext->nbElements;
+  mixFusedOut_t const output        = {pSamplesOut, s_mix_fusedType(pContext->typeOut), pContext->chOffsetOut, pContext->splOffsetOut};
+  mixFusedIn_t        inputs[MIX_NB_INPUTS];
+
+  /* snapshot of target gains: configure may update them from control task during frame processing */
+  for (int i = 0; i < pContext->nbInputs; i++)
+  {
+    mixInput_t *const pInput     = &pContext->pInputs[i];
+    float       const targetGain = pInput->targetGain;
+
+    inputs[i].pSamples  = AudioChunk_getReadPtr0(pInput->pChunk);
+    inputs[i].type      = s_mix_fusedType(pInput->type);
+    inputs[i].chOffset  = pInput->chOffset;
+    inputs[i].splOffset = pInput->splOffset;
+    inputs[i].gain      = pInput->currentGain;
+    inputs[i].gainStep  = (targetGain - pInput->currentGain) * invNbElements;
+    /* ramp is done at end of frame */
+    pInput->currentGain = targetGain;
+  }
+
+  mix_fused_frame(inputs, pContext->nbInputs, &output, pContext->nbChannels, pContext->nbElements);
+}
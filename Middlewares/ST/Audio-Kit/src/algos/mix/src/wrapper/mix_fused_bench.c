@@ -0,0 +1,254 @@
+/**
+******************************************************************************
+* @file    mix_fused_bench.c
+* @author  MCD Application Team
+* @brief   Host benchmark of the fused kernel of mix algo (mix_fused_kernel.h):
+*          cycles per frame for 2, 3 and 4 inputs, compared with a model of the
+*          sfc path (one conversion + read-modify-write pass over the output
+*          per input), and checks of the rounding and saturation of the fused
+*          kernel against a double precision reference.
+*          Not part of the firmware projects, build and run on the host:
+*            gcc -std=c11 -O2 -Wall -o mix_fused_bench mix_fused_bench.c -lm
+*            ./mix_fused_bench
+*          Cycles are read from the time-stamp counter on x86 hosts, elsewhere
+*          nanoseconds are printed instead. On target, the per-algo cycles
+*          counters compare both paths with MIX_FUSED_KERNEL (mix_config.h).
+*******************************************************************************
+* @attention
+*
+* Copyright (c) 2019(-2022) STMicroelectronics.
+* All rights reserved.
+*
+* This software is licensed under terms that can be found in the LICENSE file
+* in the root directory of this software component.
+* If no LICENSE file comes with this software, it is provided AS-IS.
+*
+********************************************************************************
+*/
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "mix_fused_kernel.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT          "cycles"
+#define BENCH_NOW()         ((double)__rdtsc())
+#else
+#define BENCH_UNIT          "ns"
+#define BENCH_NOW()         s_bench_ns()
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_NB_CHANNELS   2           /* interleaved stereo */
+#define BENCH_NB_ELEMENTS   480         /* 10 ms at 48 kHz */
+#define BENCH_NB_SAMPLES    (BENCH_NB_CHANNELS * BENCH_NB_ELEMENTS)
+#define BENCH_MAX_INPUTS    4
+#define BENCH_NB_FRAMES     20000
+#define BENCH_TYPE_GAIN     1.0f        /* fixed16 in and out: type normalization and output scaling cancel */
+
+/* Private variables ---------------------------------------------------------*/
+static int16_t  s_in[BENCH_MAX_INPUTS][BENCH_NB_SAMPLES];
+static int16_t  s_out[BENCH_NB_SAMPLES];
+static uint32_t s_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+#if !defined(__x86_64__) && !defined(__i386__)
+static double s_bench_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+#endif
+
+
+static int16_t s_bench_rand(int const amplitude)
+{
+  s_seed = (s_seed * 1664525U) + 1013904223U;
+  return (int16_t)((int32_t)(s_seed >> 16) % (2 * amplitude + 1) - amplitude);
+}
+
+
+static void s_bench_inputs(mixFusedIn_t *const pInputs, int const nbInputs, float const gain)
+{
+  for (int i = 0; i < nbInputs; i++)
+  {
+    pInputs[i].pSamples  = s_in[i];
+    pInputs[i].type      = MIX_FUSED_FIXED16;
+    pInputs[i].chOffset  = 1;
+    pInputs[i].splOffset = BENCH_NB_CHANNELS;
+    pInputs[i].gain      = gain * BENCH_TYPE_GAIN;
+    pInputs[i].gainStep  = 0.0f;
+  }
+}
+
+
+/**
+ * @brief  model of the sfc path: each input is converted, scaled and mixed into the output in its own pass
+ */
+static void s_bench_perInput(mixFusedIn_t const *const pInputs, int const nbInputs)
+{
+  for (int i = 0; i < nbInputs; i++)
+  {
+    int16_t const *const pIn = (int16_t const *)pInputs[i].pSamples;
+
+    for (int k = 0; k < BENCH_NB_SAMPLES; k++)
+    {
+      float const sample = (float)pIn[k] * pInputs[i].gain;
+
+      s_out[k] = mix_fused_round_int16((i == 0) ? sample : ((float)s_out[k] + sample));
+    }
+  }
+}
+
+
+/**
+ * @brief  rounding to nearest and saturation of the fixed-point conversions
+ * @retval number of errors
+ */
+static int s_bench_checkRound(void)
+{
+  static const struct {float x; int32_t r16; int32_t r32;} cases[] =
+  {
+    {    2.4f,      2,      2}, {    2.5f,      3,      3}, {   -2.5f,     -3,     -3}, {   -2.6f,     -3,     -3},
+    {32766.6f,  32767,  32767}, {-32768.4f, -32768, -32768}, {40000.0f, 32767, 40000}, {-40000.0f, -32768, -40000},
+    {8388609.0f, 32767, 8388609}, {-8388609.0f, -32768, -8388609},
+    {3.0e9f,    32767, 2147483647}, {-3.0e9f, -32768, (-2147483647 - 1)}
+  };
+  int errors = 0;
+
+  for (size_t i = 0; i < (sizeof(cases) / sizeof(cases[0])); i++)
+  {
+    int32_t const r16 = mix_fused_round_int16(cases[i].x);
+    int32_t const r32 = mix_fused_round_int32(cases[i].x);
+
+    if ((r16 != cases[i].r16) || (r32 != cases[i].r32))
+    {
+      printf("round %.1f: int16 %d (expected %d), int32 %d (expected %d)\n", cases[i].x, (int)r16, (int)cases[i].r16, (int)r32, (int)cases[i].r32);
+      errors++;
+    }
+  }
+
+  return errors;
+}
+
+
+/**
+ * @brief  fused mix against a double precision reference: within half a LSB, without truncation bias,
+ *         saturated on overload
+ * @retval number of errors
+ */
+static int s_bench_checkMix(void)
+{
+  mixFusedIn_t        inputs[BENCH_MAX_INPUTS];
+  mixFusedOut_t const output   = {s_out, MIX_FUSED_FIXED16, 1, BENCH_NB_CHANNELS};
+  float         const gains[4] = {0.7071f, 0.5f, 0.3333f, 0.1f};
+  double              maxError = 0.0;
+  double              bias     = 0.0;
+  int                 errors   = 0;
+
+  s_bench_inputs(inputs, BENCH_MAX_INPUTS, 1.0f);
+  for (int i = 0; i < BENCH_MAX_INPUTS; i++)
+  {
+    inputs[i].gain = gains[i] * BENCH_TYPE_GAIN;
+  }
+  mix_fused_frame(inputs, BENCH_MAX_INPUTS, &output, BENCH_NB_CHANNELS, BENCH_NB_ELEMENTS);
+  for (int k = 0; k < BENCH_NB_SAMPLES; k++)
+  {
+    double exact = 0.0;
+
+    for (int i = 0; i < BENCH_MAX_INPUTS; i++)
+    {
+      exact += (double)s_in[i][k] * (double)inputs[i].gain;
+    }
+    maxError = fmax(maxError, fabs(exact - (double)s_out[k]));
+    bias    += fabs(exact) - fabs((double)s_out[k]);
+  }
+  bias /= BENCH_NB_SAMPLES;
+  printf("fused mix: max error %.3f LSB, bias toward zero %.3f LSB\n", maxError, bias);
+  if ((maxError > 0.501) || (fabs(bias) > 0.05))
+  {
+    printf("fused mix: rounding error\n");
+    errors++;
+  }
+
+  s_bench_inputs(inputs, BENCH_MAX_INPUTS, 1.0f);
+  for (int k = 0; k < BENCH_NB_SAMPLES; k++)
+  {
+    for (int i = 0; i < BENCH_MAX_INPUTS; i++)
+    {
+      s_in[i][k] = ((k & 1) == 0) ? 20000 : -20000;
+    }
+  }
+  mix_fused_frame(inputs, BENCH_MAX_INPUTS, &output, BENCH_NB_CHANNELS, BENCH_NB_ELEMENTS);
+  for (int k = 0; (k < BENCH_NB_SAMPLES) && (errors == 0); k++)
+  {
+    if (s_out[k] != (((k & 1) == 0) ? 32767 : -32768))
+    {
+      printf("fused mix: sample %d not saturated (%d)\n", k, (int)s_out[k]);
+      errors++;
+    }
+  }
+
+  return errors;
+}
+
+
+int main(void)
+{
+  int errors = 0;
+
+  for (int i = 0; i < BENCH_MAX_INPUTS; i++)
+  {
+    for (int k = 0; k < BENCH_NB_SAMPLES; k++)
+    {
+      s_in[i][k] = s_bench_rand(8000);
+    }
+  }
+  errors += s_bench_checkRound();
+  errors += s_bench_checkMix();
+
+  for (int i = 0; i < BENCH_MAX_INPUTS; i++)
+  {
+    for (int k = 0; k < BENCH_NB_SAMPLES; k++)
+    {
+      s_in[i][k] = s_bench_rand(8000);
+    }
+  }
+  printf("fixed16 stereo interleaved, %d samples per channel\n", BENCH_NB_ELEMENTS);
+  printf("%6s %18s %18s %12s\n", "inputs", "fused " BENCH_UNIT "/frame", "sfc-like " BENCH_UNIT "/frame", "fused/sample");
+  for (int nbInputs = 2; nbInputs <= BENCH_MAX_INPUTS; nbInputs++)
+  {
+    mixFusedIn_t        inputs[BENCH_MAX_INPUTS];
+    mixFusedOut_t const output = {s_out, MIX_FUSED_FIXED16, 1, BENCH_NB_CHANNELS};
+    double              start;
+    double              fused;
+    double              perInput;
+
+    s_bench_inputs(inputs, nbInputs, 1.0f / (float)nbInputs);
+    start = BENCH_NOW();
+    for (int frame = 0; frame < BENCH_NB_FRAMES; frame++)
+    {
+      mix_fused_frame(inputs, nbInputs, &output, BENCH_NB_CHANNELS, BENCH_NB_ELEMENTS);
+      __asm__ volatile("" : : "r"(s_out) : "memory");
+    }
+    fused = (BENCH_NOW() - start) / BENCH_NB_FRAMES;
+
+    start = BENCH_NOW();
+    for (int frame = 0; frame < BENCH_NB_FRAMES; frame++)
+    {
+      s_bench_perInput(inputs, nbInputs);
+      __asm__ volatile("" : : "r"(s_out) : "memory");
+    }
+    perInput = (BENCH_NOW() - start) / BENCH_NB_FRAMES;
+
+    printf("%6d %18.0f %18.0f %12.2f\n", nbInputs, fused, perInput, fused / BENCH_NB_SAMPLES);
+  }
+  printf("%s\n", (errors == 0) ? "PASSED" : "FAILED");
+
+  return (errors == 0) ? 0 : 1;
+}
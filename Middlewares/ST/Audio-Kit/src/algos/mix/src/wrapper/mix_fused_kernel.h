@@ -0,0 +1,264 @@
+/**
+******************************************************************************
+* @file    mix_fused_kernel.h
+* @author  MCD Application Team
+* @brief   fused conversion + gain ramp + mix kernel of mix algo
+*          Shared by audio_chain_mix.c and its host benchmark mix_fused_bench.c.
+*******************************************************************************
+* @attention
+*
+* Copyright (c) 2019(-2022) STMicroelectronics.
+* All rights reserved.
+*
+* This software is licensed under terms that can be found in the LICENSE file
+* in the root directory of this software component.
+* If no LICENSE file comes with this software, it is provided AS-IS.
+*
+********************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MIX_FUSED_KERNEL_H
+#define __MIX_FUSED_KERNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define MIX_FUSED_BLOCK_SIZE 32  /* samples accumulated on stack before being stored into output chunk */
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  MIX_FUSED_FIXED16,
+  MIX_FUSED_FIXED32,
+  MIX_FUSED_FLOAT
+} mixFusedType_t;
+
+typedef struct
+{
+  void const     *pSamples;   // first sample of the frame
+  mixFusedType_t  type;
+  int             chOffset;
+  int             splOffset;
+  float           gain;       // linear gain (including type normalization) at frame start
+  float           gainStep;   // per-sample gain increment of the ramp
+} mixFusedIn_t;
+
+typedef struct
+{
+  void           *pSamples;
+  mixFusedType_t  type;
+  int             chOffset;
+  int             splOffset;
+} mixFusedOut_t;
+
+/* Exported functions ------------------------------------------------------- */
+/**
+ * @brief  rounds to nearest integer (half away from zero) then saturates to int16
+ * @param  x: sample in output type scale
+ * @retval sample
+ */
+static inline int16_t mix_fused_round_int16(float const x)
+{
+  float const rounded = (x >= 0.0f) ? (x + 0.5f) : (x - 0.5f);
+
+  return (rounded <= -32768.0f) ? (int16_t) -32768 : ((rounded >= 32767.0f) ? (int16_t)32767 : (int16_t)rounded);
+}
+
+
+/**
+ * @brief  rounds to nearest integer (half away from zero) then saturates to int32
+ * @note   from 2^23 floats are integers: adding 0.5 would round to even on odd values
+ * @param  x: sample in output type scale
+ * @retval sample
+ */
+static inline int32_t mix_fused_round_int32(float const x)
+{
+  float rounded = x;
+
+  if ((x < 8388608.0f) && (x > -8388608.0f))
+  {
+    rounded = (x >= 0.0f) ? (x + 0.5f) : (x - 0.5f);
+  }
+
+  return (rounded <= -2147483648.0f) ? (int32_t)(-2147483647L - 1L) : ((rounded >= 2147483647.0f) ? (int32_t)2147483647L : (int32_t)rounded);
+}
+
+
+/**
+ * @brief  converts, scales with a linear gain ramp and accumulates a block of samples of an input
+ * @param  pInput:    input
+ * @param  pIn:       first sample of the block
+ * @param  pAcc:      accumulator
+ * @param  nbSamples: block size
+ * @param  gain:      gain of first sample
+ * @param  first:     true to initialize the accumulator
+ * @retval None
+ */
+static inline void mix_fused_accumulate(mixFusedIn_t const *const pInput, void const *const pIn, float *const pAcc, int const nbSamples, float const gain, bool const first)
+{
+  int   const splOffset = pInput->splOffset;
+  float const gainStep  = pInput->gainStep;
+  float       g         = gain;
+
+  switch (pInput->type)
+  {
+    case MIX_FUSED_FIXED16:
+    {
+      int16_t const *const pSpl = (int16_t const *)pIn;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        float const sample = (float)pSpl[i * splOffset] * g;
+
+        pAcc[i] = first ? sample : (pAcc[i] + sample);
+        g      += gainStep;
+      }
+      break;
+    }
+
+    case MIX_FUSED_FIXED32:
+    {
+      int32_t const *const pSpl = (int32_t const *)pIn;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        float const sample = (float)pSpl[i * splOffset] * g;
+
+        pAcc[i] = first ? sample : (pAcc[i] + sample);
+        g      += gainStep;
+      }
+      break;
+    }
+
+    default:
+    {
+      float const *const pSpl = (float const *)pIn;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        float const sample = pSpl[i * splOffset] * g;
+
+        pAcc[i] = first ? sample : (pAcc[i] + sample);
+        g      += gainStep;
+      }
+      break;
+    }
+  }
+}
+
+
+/**
+ * @brief  stores a block of accumulated samples, rounded and saturated for fixed-point outputs
+ * @param  pOutput:   output
+ * @param  pOut:      first sample of the block
+ * @param  pAcc:      accumulator
+ * @param  nbSamples: block size
+ * @retval None
+ */
+static inline void mix_fused_store(mixFusedOut_t const *const pOutput, void *const pOut, float const *const pAcc, int const nbSamples)
+{
+  int const splOffset = pOutput->splOffset;
+
+  switch (pOutput->type)
+  {
+    case MIX_FUSED_FIXED16:
+    {
+      int16_t *const pSpl = (int16_t *)pOut;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        pSpl[i * splOffset] = mix_fused_round_int16(pAcc[i]);
+      }
+      break;
+    }
+
+    case MIX_FUSED_FIXED32:
+    {
+      int32_t *const pSpl = (int32_t *)pOut;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        pSpl[i * splOffset] = mix_fused_round_int32(pAcc[i]);
+      }
+      break;
+    }
+
+    default:
+    {
+      float *const pSpl = (float *)pOut;
+
+      for (int i = 0; i < nbSamples; i++)
+      {
+        pSpl[i * splOffset] = pAcc[i];
+      }
+      break;
+    }
+  }
+}
+
+
+/**
+ * @brief  bytes per sample
+ * @param  type: samples type
+ * @retval sample size
+ */
+static inline int mix_fused_sampleSize(mixFusedType_t const type)
+{
+  return (type == MIX_FUSED_FIXED16) ? (int)sizeof(int16_t) : ((type == MIX_FUSED_FIXED32) ? (int)sizeof(int32_t) : (int)sizeof(float));
+}
+
+
+/**
+ * @brief  fused conversion + gain + mix of all inputs over a frame
+ * @note   inputs are converted, scaled and accumulated by blocks of MIX_FUSED_BLOCK_SIZE samples in a stack accumulator
+ *         which is stored only once into output: no intermediate frame buffer and no output read-modify-write per input
+ * @param  pInputs:    inputs
+ * @param  nbInputs:   number of inputs
+ * @param  pOutput:    output
+ * @param  nbChannels: number of channels
+ * @param  nbElements: number of samples per channel
+ * @retval None
+ */
+static inline void mix_fused_frame(mixFusedIn_t const *const pInputs, int const nbInputs, mixFusedOut_t const *const pOutput, int const nbChannels, int const nbElements)
+{
+  float acc[MIX_FUSED_BLOCK_SIZE];
+
+  for (int ch = 0; ch < nbChannels; ch++)
+  {
+    for (int spl = 0; spl < nbElements; spl += MIX_FUSED_BLOCK_SIZE)
+    {
+      int const nbSamples = ((nbElements - spl) < MIX_FUSED_BLOCK_SIZE) ? (nbElements - spl) : MIX_FUSED_BLOCK_SIZE;
+
+      for (int i = 0; i < nbInputs; i++)
+      {
+        mixFusedIn_t const *const pInput = &pInputs[i];
+        int                 const splIdx = (ch * pInput->chOffset) + (spl * pInput->splOffset);
+
+        mix_fused_accumulate(pInput,
+                             (uint8_t const *)pInput->pSamples + (splIdx * mix_fused_sampleSize(pInput->type)),
+                             acc,
+                             nbSamples,
+                             pInput->gain + ((float)spl * pInput->gainStep),
+                             i == 0);
+      }
+
+      mix_fused_store(pOutput,
+                      (uint8_t *)pOutput->pSamples + (((ch * pOutput->chOffset) + (spl * pOutput->splOffset)) * mix_fused_sampleSize(pOutput->type)),
+                      acc,
+                      nbSamples);
+    }
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* __MIX_FUSED_KERNEL_H */
@@ -28,7 +28,24 @@ extern "C" {
 #include "audio_chain.h"
 
 /* Exported types ------------------------------------------------------------*/
+/* Bypass of an algo whose current parameters make it an identity: the algo kernel is
+   replaced by a pass-through copy (a pointer hand-off if input & output chunks share their buffer) */
+typedef struct
+{
+  audio_algo_t          *pAlgo;
+  bool                   bCopyPossible;     /* first input & output chunks have the same layout */
+  bool          volatile bNeutral;          /* set by the algo configure when its parameters are neutral */
+  uint32_t               kernelCycles;      /* cycles of the last frame processed by the algo kernel */
+  uint32_t               copyCycles;        /* cycles of the last bypassed frame */
+  uint32_t               nbFramesBypassed;
+} passThrough_bypass_t;
+
 /* Exported constants --------------------------------------------------------*/
+#define PASSTHROUGH_BYPASS_MAX_ALGOS 16U  /* algos registered for the bypass report; algo init fails beyond */
+/* Only algos whose wrapper is delivered as source (gain, mix) use the bypass: the iir_equalizer,
+   fir_graphic_equalizer and mdrc wrappers are part of the AudioChainAlgos libraries and only their
+   factories are in src/algos, their dataInOut can't hand their frame to the pass-through copy */
+
 /* Exported variables --------------------------------------------------------*/
 extern const audio_algo_factory_t AudioChainWrp_passThrough_factory;
 extern const audio_algo_common_t  AudioChainWrp_passThrough_common;
@@ -39,6 +56,15 @@ extern       audio_algo_cbs_t     AudioChainWrp_passThrough_cbs;
 int32_t AudioChainWrp_passThrough_dataInOut(audio_algo_t *const pAlgo);
 int32_t AudioChainWrp_passThrough_checkConsistency(audio_algo_t *const pAlgo);
 
+int32_t                     AudioChainWrp_passThrough_bypassInit(passThrough_bypass_t        *const pBypass, audio_algo_t *const pAlgo);
+void                        AudioChainWrp_passThrough_bypassDeinit(passThrough_bypass_t      *const pBypass);
+void                        AudioChainWrp_passThrough_bypassSetNeutral(passThrough_bypass_t  *const pBypass, bool const bNeutral);
+bool                        AudioChainWrp_passThrough_bypassIsOn(passThrough_bypass_t  const *const pBypass);
+uint32_t                    AudioChainWrp_passThrough_bypassStart(passThrough_bypass_t const *const pBypass);
+int32_t                     AudioChainWrp_passThrough_bypassDataInOut(passThrough_bypass_t   *const pBypass, uint32_t const startCycles);
+void                        AudioChainWrp_passThrough_bypassKernelDone(passThrough_bypass_t  *const pBypass, uint32_t const startCycles);
+passThrough_bypass_t const *AudioChainWrp_passThrough_bypassGet(uint8_t const id);
+
 #ifdef __cplusplus
 }
 #endif
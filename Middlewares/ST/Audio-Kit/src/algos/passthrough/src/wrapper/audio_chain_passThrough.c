@@ -23,9 +23,12 @@
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+static passThrough_bypass_t *tBypass[PASSTHROUGH_BYPASS_MAX_ALGOS];
+
 /* Private function prototypes -----------------------------------------------*/
-static int32_t s_passThrough_deinit(audio_algo_t    *const pAlgo);
-static int32_t s_passThrough_init(audio_algo_t      *const pAlgo);
+static int32_t  s_passThrough_deinit(audio_algo_t    *const pAlgo);
+static int32_t  s_passThrough_init(audio_algo_t      *const pAlgo);
+static uint32_t s_passThrough_currentCycles(audio_algo_t *const pAlgo);
 
 /* Global variables ----------------------------------------------------------*/
 const audio_algo_common_t AudioChainWrp_passThrough_common =
@@ -50,7 +53,8 @@ const audio_algo_common_t AudioChainWrp_passThrough_common =
   .iosOut.time_freq          = AUDIO_CAPABILITY_TIME,
   .iosOut.type               = AUDIO_CAPABILITY_TYPE_ALL,
 
-  .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("simple buffer copy (no processing)")
+  .misc.pAlgoDesc            = AUDIO_ALGO_OPT_STR("simple buffer copy (no processing)"),
+  .misc.flags                = AUDIO_ALGO_FLAGS_MISC_IN_PLACE
 };
 
 audio_algo_cbs_t AudioChainWrp_passThrough_cbs =
@@ -115,7 +119,10 @@ int32_t AudioChainWrp_passThrough_dataInOut(audio_algo_t *const pAlgo)
     void *const ptrIn  = AudioChunk_getReadPtr0(pChunkIn);
     void *const ptrOut = AudioChunk_getWritePtr0(pChunkOut);
 
-    memcpy(ptrOut, ptrIn, AudioBuffer_getBufferSize(pBuffIn));
+    if (ptrOut != ptrIn)  // chunks sharing the same buffer (in-place): nothing to copy
+    {
+      memcpy(ptrOut, ptrIn, AudioBuffer_getBufferSize(pBuffIn));
+    }
   }
   else
   {
@@ -130,9 +137,124 @@ int32_t AudioChainWrp_passThrough_dataInOut(audio_algo_t *const pAlgo)
       void *const ptrIn  = AudioChunk_getReadPtr(pChunkIn,   ch, 0UL);
       void *const ptrOut = AudioChunk_getWritePtr(pChunkOut, ch, 0UL);
 
-      memcpy(ptrOut, ptrIn, (size_t)size);
+      if (ptrOut != ptrIn)
+      {
+        memcpy(ptrOut, ptrIn, (size_t)size);
+      }
     }
   }
 
   return AUDIO_ERR_MGNT_NONE;
 }
+
+
+/**
+* @brief  Register an algo for the bypass at neutral settings; must be called by the algo init
+*         after its chunks are connected
+* @param  pBypass bypass context, part of the algo wrapper context
+* @param  pAlgo   algo
+* @retval Error; AUDIO_ERR_MGNT_ALLOCATION if PASSTHROUGH_BYPASS_MAX_ALGOS algos are already registered
+*/
+int32_t AudioChainWrp_passThrough_bypassInit(passThrough_bypass_t *const pBypass, audio_algo_t *const pAlgo)
+{
+  int32_t              error     = AUDIO_ERR_MGNT_NONE;
+  audio_chunk_t *const pChunkIn  = AudioAlgo_getChunkPtrIn(pAlgo,  0U);
+  audio_chunk_t *const pChunkOut = AudioAlgo_getChunkPtrOut(pAlgo, 0U);
+  bool                 bStored   = false;
+
+  memset(pBypass, 0, sizeof(*pBypass));
+  pBypass->pAlgo = pAlgo;
+  if ((pChunkIn != NULL) && (pChunkOut != NULL))
+  {
+    pBypass->bCopyPossible = AudioError_isOk(AudioBuffer_checkAudioBuffersCompatibility(AudioChunk_getBuffInfo(pChunkIn), AudioChunk_getBuffInfo(pChunkOut), ABUFF_PARAM_ALL));
+  }
+
+  for (uint8_t i = 0U; (i < PASSTHROUGH_BYPASS_MAX_ALGOS) && !bStored; i++)
+  {
+    if (tBypass[i] == NULL)
+    {
+      tBypass[i] = pBypass;
+      bStored    = true;
+    }
+  }
+  if (!bStored)
+  {
+    AudioAlgo_trace(pAlgo, TRACE_LVL_ERROR, NULL, 0, "bypass table full, increase PASSTHROUGH_BYPASS_MAX_ALGOS !");
+    error = AUDIO_ERR_MGNT_ALLOCATION;
+  }
+
+  return error;
+}
+
+
+void AudioChainWrp_passThrough_bypassDeinit(passThrough_bypass_t *const pBypass)
+{
+  for (uint8_t i = 0U; i < PASSTHROUGH_BYPASS_MAX_ALGOS; i++)
+  {
+    if (tBypass[i] == pBypass)
+    {
+      tBypass[i] = NULL;
+    }
+  }
+}
+
+
+/**
+* @brief  Report whether the algo parameters are neutral (identity operation); called by the algo configure
+* @param  pBypass  bypass context
+* @param  bNeutral true if the algo output would be a copy of its input
+* @retval None
+*/
+void AudioChainWrp_passThrough_bypassSetNeutral(passThrough_bypass_t *const pBypass, bool const bNeutral)
+{
+  pBypass->bNeutral = bNeutral;
+}
+
+
+bool AudioChainWrp_passThrough_bypassIsOn(passThrough_bypass_t const *const pBypass)
+{
+  return pBypass->bNeutral && pBypass->bCopyPossible;
+}
+
+
+uint32_t AudioChainWrp_passThrough_bypassStart(passThrough_bypass_t const *const pBypass)
+{
+  return s_passThrough_currentCycles(pBypass->pAlgo);
+}
+
+
+/**
+* @brief  Bypassed frame: copy input to output and account cycles
+* @param  pBypass     bypass context
+* @param  startCycles value returned by AudioChainWrp_passThrough_bypassStart at the beginning of the frame
+* @retval Error
+*/
+int32_t AudioChainWrp_passThrough_bypassDataInOut(passThrough_bypass_t *const pBypass, uint32_t const startCycles)
+{
+  int32_t const error = AudioChainWrp_passThrough_dataInOut(pBypass->pAlgo);
+
+  pBypass->copyCycles = s_passThrough_currentCycles(pBypass->pAlgo) - startCycles;
+  pBypass->nbFramesBypassed++;
+
+  return error;
+}
+
+
+void AudioChainWrp_passThrough_bypassKernelDone(passThrough_bypass_t *const pBypass, uint32_t const startCycles)
+{
+  pBypass->kernelCycles = s_passThrough_currentCycles(pBypass->pAlgo) - startCycles;
+}
+
+
+passThrough_bypass_t const *AudioChainWrp_passThrough_bypassGet(uint8_t const id)
+{
+  return (id < PASSTHROUGH_BYPASS_MAX_ALGOS) ? tBypass[id] : NULL;
+}
+
+
+static uint32_t s_passThrough_currentCycles(audio_algo_t *const pAlgo)
+{
+  audio_chain_utilities_t *const pUtilsHdle = AudioAlgo_getUtilsHdle(pAlgo);
+
+  return ((pUtilsHdle != NULL) && (pUtilsHdle->cyclesCbs.currentCycles != NULL)) ? pUtilsHdle->cyclesCbs.currentCycles() : 0UL;
+}
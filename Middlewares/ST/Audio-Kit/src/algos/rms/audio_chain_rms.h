@@ -34,6 +34,7 @@ extern       audio_algo_cbs_t     AudioChainWrp_rms_cbs;
 
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
+int32_t AudioChainWrp_rms_getLevels(audio_algo_t *const pAlgo, rmsLevels_t *const pLevels);
 
 
 #ifdef __cplusplus
@@ -32,6 +32,27 @@ static const audio_descriptor_param_t s_rms_staticParamsDesc[] =
     .pControl          = AUDIO_ALGO_OPT_STR("checkbox"),
     .pName             = "isDoublePrecision",
     AUDIO_DESC_PARAM_U8(rms_stat_config_t, isDoublePrecision, 0U, 1U)
+  },
+  {
+    .pDescription      = AUDIO_ALGO_OPT_STR("Sliding window 1 (in ms) for rms and peak levels, 0 to disable; rounded to a multiple of the frame duration"),
+    .pDefault          = "0",
+    .pControl          = AUDIO_ALGO_OPT_STR("slider"),
+    .pName             = "windowTime1",
+    AUDIO_DESC_PARAM_U16(rms_stat_config_t, windowTime1, 0, 10000)
+  },
+  {
+    .pDescription      = AUDIO_ALGO_OPT_STR("Sliding window 2 (in ms) for rms and peak levels, 0 to disable; rounded to a multiple of the frame duration"),
+    .pDefault          = "0",
+    .pControl          = AUDIO_ALGO_OPT_STR("slider"),
+    .pName             = "windowTime2",
+    AUDIO_DESC_PARAM_U16(rms_stat_config_t, windowTime2, 0, 10000)
+  },
+  {
+    .pDescription      = AUDIO_ALGO_OPT_STR("Sliding window 3 (in ms) for rms and peak levels, 0 to disable; rounded to a multiple of the frame duration"),
+    .pDefault          = "0",
+    .pControl          = AUDIO_ALGO_OPT_STR("slider"),
+    .pName             = "windowTime3",
+    AUDIO_DESC_PARAM_U16(rms_stat_config_t, windowTime3, 0, 10000)
   }
 };
 
@@ -33,9 +33,14 @@ typedef struct
 }
 rms_dyn_config_t;
 
+#define RMS_MAX_NB_WINDOWS  3U
+
 typedef struct
 {
-  uint8_t isDoublePrecision;
+  uint8_t  isDoublePrecision;
+  uint16_t windowTime1;    // sliding window duration in milliseconds, 0 means disabled
+  uint16_t windowTime2;    // sliding window duration in milliseconds, 0 means disabled
+  uint16_t windowTime3;    // sliding window duration in milliseconds, 0 means disabled
 }
 rms_stat_config_t;
 
@@ -45,6 +50,18 @@ typedef struct
   float     rms[RMS_MAX_NB_CHANNELS];     // one value per channel
 } rmsCtrl_t;
 
+/* Sliding windows levels, updated every frame by the process and readable from any task
+   with AudioChainWrp_rms_getLevels() (no control task round trip) */
+typedef struct
+{
+  volatile uint32_t seq;                                          // odd while levels are being updated
+  uint32_t          nbWindows;
+  uint32_t          nbChannels;
+  uint32_t          windowSamples[RMS_MAX_NB_WINDOWS];            // effective window length (multiple of the frame size)
+  float             rms[RMS_MAX_NB_WINDOWS][RMS_MAX_NB_CHANNELS]; // normalized to full scale
+  float             peak[RMS_MAX_NB_WINDOWS][RMS_MAX_NB_CHANNELS];// normalized to full scale
+} rmsLevels_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
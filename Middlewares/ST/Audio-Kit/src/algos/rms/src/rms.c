@@ -23,6 +23,7 @@
 #include <arm_math.h>
 /*cstat +MISRAC2012-* */
 #include "audio_chunk.h"
+#include "rms/rms_config.h"
 #include "rms.h"
 
 /* Global variables ----------------------------------------------------------*/
@@ -44,6 +45,28 @@ typedef struct rmsFloatStruct
 } rmsFloat_t;
 
 
+typedef struct rmsPeakFifoStruct
+{
+  uint32_t  head;        // index of the oldest (and biggest) peak
+  uint32_t  count;
+  uint32_t *pFrameIdx;   // wrapped frame indexes of decreasing peaks inside the window (window length entries)
+} rmsPeakFifo_t;
+
+typedef struct rmsWindowsStruct
+{
+  uint32_t       nbWindows;
+  uint32_t       historyFrames;  // frames history length (longest window)
+  uint32_t       frameIdx;       // index of the current frame, wrapped at 2 x historyFrames so that peak ages up to historyFrames are unambiguous
+  uint32_t       nbFrames;       // number of processed frames, saturated at historyFrames
+  uint32_t       windowFrames[RMS_MAX_NB_WINDOWS];
+  float         *pCurR2;         // [nbChannels] current frame sum of squares (not normalized), filled by the rms sample loop
+  float         *pCurPeak;       // [nbChannels] current frame peak (not normalized), filled by the rms sample loop
+  double        *pSum;           // [nbWindows][nbChannels] sliding sums of squares; double: no drift with add/remove of frame energies
+  float         *pFrameR2;       // [nbChannels][historyFrames] frames sum of squares (not normalized)
+  float         *pFramePeak;     // [nbChannels][historyFrames] frames peak (not normalized)
+  rmsPeakFifo_t *pPeakFifo;      // [nbWindows][nbChannels] monotonic queues for sliding peak
+} rmsWindows_t;
+
 typedef struct rmsContextStruct
 {
   union
@@ -51,19 +74,24 @@ typedef struct rmsContextStruct
     rmsFloat_t  f32;
     rmsDouble_t f64;
   } data;
-  float *pRmsOut;
+  float        *pRmsOut;
+  float         normalizer;
+  rmsWindows_t  windows;
 } rmsContext_t;
 
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
-static int32_t s_process_splesQ15_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData);
-static int32_t s_process_splesQ15_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData);
-static int32_t s_process_splesQ31_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData);
-static int32_t s_process_splesQ31_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData);
-static int32_t s_process_splesF32_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float   const *pData);
-static int32_t s_process_splesF32_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float   const *pData);
+static int32_t s_process_splesQ15_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData, rmsWindows_t *const pWindows);
+static int32_t s_process_splesQ15_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData, rmsWindows_t *const pWindows);
+static int32_t s_process_splesQ31_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData, rmsWindows_t *const pWindows);
+static int32_t s_process_splesQ31_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData, rmsWindows_t *const pWindows);
+static int32_t s_process_splesF32_rmsF32(rmsFloat_t  *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float   const *pData, rmsWindows_t *const pWindows);
+static int32_t s_process_splesF32_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float   const *pData, rmsWindows_t *const pWindows);
+static size_t  s_windows_layout(rmsHdler_t const *const pHdle, rmsWindows_t *const pWindows, uint8_t *const pBase, size_t const offset);
+static void    s_windows_process(rmsHdler_t const *const pHdle, rmsWindows_t *const pWindows, float const normalizer, uint32_t const nbSamples);
+static uint32_t s_windows_histPos(uint32_t const historyFrames, uint32_t const frameIdx);
 
 
 /* Functions Definition ------------------------------------------------------*/
@@ -130,6 +158,8 @@ int32_t rmsInit(rmsHdler_t *const pHdle)
       pContext->pRmsOut             = (float *)(pContext_u8 + allocOffset);
     }
     allocOffset += pHdle->nbChannels *  sizeof(float);
+    allocOffset  = s_windows_layout(pHdle, &pContext->windows, pContext_u8, allocOffset);
+    pContext->normalizer = normalizer;
     if (allocOffset != pHdle->internalMemSize)
     {
       error = AUDIO_ERR_MGNT_ALLOCATION;
@@ -155,6 +185,7 @@ int32_t rmsGetMemorySize(rmsHdler_t *const pHdle)
   allocSize  = sizeof(rmsContext_t);
   allocSize += pHdle->nbChannels * sampleSzBytes;
   allocSize += pHdle->nbChannels * sizeof(float); /* pRmsValues is always float for simplicity of API */
+  allocSize  = s_windows_layout(pHdle, NULL, NULL, allocSize);
   pHdle->internalMemSize = allocSize;
   return error;
 }
@@ -212,6 +243,7 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
   uint8_t               const nbChannels    = pHdle->nbChannels; // using nbChannels from pHdle allows to compute RMS for only first channel even if chunk is multi channels; previous code = AudioBuffer_getNbChannels(pBuffIn);
   uint32_t              const sampleOffset  = AudioBuffer_getSamplesOffset(pBuffIn);
   uint32_t              const channelOffset = AudioBuffer_getChannelsOffset(pBuffIn);
+  rmsWindows_t               *const pWindows      = (pContext->windows.nbWindows > 0UL) ? &pContext->windows : NULL;
 
   switch (pHdle->audioType)
   {
@@ -220,11 +252,11 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
       int16_t const *pDataFixed16 = (int16_t const *)pData;
       if (pHdle->isDoublePrecision)
       {
-        error = s_process_splesQ15_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed16);
+        error = s_process_splesQ15_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed16, pWindows);
       }
       else
       {
-        error = s_process_splesQ15_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed16);
+        error = s_process_splesQ15_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed16, pWindows);
       }
       break;
     }
@@ -234,11 +266,11 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
       int32_t const *pDataFixed32 = (int32_t const *)pData;
       if (pHdle->isDoublePrecision)
       {
-        error = s_process_splesQ31_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed32);
+        error = s_process_splesQ31_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed32, pWindows);
       }
       else
       {
-        error = s_process_splesQ31_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed32);
+        error = s_process_splesQ31_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFixed32, pWindows);
       }
       break;
     }
@@ -248,11 +280,11 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
       float const *pDataFloat = (float const *)pData;
       if (pHdle->isDoublePrecision)
       {
-        error = s_process_splesF32_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFloat);
+        error = s_process_splesF32_rmsF64(&pContext->data.f64, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFloat, pWindows);
       }
       else
       {
-        error = s_process_splesF32_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFloat);
+        error = s_process_splesF32_rmsF32(&pContext->data.f32, nbSamples, sampleOffset, nbChannels, channelOffset, pDataFloat, pWindows);
       }
       break;
     }
@@ -262,6 +294,11 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
       break;
   }
 
+  if (AudioError_isOk(error) && (pWindows != NULL))
+  {
+    s_windows_process(pHdle, pWindows, pContext->normalizer, nbSamples);
+  }
+
   if (AudioError_isOk(error))
   {
     if (pHdle->isDoublePrecision)
@@ -290,18 +327,39 @@ int32_t rmsProcess(rmsHdler_t *const pHdle, audio_chunk_t const *const pChunkIn)
 /* Static functions ***********************************************************/
 
 
-static int32_t s_process_splesQ15_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData)
+static int32_t s_process_splesQ15_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  float   xn, r2;
+  float   xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF32->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
     {
-      xn = (float)pData[spl * sampleOffset];
-      r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      // frame energy & peak of the sliding windows gathered in the same pass
+      float frameR2 = 0.0f;
+      float peak    = 0.0f;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (float)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF32->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0f) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
+    {
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (float)pData[spl * sampleOffset];
+        r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF32->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -310,18 +368,39 @@ static int32_t s_process_splesQ15_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t co
 }
 
 
-static int32_t s_process_splesQ15_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData)
+static int32_t s_process_splesQ15_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int16_t const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  double  xn, r2;
+  double  xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF64->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
     {
-      xn = (double)pData[spl * sampleOffset];
-      r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      // frame energy & peak of the sliding windows gathered in the same pass
+      double frameR2 = 0.0;
+      double peak    = 0.0;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (double)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF64->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
+    {
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (double)pData[spl * sampleOffset];
+        r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF64->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -330,18 +409,39 @@ static int32_t s_process_splesQ15_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t c
 }
 
 
-static int32_t s_process_splesQ31_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData)
+static int32_t s_process_splesQ31_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  float   xn, r2;
+  float   xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF32->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
     {
-      xn = (float)pData[spl * sampleOffset];
-      r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      // frame energy & peak of the sliding windows gathered in the same pass
+      float frameR2 = 0.0f;
+      float peak    = 0.0f;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (float)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF32->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0f) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
+    {
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (float)pData[spl * sampleOffset];
+        r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF32->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -350,18 +450,39 @@ static int32_t s_process_splesQ31_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t co
 }
 
 
-static int32_t s_process_splesQ31_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData)
+static int32_t s_process_splesQ31_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, int32_t const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  double  xn, r2;
+  double  xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF64->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
     {
-      xn = (double)pData[spl * sampleOffset];
-      r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      // frame energy & peak of the sliding windows gathered in the same pass
+      double frameR2 = 0.0;
+      double peak    = 0.0;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (double)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF64->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
+    {
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (double)pData[spl * sampleOffset];
+        r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF64->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -370,18 +491,39 @@ static int32_t s_process_splesQ31_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t c
 }
 
 
-static int32_t s_process_splesF32_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float const *pData)
+static int32_t s_process_splesF32_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  float   xn, r2;
+  float   xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF32->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
     {
-      xn = (float)pData[spl * sampleOffset];
-      r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      // frame energy & peak of the sliding windows gathered in the same pass
+      float frameR2 = 0.0f;
+      float peak    = 0.0f;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (float)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF32->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0f) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
+    {
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (float)pData[spl * sampleOffset];
+        r2 += pCtxtF32->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF32->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -391,18 +533,39 @@ static int32_t s_process_splesF32_rmsF32(rmsFloat_t *const pCtxtF32, uint32_t co
 }
 
 
-static int32_t s_process_splesF32_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float const *pData)
+static int32_t s_process_splesF32_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t const nbSamples, uint32_t const sampleOffset, uint8_t const nbChannels, uint32_t const channelOffset, float const *pData, rmsWindows_t *const pWindows)
 {
   int32_t error = AUDIO_ERR_MGNT_NONE;
-  double  xn, r2;
+  double  xn, xn2, r2;
 
   for (uint8_t ch = 0U; ch < nbChannels; ch++)
   {
     r2 = pCtxtF64->pR2Table[ch];
-    for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+    if (pWindows != NULL)
+    {
+      // frame energy & peak of the sliding windows gathered in the same pass
+      double frameR2 = 0.0;
+      double peak    = 0.0;
+
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn       = (double)pData[spl * sampleOffset];
+        xn2      = xn * xn;
+        r2      += pCtxtF64->alpha * (xn2 - r2);
+        frameR2 += xn2;
+        xn       = (xn < 0.0) ? -xn : xn;
+        peak     = (xn > peak) ? xn : peak;
+      }
+      pWindows->pCurR2[ch]   = (float)frameR2;
+      pWindows->pCurPeak[ch] = (float)peak;
+    }
+    else
     {
-      xn = (double)pData[spl * sampleOffset];
-      r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      for (uint32_t spl = 0UL; spl < nbSamples; spl++)
+      {
+        xn = (double)pData[spl * sampleOffset];
+        r2 += pCtxtF64->alpha * ((xn * xn) - r2);
+      }
     }
     pCtxtF64->pR2Table[ch] = r2;
     pData += channelOffset;
@@ -411,3 +574,174 @@ static int32_t s_process_splesF32_rmsF64(rmsDouble_t *const pCtxtF64, uint32_t c
   return error;
 }
 
+
+/**
+* @brief  sliding windows memory layout; computes the size only if pWindows is NULL
+* @param  pHdle    rms handler
+* @param  pWindows windows context to set or NULL
+* @param  pBase    internal memory base address
+* @param  offset   offset of windows memory inside internal memory
+* @retval offset of the end of windows memory
+*/
+static size_t s_windows_layout(rmsHdler_t const *const pHdle, rmsWindows_t *const pWindows, uint8_t *const pBase, size_t const offset)
+{
+  size_t   allocOffset   = offset;
+  uint32_t nbWindows     = 0UL;
+  uint32_t historyFrames = 0UL;
+  uint32_t fifoFrames    = 0UL;
+
+  for (uint32_t w = 0UL; w < RMS_MAX_NB_WINDOWS; w++)
+  {
+    uint32_t const windowFrames = pHdle->windowFrames[w];
+    if (windowFrames != 0UL)
+    {
+      historyFrames  = (windowFrames > historyFrames) ? windowFrames : historyFrames;
+      fifoFrames    += windowFrames;
+      if (pWindows != NULL)
+      {
+        pWindows->windowFrames[nbWindows] = windowFrames;
+      }
+      nbWindows++;
+    }
+  }
+
+  if (nbWindows > 0UL)
+  {
+    size_t const nbChannels = (size_t)pHdle->nbChannels;
+
+    allocOffset = (allocOffset + sizeof(double) - 1UL) & ~(sizeof(double) - 1UL);
+    if (pWindows != NULL)
+    {
+      pWindows->nbWindows     = nbWindows;
+      pWindows->historyFrames = historyFrames;
+      pWindows->frameIdx      = 0UL;
+      pWindows->nbFrames      = 0UL;
+      pWindows->pSum          = (double *)(pBase + allocOffset);
+    }
+    allocOffset += (size_t)nbWindows * nbChannels * sizeof(double);
+    if (pWindows != NULL)
+    {
+      pWindows->pCurR2   = (float *)(pBase + allocOffset);
+      pWindows->pCurPeak = pWindows->pCurR2 + nbChannels;
+    }
+    allocOffset += 2UL * nbChannels * sizeof(float);
+    if (pWindows != NULL)
+    {
+      pWindows->pFrameR2 = (float *)(pBase + allocOffset);
+    }
+    allocOffset += (size_t)historyFrames * nbChannels * sizeof(float);
+    if (pWindows != NULL)
+    {
+      pWindows->pFramePeak = (float *)(pBase + allocOffset);
+    }
+    allocOffset += (size_t)historyFrames * nbChannels * sizeof(float);
+    if (pWindows != NULL)
+    {
+      pWindows->pPeakFifo = (rmsPeakFifo_t *)(pBase + allocOffset);
+    }
+    allocOffset += (size_t)nbWindows * nbChannels * sizeof(rmsPeakFifo_t);
+    if (pWindows != NULL)
+    {
+      uint32_t *pFrameIdx = (uint32_t *)(pBase + allocOffset);
+
+      for (uint32_t w = 0UL; w < nbWindows; w++)
+      {
+        for (size_t ch = 0UL; ch < nbChannels; ch++)
+        {
+          pWindows->pPeakFifo[(w * nbChannels) + ch].pFrameIdx = pFrameIdx;
+          pFrameIdx += pWindows->windowFrames[w];
+        }
+      }
+    }
+    allocOffset += (size_t)fifoFrames * nbChannels * sizeof(uint32_t);
+  }
+
+  return allocOffset;
+}
+
+
+/**
+* @brief  sliding windows rms and peak: frame energy and peak come from the rms
+*         sample loop, then O(1) per window thanks to running sums and
+*         monotonic peak queues
+*/
+static void s_windows_process(rmsHdler_t const *const pHdle, rmsWindows_t *const pWindows, float const normalizer, uint32_t const nbSamples)
+{
+  uint8_t      const nbChannels    = pHdle->nbChannels;
+  uint32_t     const historyFrames = pWindows->historyFrames;
+  uint32_t     const idxWrap       = 2UL * historyFrames;
+  uint32_t     const frameIdx      = pWindows->frameIdx;
+  uint32_t     const nbFrames      = pWindows->nbFrames;
+  uint32_t     const pos           = s_windows_histPos(historyFrames, frameIdx);
+  rmsLevels_t *const pLevels       = pHdle->pLevels;
+
+  pLevels->seq++;     // odd: update in progress
+  __DMB();
+
+  for (uint8_t ch = 0U; ch < nbChannels; ch++)
+  {
+    float *const pFrameR2   = &pWindows->pFrameR2[(uint32_t)ch   * historyFrames];
+    float *const pFramePeak = &pWindows->pFramePeak[(uint32_t)ch * historyFrames];
+    float  const r2         = pWindows->pCurR2[ch];
+    float  const peak       = pWindows->pCurPeak[ch];
+
+    for (uint32_t w = 0UL; w < pWindows->nbWindows; w++)
+    {
+      uint32_t       const windowFrames = pWindows->windowFrames[w];
+      uint32_t       const idx          = (w * (uint32_t)nbChannels) + (uint32_t)ch;
+      rmsPeakFifo_t *const pFifo        = &pWindows->pPeakFifo[idx];
+      uint32_t       const nbWinFrames  = (nbFrames < windowFrames) ? (nbFrames + 1UL) : windowFrames;
+      double               sum          = pWindows->pSum[idx];
+
+      // running sum: remove the frame leaving the window (still in history as pos isn't written yet)
+      if (nbFrames >= windowFrames)
+      {
+        uint32_t const leavingIdx = (frameIdx >= windowFrames) ? (frameIdx - windowFrames) : ((frameIdx + idxWrap) - windowFrames);
+        sum -= (double)pFrameR2[s_windows_histPos(historyFrames, leavingIdx)];
+      }
+      sum  += (double)r2;
+      sum   = (sum < 0.0) ? 0.0 : sum;
+      pWindows->pSum[idx] = sum;
+
+      // monotonic queue: drop smaller peaks from the back, expired peak from the front
+      while ((pFifo->count > 0UL) && (pFramePeak[s_windows_histPos(historyFrames, pFifo->pFrameIdx[(pFifo->head + pFifo->count - 1UL) % windowFrames])] <= peak))
+      {
+        pFifo->count--;
+      }
+      if (pFifo->count > 0UL)
+      {
+        uint32_t const headIdx = pFifo->pFrameIdx[pFifo->head];
+        uint32_t const age     = (frameIdx >= headIdx) ? (frameIdx - headIdx) : ((frameIdx + idxWrap) - headIdx);
+
+        if (age >= windowFrames)
+        {
+          pFifo->head = (pFifo->head + 1UL) % windowFrames;
+          pFifo->count--;
+        }
+      }
+      pFifo->pFrameIdx[(pFifo->head + pFifo->count) % windowFrames] = frameIdx;
+      pFifo->count++;
+
+      pLevels->rms[w][ch]  = sqrtf((float)(sum / ((double)nbWinFrames * (double)nbSamples))) / normalizer; /*cstat !MISRAC2012-Rule-22.8 no issue with sqrt of a positive value => errno check is useless*/
+      pLevels->peak[w][ch] = ((pFifo->pFrameIdx[pFifo->head] == frameIdx) ? peak : pFramePeak[s_windows_histPos(historyFrames, pFifo->pFrameIdx[pFifo->head])]) / normalizer;
+    }
+
+    pFrameR2[pos]   = r2;
+    pFramePeak[pos] = peak;
+  }
+
+  pWindows->frameIdx = ((frameIdx + 1UL) == idxWrap) ? 0UL : (frameIdx + 1UL);
+  pWindows->nbFrames = (nbFrames < historyFrames) ? (nbFrames + 1UL) : nbFrames;
+
+  __DMB();
+  pLevels->seq++;     // even: levels are consistent
+}
+
+
+/**
+* @brief  position in the frames history of a wrapped frame index
+*/
+static uint32_t s_windows_histPos(uint32_t const historyFrames, uint32_t const frameIdx)
+{
+  return (frameIdx < historyFrames) ? frameIdx : (frameIdx - historyFrames);
+}
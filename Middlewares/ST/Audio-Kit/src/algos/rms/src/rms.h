@@ -30,6 +30,9 @@ typedef struct
   uint8_t              nbChannels;
   uint32_t             fs;
   float               *pRmsValues;
+  uint32_t             nbElements;                        // frame size, sliding windows granularity
+  uint32_t             windowFrames[RMS_MAX_NB_WINDOWS];  // sliding windows length in frames, 0 means disabled
+  rmsLevels_t         *pLevels;                           // sliding windows output, NULL if no window
   void                *pInternalMem;
   size_t               internalMemSize;
 } rmsHdler_t;
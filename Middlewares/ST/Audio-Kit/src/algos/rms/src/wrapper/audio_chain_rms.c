@@ -34,6 +34,7 @@ typedef struct
 {
   rmsHdler_t          algoWrp;
   rmsCtrl_t           algoCtrl;
+  rmsLevels_t         levels;           /* sliding windows levels, read by AudioChainWrp_rms_getLevels */
   uint32_t            fs;
   uint8_t             nbChIn;           /* save in context to avoid to call AudioBuffer_getNbChannels each time in process */
   uint32_t            nbElements;       /* save in context to avoid to call AudioBuffer_getNbElements each time in process */
@@ -46,6 +47,10 @@ rms_context_t;
 /* Private defines -----------------------------------------------------------*/
 #define RMS_MEM_POOL AUDIO_MEM_RAMINT
 
+#ifndef RMS_GET_LEVELS_MAX_TRIES
+  #define RMS_GET_LEVELS_MAX_TRIES 4UL  /* copies of the levels attempted by AudioChainWrp_rms_getLevels */
+#endif
+
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -55,6 +60,7 @@ static int32_t s_rms_checkConsistency(audio_algo_t      *const pAlgo);
 static int32_t s_rms_configure(audio_algo_t             *const pAlgo);
 static int32_t s_rms_dataInOut(audio_algo_t             *const pAlgo);
 static int32_t s_rms_process(audio_algo_t               *const pAlgo);
+static void    s_rms_setWindows(rms_context_t           *const pContext, rms_stat_config_t const *const pStaticConfig);
 
 /* Global variables ----------------------------------------------------------*/
 const audio_algo_common_t AudioChainWrp_rms_common =
@@ -97,6 +103,51 @@ audio_algo_cbs_t AudioChainWrp_rms_cbs =
 };
 
 
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+* @brief  Get a consistent copy of the sliding windows levels; may be called
+*         from any task, levels are updated every frame by the process
+* @note   The copy is retried at most RMS_GET_LEVELS_MAX_TRIES times: a reader
+*         preempting the update (or preempted by it at each try) gives up
+*         instead of spinning, pLevels keeps its previous consistent copy
+* @param  pAlgo   rms algo instance
+* @param  pLevels levels copy, only written when consistent
+* @retval Error; AUDIO_ERR_MGNT_NONE if no issue, AUDIO_ERR_MGNT_NOT_DONE if no
+*         consistent copy could be made (caller keeps its previous levels)
+*/
+int32_t AudioChainWrp_rms_getLevels(audio_algo_t *const pAlgo, rmsLevels_t *const pLevels)
+{
+  int32_t              error    = AUDIO_ERR_MGNT_ERROR;
+  rms_context_t *const pContext = (rms_context_t *)AudioAlgo_getWrapperContext(pAlgo);
+
+  if ((pContext != NULL) && (pLevels != NULL) && (pContext->levels.nbWindows > 0UL))
+  {
+    rmsLevels_t levels;
+
+    error = AUDIO_ERR_MGNT_NOT_DONE;
+    for (uint32_t i = 0UL; (i < RMS_GET_LEVELS_MAX_TRIES) && (error == AUDIO_ERR_MGNT_NOT_DONE); i++)
+    {
+      uint32_t const seq = pContext->levels.seq;
+
+      if ((seq & 1UL) == 0UL)
+      {
+        __DMB();
+        memcpy(&levels, &pContext->levels, sizeof(rmsLevels_t));
+        __DMB();
+        if (seq == pContext->levels.seq)
+        {
+          memcpy(pLevels, &levels, sizeof(rmsLevels_t));
+          error = AUDIO_ERR_MGNT_NONE;
+        }
+      }
+    }
+  }
+
+  return error;
+}
+
+
 /* Private Functions Definition ------------------------------------------------------*/
 static int32_t s_rms_init(audio_algo_t *const pAlgo)
 {
@@ -148,6 +199,10 @@ static int32_t s_rms_init(audio_algo_t *const pAlgo)
     pRmsHdle->nbChannels        = pContext->nbChIn;
     pRmsHdle->audioType         = audioType;
     pRmsHdle->fs                = pContext->fs;
+    pRmsHdle->nbElements        = pContext->nbElements;
+
+    /* Set sliding windows, in frames unit */
+    s_rms_setWindows(pContext, pStaticConfig);
 
     /* Get mem for algo from given config */
     error = rmsGetMemorySize(pRmsHdle);
@@ -283,3 +338,30 @@ static int32_t s_rms_process(audio_algo_t *const pAlgo)
 }
 
 
+static void s_rms_setWindows(rms_context_t *const pContext, rms_stat_config_t const *const pStaticConfig)
+{
+  uint16_t const windowTimes[RMS_MAX_NB_WINDOWS] = {pStaticConfig->windowTime1, pStaticConfig->windowTime2, pStaticConfig->windowTime3};
+  rmsHdler_t    *const pRmsHdle                  = &pContext->algoWrp;
+  rmsLevels_t   *const pLevels                   = &pContext->levels;
+  uint32_t             nbWindows                 = 0UL;
+
+  for (uint32_t w = 0UL; w < RMS_MAX_NB_WINDOWS; w++)
+  {
+    uint32_t windowFrames = 0UL;
+
+    if (windowTimes[w] != 0U)
+    {
+      uint32_t const windowSamples = ((uint32_t)windowTimes[w] * pContext->fs) / 1000UL;
+
+      windowFrames = (windowSamples + (pContext->nbElements / 2UL)) / pContext->nbElements;
+      windowFrames = (windowFrames == 0UL) ? 1UL : windowFrames;
+      pLevels->windowSamples[nbWindows] = windowFrames * pContext->nbElements;
+      nbWindows++;
+    }
+    pRmsHdle->windowFrames[w] = windowFrames;
+  }
+
+  pLevels->nbWindows   = nbWindows;
+  pLevels->nbChannels  = (uint32_t)pContext->nbChIn;
+  pRmsHdle->pLevels    = (nbWindows > 0UL) ? pLevels : NULL;
+}
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "algos_memory_usage.h"
 #include "audio_chain_instance.h"
 #include "audio_mem_mgnt.h"
@@ -40,10 +41,38 @@
 #define AUDIO_MEM_DISABLE_IRQ disable_irq_with_cnt
 #define AUDIO_MEM_ENABLE_IRQ  enable_irq_with_cnt
 
+#define LIFETIME_PLAN_MAX_CHUNKS 64U
+
 /* Private macros ------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  audio_chunk_t *pChunk;
+  uint32_t       size;          /* bytes */
+  uint8_t        firstAlgo;     /* index of the algo writing the chunk */
+  uint8_t        lastAlgo;      /* index of the last algo reading the chunk */
+  uint8_t        nbWriters;
+  uint8_t        nbReaders;
+  bool           readBeforeWrite;
+  uint32_t       prioMask;      /* process priority levels of the algos using the chunk */
+  uint8_t        arena;
+} lifetimeChunk_t;
+
+typedef struct
+{
+  uint32_t size;
+  uint32_t prioMask;            /* process priority level of the chunks mapped on the arena */
+  uint8_t  busyUntil;           /* index of the last algo using the arena */
+} lifetimeArena_t;
+
 /* Private function prototypes -----------------------------------------------*/
+static lifetimeChunk_t *s_lifetime_getChunk(lifetimeChunk_t *const pChunks, uint16_t *const pNbChunks, audio_chunk_t *const pChunk);
+static bool             s_lifetime_isShareable(lifetimeChunk_t const *const pChunk);
+
 /* Private variables ---------------------------------------------------------*/
+static lifetimeChunk_t tLifetimeChunks[LIFETIME_PLAN_MAX_CHUNKS];  /* planChunksLifetime work tables, kept off the terminal task stack */
+static lifetimeArena_t tLifetimeArenas[LIFETIME_PLAN_MAX_CHUNKS];
+
 /* Functions Definition ------------------------------------------------------*/
 void displayDetailedAlgosMemoryUsage(bool const verbose)
 {
@@ -190,6 +219,12 @@ void displayDetailedAlgosMemoryUsage(bool const verbose)
     {
       UTIL_TERM_printf("\naudio-chain chunks:                                             %6d bytes\n", chunksTotalAllocatedAllocSize);
     }
+    if (verbose)
+    {
+      chunksLifetimePlan_t plan;
+
+      (void)planChunksLifetime(&plan, true);
+    }
 
     UTIL_TERM_printf("\naudio-chain algos:\n");
     for (audio_algo_list_t *pAlgoList = AudioChain_getAlgosList(&AudioChainInstance); pAlgoList != NULL; pAlgoList = pAlgoList->next)
@@ -322,3 +357,219 @@ void displayDetailedAlgosMemoryUsage(bool const verbose)
   }
 }
 
+
+/**
+* @brief  Plan the sharing of the chunks buffers from their lifetime during a process pass:
+*         a chunk is alive from the algo writing it to the last algo reading it (algos list order).
+*         Only user chunks are planned. Single frame user chunks whose lifetime doesn't cross a
+*         process pass and whose algos all run at the same process priority level are packed
+*         on shared arenas with an interval graph colouring (best fit on free arenas of the same
+*         priority level, as process tasks of different levels preempt each other);
+*         the other chunks keep their own allocation.
+*         The chunks buffers are owned by the audio chain, the plan is only reported.
+* @param  pPlan   returned plan summary
+* @param  verbose display the arena of each chunk
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
+*/
+int32_t planChunksLifetime(chunksLifetimePlan_t *const pPlan, bool const verbose)
+{
+  lifetimeChunk_t *const tChunks  = tLifetimeChunks;
+  lifetimeArena_t *const tArenas  = tLifetimeArenas;
+  uint16_t        nbChunks = 0U;
+  uint8_t         algoIdx  = 0U;
+  int32_t         error    = AUDIO_ERR_MGNT_NONE;
+
+  memset(pPlan, 0, sizeof(*pPlan));
+  memset(tLifetimeChunks, 0, sizeof(tLifetimeChunks));
+
+  /* lifetime of each user chunk */
+  for (audio_algo_list_t *pAlgoList = AudioChain_getAlgosList(&AudioChainInstance); (pAlgoList != NULL) && AudioError_isOk(error); pAlgoList = pAlgoList->next)
+  {
+    uint32_t const prioBit = 1UL << (uint32_t)AudioAlgo_getPrioLevel(pAlgoList->pAlgo);
+
+    for (audio_chunk_list_t *pList = AudioAlgo_getChunksIn(pAlgoList->pAlgo); (pList != NULL) && AudioError_isOk(error); pList = pList->next)
+    {
+      if (!AudioChunk_isSystem(pList->pChunk))
+      {
+        lifetimeChunk_t *const pChunk = s_lifetime_getChunk(tChunks, &nbChunks, pList->pChunk);
+
+        if (pChunk == NULL)
+        {
+          error = AUDIO_ERR_MGNT_ALLOCATION;
+        }
+        else
+        {
+          pChunk->readBeforeWrite = pChunk->readBeforeWrite || (pChunk->nbWriters == 0U);
+          pChunk->lastAlgo        = algoIdx;
+          pChunk->prioMask       |= prioBit;
+          pChunk->nbReaders++;
+        }
+      }
+    }
+    for (audio_chunk_list_t *pList = AudioAlgo_getChunksOut(pAlgoList->pAlgo); (pList != NULL) && AudioError_isOk(error); pList = pList->next)
+    {
+      if (!AudioChunk_isSystem(pList->pChunk))
+      {
+        lifetimeChunk_t *const pChunk = s_lifetime_getChunk(tChunks, &nbChunks, pList->pChunk);
+
+        if (pChunk == NULL)
+        {
+          error = AUDIO_ERR_MGNT_ALLOCATION;
+        }
+        else
+        {
+          pChunk->firstAlgo  = algoIdx;
+          pChunk->prioMask  |= prioBit;
+          pChunk->nbWriters++;
+        }
+      }
+    }
+    algoIdx++;
+  }
+
+  if (AudioError_isOk(error))
+  {
+    uint16_t nbArenas = 0U;
+
+    pPlan->nbChunks = nbChunks;
+
+    /* chunks are visited by increasing lifetime start */
+    for (uint8_t start = 0U; start < algoIdx; start++)
+    {
+      for (uint16_t i = 0U; i < nbChunks; i++)
+      {
+        lifetimeChunk_t *const pChunk = &tChunks[i];
+
+        if (s_lifetime_isShareable(pChunk) && (pChunk->firstAlgo == start))
+        {
+          uint16_t bestArena = nbArenas;
+
+          /* best fit among free arenas of the same priority level, else the largest one which is enlarged */
+          for (uint16_t arena = 0U; arena < nbArenas; arena++)
+          {
+            if ((tArenas[arena].busyUntil < start) && (tArenas[arena].prioMask == pChunk->prioMask))
+            {
+              if (bestArena == nbArenas)
+              {
+                bestArena = arena;
+              }
+              else if (tArenas[bestArena].size < pChunk->size)
+              {
+                bestArena = (tArenas[arena].size > tArenas[bestArena].size) ? arena : bestArena;
+              }
+              else if ((tArenas[arena].size >= pChunk->size) && (tArenas[arena].size < tArenas[bestArena].size))
+              {
+                bestArena = arena;
+              }
+              else
+              {
+                /* keep current best arena */
+              }
+            }
+          }
+          if (bestArena == nbArenas)
+          {
+            tArenas[bestArena].size     = 0UL;
+            tArenas[bestArena].prioMask = pChunk->prioMask;
+            nbArenas++;
+          }
+          tArenas[bestArena].size      = (pChunk->size > tArenas[bestArena].size) ? pChunk->size : tArenas[bestArena].size;
+          tArenas[bestArena].busyUntil = pChunk->lastAlgo;
+          pChunk->arena                = (uint8_t)bestArena;
+          pPlan->nbShareable++;
+        }
+      }
+    }
+
+    for (uint16_t i = 0U; i < nbChunks; i++)
+    {
+      pPlan->ramBefore += tChunks[i].size;
+      if (!s_lifetime_isShareable(&tChunks[i]))
+      {
+        pPlan->ramAfter += tChunks[i].size;
+      }
+    }
+    for (uint16_t arena = 0U; arena < nbArenas; arena++)
+    {
+      pPlan->ramAfter += tArenas[arena].size;
+    }
+    pPlan->nbArenas = nbArenas;
+
+    UTIL_TERM_printf("\naudio-chain chunks lifetime plan: %d user chunks, %d shareable on %d arenas: %6lu bytes -> %6lu bytes\n",
+                     pPlan->nbChunks, pPlan->nbShareable, pPlan->nbArenas, (unsigned long)pPlan->ramBefore, (unsigned long)pPlan->ramAfter);
+    if (verbose)
+    {
+      for (uint16_t i = 0U; i < nbChunks; i++)
+      {
+        lifetimeChunk_t const *const pChunk = &tChunks[i];
+
+        if (s_lifetime_isShareable(pChunk))
+        {
+          UTIL_TERM_printf("    %-30s: %6lu bytes, algos %2d..%2d, arena %d\n", AudioChunk_getConf(pChunk->pChunk)->pName, (unsigned long)pChunk->size, pChunk->firstAlgo, pChunk->lastAlgo, pChunk->arena);
+        }
+        else
+        {
+          UTIL_TERM_printf("    %-30s: %6lu bytes, own buffer\n", AudioChunk_getConf(pChunk->pChunk)->pName, (unsigned long)pChunk->size);
+        }
+      }
+    }
+  }
+  else
+  {
+    UTIL_TERM_printf("\naudio-chain chunks lifetime plan: more than %d chunks, not planned\n", LIFETIME_PLAN_MAX_CHUNKS);
+  }
+
+  return error;
+}
+
+
+/* Private Functions Definition ----------------------------------------------*/
+
+/**
+* @brief  Find or register a user chunk in the lifetime table
+* @param  pChunks   lifetime table
+* @param  pNbChunks number of registered chunks
+* @param  pChunk    chunk to find
+* @retval lifetime entry, NULL if table is full
+*/
+static lifetimeChunk_t *s_lifetime_getChunk(lifetimeChunk_t *const pChunks, uint16_t *const pNbChunks, audio_chunk_t *const pChunk)
+{
+  lifetimeChunk_t *pEntry = NULL;
+
+  for (uint16_t i = 0U; (i < *pNbChunks) && (pEntry == NULL); i++)
+  {
+    if (pChunks[i].pChunk == pChunk)
+    {
+      pEntry = &pChunks[i];
+    }
+  }
+  if ((pEntry == NULL) && (*pNbChunks < LIFETIME_PLAN_MAX_CHUNKS))
+  {
+    audio_chunk_conf_t const *const pConf = AudioChunk_getConf(pChunk);
+
+    pEntry         = &pChunks[*pNbChunks];
+    pEntry->pChunk = pChunk;
+    pEntry->size   = AudioBuffer_getBufferSize(AudioChunk_getBuffInfo(pChunk)) * (uint32_t)pConf->nbFrames;
+    (*pNbChunks)++;
+  }
+
+  return pEntry;
+}
+
+
+/**
+* @brief  A chunk can share its buffer if it is a single frame user chunk
+*         written once and read only later in the same process pass, by algos
+*         of a single process priority level
+* @param  pChunk lifetime entry
+* @retval true if shareable
+*/
+static bool s_lifetime_isShareable(lifetimeChunk_t const *const pChunk)
+{
+  return !AudioChunk_isSystem(pChunk->pChunk)                  &&
+         (AudioChunk_getConf(pChunk->pChunk)->nbFrames == 1U)   &&
+         ((pChunk->prioMask & (pChunk->prioMask - 1UL)) == 0UL) &&
+         (pChunk->nbWriters == 1U)                             &&
+         (pChunk->nbReaders > 0U)                              &&
+         !pChunk->readBeforeWrite;
+}
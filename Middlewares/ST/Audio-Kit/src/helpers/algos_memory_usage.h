@@ -23,13 +23,24 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported structures--------------------------------------------------------*/
+typedef struct
+{
+  uint16_t nbChunks;      /* user chunks of the graph */
+  uint16_t nbShareable;   /* single frame chunks written and fully read during the same process pass of one priority level */
+  uint16_t nbArenas;      /* shared arenas needed by the shareable chunks */
+  uint32_t ramBefore;     /* bytes, one allocation per chunk */
+  uint32_t ramAfter;      /* bytes, shareable chunks mapped on the arenas */
+} chunksLifetimePlan_t;
+
 /* Exported variables ------------------------------------------------------- */
 /* Exported functions ------------------------------------------------------- */
-void displayDetailedAlgosMemoryUsage(bool const verbose);
+void    displayDetailedAlgosMemoryUsage(bool const verbose);
+int32_t planChunksLifetime(chunksLifetimePlan_t *const pPlan, bool const verbose);
 
 #endif /* __ALGOS_MEMORY_USAGE_H */
 
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "audio_chain_instance.h"
 #include "audio_chain_sysIOs.h"
@@ -34,8 +35,88 @@
 audio_chain_t AudioChainInstance;
 
 /* Private defines -----------------------------------------------------------*/
+#define AC_TYPE_PLAN_MAX_CHUNKS        64U  /* user chunks handled by the sample format planner */
+#define AC_TYPE_PLAN_NB_TYPES          3U   /* fixed16, fixed32, float */
+#define AC_TYPE_PLAN_CYCLES_PER_SAMPLE 6UL  /* estimated cost of one sfc sample conversion (load, convert, scale, store) */
+#define AC_IN_PLACE_MAX_CHUNKS         16U  /* output chunks which can share their input chunk buffer */
+#define AC_SWAP_FADE_RUNS              8UL  /* audio runs of the fade-out before & fade-in after a graph swap */
+#define AC_PLACEMENT_MAX_ALGOS         32U  /* algos handled by the process priority placement */
+
 /* Private macros ------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  audio_chunk_t      *pChunk;
+  audio_chunk_conf_t *pConf;
+  uint8_t             parent;                               /* union-find parent: chunks whose type is tied by an algo */
+  uint8_t             curT;                                 /* group type before optimization, set on group roots */
+  uint8_t             bestT;                                /* group type selected by the optimization, set on group roots */
+  uint32_t            typeMask;                             /* AUDIO_CAPABILITY_TYPE_xxx accepted by all connected algos */
+  uint32_t            nbConv[AC_TYPE_PLAN_NB_TYPES];        /* sfc conversions required for each candidate type */
+  uint32_t            nbConvSamples[AC_TYPE_PLAN_NB_TYPES]; /* samples converted per frame for each candidate type */
+} audio_chain_instance_type_plan_t;
+
+typedef struct
+{
+  char const          *pName;
+  audio_buffer_type_t  nativeType;
+} audio_chain_instance_native_type_t;
+
+typedef enum
+{
+  AC_SWAP_IDLE,
+  AC_SWAP_FADE_OUT,                                         /* old graph still running, system outputs ramped down */
+  AC_SWAP_MUTED,                                            /* system outputs zeroed, graph rebuilt by AudioChainInstance_idle */
+  AC_SWAP_FADE_IN                                           /* new graph running, system outputs ramped up */
+} audio_chain_instance_swap_state_t;
+
+typedef struct
+{
+  audio_chain_instance_swap_state_t volatile state;
+  uint32_t                          volatile nbRuns;        /* audio runs spent in the current state */
+  bool                              volatile bStatsReady;
+  void                                     (*pInitGraphCb)(void);
+  uint64_t                                   requestMs;
+  uint64_t                                   mutedMs;
+  audio_chain_instance_swap_stats_t          stats;
+} audio_chain_instance_swap_t;
+
+typedef enum
+{
+  AC_BOOT_IDLE,
+  AC_BOOT_WAIT_FIRST_RUN,                                   /* graph being built, first audio run not reached yet */
+  AC_BOOT_DONE                                              /* boot stats measured */
+} audio_chain_instance_boot_state_t;
+
+typedef struct
+{
+  audio_chain_instance_boot_state_t volatile state;
+  bool                                       bReported;     /* boot stats traced by AudioChainInstance_idle */
+  uint32_t                                   startCycles;
+  audio_chain_instance_boot_stats_t          stats;
+} audio_chain_instance_boot_t;
+
+typedef struct
+{
+  audio_chunk_t *pChunk;                                    /* output chunk sharing the buffer of its algo input chunk */
+  void          *pData;                                     /* buffer allocated for this chunk, restored before graph deinit */
+} audio_chain_instance_in_place_t;
+
+typedef struct
+{
+  char                 const *pName;
+  audio_algo_common_t         lowCommon;                    /* copy of the wrapper capabilities with the low prio level */
+  audio_algo_factory_t        lowFactory;                   /* copy of the wrapper factory bound to lowCommon */
+} audio_chain_instance_placeable_t;
+
+typedef struct
+{
+  audio_algo_t *tAlgos[AC_PLACEMENT_MAX_ALGOS];
+  bool          bCritical[AC_PLACEMENT_MAX_ALGOS];          /* a system output chunk depends on the algo outputs */
+  bool          bLow[AC_PLACEMENT_MAX_ALGOS];               /* placeable consumer off the critical path */
+  uint8_t       nbAlgos;
+} audio_chain_instance_placement_ctx_t;
+
 typedef struct audio_chain_instance_env_data_t
 {
   uint8_t      iChunkMemoryPool;
@@ -46,6 +127,9 @@ typedef struct audio_chain_instance_env_data_t
   uint8_t      bLogCmsisOs;
   uint8_t      bLogCycles;
   uint8_t      bDefaultCycleCountMngtCb;
+  uint8_t      bOptimChunksType;
+  uint8_t      bInPlaceChunks;
+  uint8_t      bAutoPrioPlacement;
   uint32_t     iCycleCountCbTimeout;
   uint32_t     iCycleCountMeasureTimeout;
 } audio_chain_instance_env_data_t;
@@ -76,9 +160,39 @@ static int32_t s_envCb_setAlgoMemPool(audio_algo_t              *const pNull, vo
 static int32_t s_envCb_getAlgoMemPool(audio_algo_t              *const pNull, void **const pData);
 static int32_t s_envCb_setTuning(audio_algo_t                   *const pNull, void  *const arg);
 static int32_t s_envCb_getTuning(audio_algo_t                   *const pNull, void **const pData);
+static int32_t s_envCb_setOptimChunksType(audio_algo_t          *const pNull, void  *const arg);
+static int32_t s_envCb_getOptimChunksType(audio_algo_t          *const pNull, void **const pData);
+static int32_t s_envCb_setInPlaceChunks(audio_algo_t            *const pNull, void  *const arg);
+static int32_t s_envCb_getInPlaceChunks(audio_algo_t            *const pNull, void **const pData);
+static int32_t s_envCb_setAutoPrioPlacement(audio_algo_t        *const pNull, void  *const arg);
+static int32_t s_envCb_getAutoPrioPlacement(audio_algo_t        *const pNull, void **const pData);
 static int32_t s_envCb_initIssueMsgCb(audio_algo_t              *const pNull, void  *const arg);
 static int32_t s_envCb_updateCfgMsgCb(audio_algo_t              *const pNull, void  *const arg);
 static void    s_trace(const char                               *pFormat, ...);
+static uint8_t s_typePlan_find(audio_chain_instance_type_plan_t *const pPlan, uint8_t const id);
+static uint8_t s_typePlan_getId(audio_chain_instance_type_plan_t const *const pPlan, uint8_t const nbChunks, audio_chunk_t const *const pChunk);
+static uint8_t s_typePlan_addChunk(audio_chain_instance_type_plan_t *const pPlan, uint8_t *const pNbChunks, audio_chunk_t *const pChunk);
+static void    s_typePlan_join(audio_chain_instance_type_plan_t *const pPlan, uint8_t const nbChunks, audio_chunk_list_t *pList, audio_chunk_list_t *pList2);
+static void    s_typePlan_addEndPoints(audio_chain_instance_type_plan_t *const pPlan, uint8_t const nbChunks, audio_chunk_list_t *pList, uint32_t const typeMask, audio_buffer_type_t const nativeType);
+static audio_buffer_type_t s_typePlan_getNativeType(audio_algo_common_t const *const pCapabilities);
+static void    s_swap_applyRamp(void);
+static void    s_swap_rampBuffer(audio_buffer_t const *const pBuff, float const gainStart, float const gainEnd);
+static void    s_swap_rebuild(void);
+static uint32_t s_swap_getGraphRam(void);
+static uint32_t s_cyclesToUs(uint32_t const cycles);
+static audio_chunk_t *s_staticGraph_getChunk(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const chunkId);
+static int32_t s_staticGraph_createAlgo(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const algoId, CycleStatsCb_t *const pCycleCount);
+static int32_t s_staticGraph_start(void);
+static void    s_staticGraph_place(audio_chain_instance_static_graph_t const *const pGraph);
+static bool    s_staticGraph_feedsCritical(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const chunkId);
+static void    s_inPlace_scanChunk(audio_chain_t *const pHdle, audio_chunk_t const *const pChunk, uint8_t *const pNbReaders, uint8_t *const pNbWriters, uint32_t *const pPrioMask);
+static bool    s_inPlace_isCandidate(audio_chain_t *const pHdle, audio_algo_t *const pAlgo, audio_chunk_t **const ppChunkIn, audio_chunk_t **const ppChunkOut);
+static bool    s_placement_feedsCritical(audio_algo_t *const pAlgo);
+static int8_t  s_placement_findAlgo(audio_algo_t const *const pAlgo);
+static audio_chain_instance_placeable_t *s_placement_findPlaceable(audio_algo_factory_t const *const pFactory);
+static audio_algo_factory_t const *s_placement_getFactory(audio_algo_factory_t const *const pFactory, uint8_t const algoId);
+static void    s_placement_trace(audio_chain_t *const pHdle, bool const bApplied);
+static uint32_t s_placement_maxUs(CycleStatsTypeDef const *const pStats);
 
 
 /* Private variables ---------------------------------------------------------*/
@@ -93,10 +207,52 @@ static audio_chain_instance_env_data_t gEnvData =
   .bLogCmsisOs               = 0U,
   .bLogCycles                = 0U,
   .bDefaultCycleCountMngtCb  = 0U,
+  .bOptimChunksType          = 0U,
+  .bInPlaceChunks            = 0U,
+  .bAutoPrioPlacement        = 0U,
   .iCycleCountCbTimeout      = 5000UL,
   .iCycleCountMeasureTimeout = 500UL
 };
 
+static audio_chain_instance_in_place_t tInPlace[AC_IN_PLACE_MAX_CHUNKS];
+static uint8_t                         nbInPlace = 0U;
+
+static audio_chain_instance_swap_t     swapCtx;
+
+static audio_chain_instance_boot_t     bootCtx;
+
+static audio_chain_instance_placement_ctx_t placementCtx;
+
+static audio_chain_instance_type_plan_t tTypePlan[AC_TYPE_PLAN_MAX_CHUNKS];   /* kept off the caller task stack */
+
+/* Consumers whose process can be deferred to the low priority pass without delaying the system outputs:
+   they only observe the audio (meters, analyzers, recorders) */
+static audio_chain_instance_placeable_t tPlaceable[] =
+{
+  {.pName = "rms"},
+  {.pName = "spectrum"},
+  {.pName = "capture"},
+  {.pName = NULL}
+};
+
+/* Algos whose processing runs internally in a given sample format whatever their chunks format:
+   every chunk of another format costs them an sfc conversion in and/or out.
+   Other algos either have native per-format implementations or fold the conversion into their single pass. */
+static const audio_chain_instance_native_type_t tNativeTypes[] =
+{
+  {"echo",                  ABUFF_FORMAT_FLOAT},
+  {"nlms",                  ABUFF_FORMAT_FLOAT},
+  {"resample",              ABUFF_FORMAT_FLOAT},
+  {"faust-compressor",      ABUFF_FORMAT_FLOAT},
+  {"faust-distortion",      ABUFF_FORMAT_FLOAT},
+  {"faust-chorus",          ABUFF_FORMAT_FLOAT},
+  {"faust-reverb-dattorro", ABUFF_FORMAT_FLOAT},
+  {"faust-noise-gate",      ABUFF_FORMAT_FLOAT},
+  {"faust-flanger",         ABUFF_FORMAT_FLOAT},
+  {"faust-phaser",          ABUFF_FORMAT_FLOAT},
+  {NULL,                    ABUFF_FORMAT_UNKNOWN}
+};
+
 static const audio_descriptor_key_value_t tTraceLevelType[] =
 {
   {"debug",   TRACE_LVL_DEBUG},
@@ -199,6 +355,30 @@ static const audio_algo_descriptor_t tEnvParams[] =
     .set_cb          = s_envCb_setCyclesMngtMeasureTimeout,
     .get_cb          = s_envCb_getCyclesMngtMeasureTimeout
   },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Before the pipe start, retype user chunks (fixed16/fixed32/float) to remove the sample format conversions done inside algos; the conversions removed and the estimated cycles saved are logged."),
+    .pExpectedValue  = AUDIO_ALGO_OPT_STR("uint32_t : AC_TRUE or AC_FALSE, default is AC_FALSE"),
+    .pName           = "bOptimChunksType",
+    .paramType       = AUDIO_DESC_PARAM_TYPE_UINT32,
+    .set_cb          = s_envCb_setOptimChunksType,
+    .get_cb          = s_envCb_getOptimChunksType
+  },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Before the pipe start, let the output chunk of in-place capable algos share the buffer of their input chunk when the topology allows it, avoiding the copy of copying algos (the chunks RAM is not reduced); the chunks aliased and the copies avoided are logged."),
+    .pExpectedValue  = AUDIO_ALGO_OPT_STR("uint32_t : AC_TRUE or AC_FALSE, default is AC_FALSE"),
+    .pName           = "bInPlaceChunks",
+    .paramType       = AUDIO_DESC_PARAM_TYPE_UINT32,
+    .set_cb          = s_envCb_setInPlaceChunks,
+    .get_cb          = s_envCb_getInPlaceChunks
+  },
+  {
+    .pDescription    = AUDIO_ALGO_OPT_STR("Before the pipe start, move the consumer algos (rms, spectrum, capture) which don't feed a system output to the low priority process pass (static graphs only: acSdk graphs keep the wrapper prio levels); the placement and the paths worst-case latencies are logged."),
+    .pExpectedValue  = AUDIO_ALGO_OPT_STR("uint32_t : AC_TRUE or AC_FALSE, default is AC_FALSE"),
+    .pName           = "bAutoPrioPlacement",
+    .paramType       = AUDIO_DESC_PARAM_TYPE_UINT32,
+    .set_cb          = s_envCb_setAutoPrioPlacement,
+    .get_cb          = s_envCb_getAutoPrioPlacement
+  },
   {
     .pDescription    = AUDIO_ALGO_OPT_STR("This callback will be called during the pipe initialization, when an issue is detected"),
     .pExpectedValue  = AUDIO_ALGO_OPT_STR("A callback pointer typedef void (*)(const char *const pMsg), this string format is [errorType]:[instance]:[comment]"),
@@ -288,6 +468,10 @@ void AudioChainInstance_init(audio_chain_instance_params_t *const pParams)
 
   // set frame duration and run duration
   AudioChain_setFrameAndRunDurations(&AudioChainInstance, (1000000UL / AC_N_MS_DIV) * AC_FRAME_MS, (1000000UL / AC_N_MS_DIV) * AC_N_MS_PER_RUN);
+  #if defined(AUDIO_CHAIN_TASKS_OS_USED) || defined(AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER)
+  // each process frame must be completed before next run
+  AudioChain_task_setDeadline((1000000UL / AC_N_MS_DIV) * AC_N_MS_PER_RUN);
+  #endif
 
   // set max cpu load during reinit (must be called after AudioChain_setFrameAndRunDurations())
   AudioChain_setMaxReinitLoadPcent(&AudioChainInstance, 10U); // algo's reinit cpu load mustn't exceed 10%
@@ -344,11 +528,24 @@ void AudioChainInstance_idle(void)
     AudioChainInstance_deinitTuning();
     AudioChainInstance_deinitGraph();
   }
+  if (swapCtx.state == AC_SWAP_MUTED)
+  {
+    s_swap_rebuild();
+  }
+  if ((bootCtx.state == AC_BOOT_DONE) && !bootCtx.bReported)
+  {
+    bootCtx.bReported = true;
+    AudioChain_trace(&AudioChainInstance, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "boot (%s graph): build %lu us, first sample %lu us",
+                     bootCtx.stats.bStaticGraph ? "static" : "acSdk",
+                     bootCtx.stats.buildUs,
+                     bootCtx.stats.firstSampleUs);
+  }
 }
 
 
 void AudioChainInstance_deinitGraph(void)
 {
+  AudioChainInstance_resetPlacement();
   if (AudioError_isError(AudioChain_deinitGraph(&AudioChainInstance)))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_deinitGraph error");
@@ -409,188 +606,787 @@ uint64_t AudioChainInstance_getNbMsFromStart(void)
 
 void AudioChainInstance_run(void)
 {
-  AudioChain_run(&AudioChainInstance);
+  /* while a swap is muted, AudioChainInstance_idle deinits & rebuilds the graph: it must not be run meanwhile;
+     the system outputs are still zeroed by s_swap_applyRamp */
+  if (swapCtx.state != AC_SWAP_MUTED)
+  {
+    AudioChain_run(&AudioChainInstance);
+  }
+  if (swapCtx.state != AC_SWAP_IDLE)
+  {
+    s_swap_applyRamp();
+  }
+  if ((bootCtx.state == AC_BOOT_WAIT_FIRST_RUN) && AudioChainInstance_isStarted())
+  {
+    bootCtx.stats.firstSampleUs = s_cyclesToUs(cycleMeasure_currentCycles() - bootCtx.startCycles);
+    bootCtx.state               = AC_BOOT_DONE;
+  }
 }
 
 
-void AudioChainInstance_error(const char *pFile, int const line, const char *pErrorMsg)
+/**
+* @brief  Request to replace the running graph by the one built by pInitGraphCb.
+*         The system outputs of the running graph are faded out during
+*         AC_SWAP_FADE_RUNS audio runs, then AudioChainInstance_idle (low priority
+*         context) deinits the old graph and calls pInitGraphCb while the outputs
+*         are kept muted and the graph isn't run by AudioChainInstance_run, and
+*         the new graph outputs are faded in.
+*         The graph only exists once in the audio chain: the swap is done at a
+*         frame boundary with a short silence instead of a click or a drop of
+*         stale samples; its duration is measured (see AudioChainInstance_getSwapGraphStats).
+* @param  pInitGraphCb routine building & starting the new graph (same job as AudioChainInstance_initGraph)
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error, AUDIO_ERR_MGNT_ERROR if a swap is already pending
+*/
+int32_t AudioChainInstance_swapGraphRequest(void (*const pInitGraphCb)(void))
 {
-  AudioChain_error(&AudioChainInstance, pFile, line, pErrorMsg);
+  int32_t error = AUDIO_ERR_MGNT_NONE;
+
+  if ((pInitGraphCb == NULL) || (swapCtx.state != AC_SWAP_IDLE))
+  {
+    error = AUDIO_ERR_MGNT_ERROR;
+  }
+  else
+  {
+    memset(&swapCtx.stats, 0, sizeof(swapCtx.stats));
+    swapCtx.stats.oldGraphRam = s_swap_getGraphRam();
+    swapCtx.stats.peakRam     = swapCtx.stats.oldGraphRam;
+    swapCtx.pInitGraphCb      = pInitGraphCb;
+    swapCtx.requestMs         = AudioChainInstance_getNbMsFromStart();
+    swapCtx.mutedMs           = swapCtx.requestMs;
+    swapCtx.bStatsReady       = false;
+    swapCtx.nbRuns            = 0UL;
+    /* nothing to fade out if no graph is running */
+    swapCtx.state             = AudioChainInstance_isStarted() ? AC_SWAP_FADE_OUT : AC_SWAP_MUTED;
+  }
+
+  return error;
 }
 
 
-int32_t AudioChainInstance_getChunkAlgoOut(audio_chunk_t *const pChunk, uint8_t *const pAlgoId, uint8_t *const pChunkId)
+bool AudioChainInstance_isSwapGraphPending(void)
 {
-  audio_algo_t *pAlgo = NULL;
-  int32_t       error = AudioChain_getChunkAlgoOut(&AudioChainInstance, pChunk, &pAlgo, pChunkId);
+  return (swapCtx.state != AC_SWAP_IDLE);
+}
 
-  if (AudioError_isOk(error))
+
+/**
+* @brief  Get the measures of the last completed graph swap
+* @param  pStats measures
+* @retval true if a swap completed since the last request
+*/
+bool AudioChainInstance_getSwapGraphStats(audio_chain_instance_swap_stats_t *const pStats)
+{
+  bool const bStatsReady = swapCtx.bStatsReady;
+
+  if (bStatsReady)
   {
-    *pAlgoId = AudioAlgo_getIndex(pAlgo);
+    *pStats = swapCtx.stats;
   }
 
-  return error;
+  return bStatsReady;
 }
 
 
-int32_t AudioChainInstance_getChunkAlgoIn(audio_chunk_t *const pChunk, uint8_t *const pAlgoId, uint8_t *const pChunkId)
+/**
+* @brief  Build the graph from a statically initialized description (see livetune_generate.c):
+*         algo factories, chunk configurations and algo configurations are pre-resolved,
+*         so there is no factory name lookup nor string parameter parsing as with acSdk.
+*         Except for the descriptor tables pointers, it does the same job as the acSdk
+*         sequence acPipeCreate, acChunkCreate, acAlgoCreate, acPipeConnectPinIn/Out and acPipePlay.
+* @param  pGraph graph description; handles & configs RAM are provided by the description
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
+*/
+int32_t AudioChainInstance_initStaticGraph(audio_chain_instance_static_graph_t const *const pGraph)
 {
-  audio_algo_t *pAlgo = NULL;
-  int32_t       error = AudioChain_getChunkAlgoIn(&AudioChainInstance, pChunk, &pAlgo, pChunkId);
+  audio_chain_utilities_t *const pUtils      = AudioChain_getUtilsHdle(&AudioChainInstance);
+  CycleStatsCb_t                *pCycleCount = NULL;
+  int32_t                        error       = AUDIO_ERR_MGNT_NONE;
+
+  bootCtx.stats.bStaticGraph = true;
+
+  if ((gEnvData.bLogCycles != 0U) && (gEnvData.bDefaultCycleCountMngtCb != 0U))
+  {
+    pCycleCount = cycleMeasure_displayCpuLoadOnUart;
+  }
+
+  /* user chunks: same as AudioChunk_create without the default config strings parsing */
+  for (uint8_t chunkId = 0U; AudioError_isOk(error) && (chunkId < pGraph->nbChunks); chunkId++)
+  {
+    audio_chain_instance_static_chunk_t const *const pDescr = &pGraph->pChunksDescr[chunkId];
+
+    if (pDescr->sysType == (uint8_t)AC_STATIC_CHUNK_USER)
+    {
+      audio_chunk_t *const pChunk = &pGraph->pChunks[chunkId];
+
+      memset(pChunk, 0, sizeof(audio_chunk_t));
+      error = AudioChunk_init(pChunk, pDescr->pName, pUtils, pGraph->chunkMemPool);
+      if (AudioError_isOk(error))
+      {
+        audio_chunk_conf_t *const pConf = AudioChunk_getConf(pChunk);
+        char const         *const pName = pConf->pName;
+
+        *pConf       = pDescr->conf;
+        pConf->pName = pName;
+      }
+    }
+    else if (s_staticGraph_getChunk(pGraph, chunkId) == NULL)
+    {
+      error = AUDIO_ERR_MGNT_NOT_FOUND;
+    }
+    else
+    {
+      /* system chunk already created by AudioChainSysIOs */
+    }
+  }
+
+  if (gEnvData.bAutoPrioPlacement != 0U)
+  {
+    s_staticGraph_place(pGraph);
+  }
+  for (uint8_t algoId = 0U; AudioError_isOk(error) && (algoId < pGraph->nbAlgos); algoId++)
+  {
+    error = s_staticGraph_createAlgo(pGraph, algoId, pCycleCount);
+  }
+
+  for (uint8_t cnxId = 0U; AudioError_isOk(error) && (cnxId < pGraph->nbCnx); cnxId++)
+  {
+    audio_chain_instance_static_cnx_t const *const pCnx   = &pGraph->pCnx[cnxId];
+    audio_algo_t                            *const pAlgo  = &pGraph->pAlgos[pCnx->algoId];
+    audio_chunk_t                           *const pChunk = s_staticGraph_getChunk(pGraph, pCnx->chunkId);
+
+    if (pCnx->bOut != 0U)
+    {
+      error = AudioAlgo_addOutput(pAlgo, pChunk);
+    }
+    else
+    {
+      error = AudioAlgo_setInput(pAlgo, pChunk, (int)pCnx->pinId);
+    }
+  }
 
   if (AudioError_isOk(error))
   {
-    *pAlgoId = AudioAlgo_getIndex(pAlgo);
+    AudioChain_setDataInOutTaskCycleMgntCbTimeout(&AudioChainInstance,       pCycleCount, gEnvData.iCycleCountMeasureTimeout, gEnvData.iCycleCountCbTimeout);
+    AudioChain_setProcessTaskCycleMgntCbTimeout(&AudioChainInstance,         pCycleCount, gEnvData.iCycleCountMeasureTimeout, gEnvData.iCycleCountCbTimeout);
+    AudioChain_setProcessLowLevelTaskCycleMgntCbTimeout(&AudioChainInstance, pCycleCount, gEnvData.iCycleCountMeasureTimeout, gEnvData.iCycleCountCbTimeout);
+    AudioChain_setControlTaskCycleMgntCbTimeout(&AudioChainInstance,         pCycleCount, gEnvData.iCycleCountMeasureTimeout, gEnvData.iCycleCountCbTimeout);
+    error = s_staticGraph_start();
   }
 
   return error;
 }
 
 
-bool AudioChainInstance_setEnableCyclesCnt(bool const enable)
+/**
+* @brief  Start the measure of the boot-to-first-sample time, to be called right before AudioChainInstance_initGraph.
+*         The first audio run of the started graph ends the measure, which is traced from AudioChainInstance_idle.
+*/
+void AudioChainInstance_bootStart(void)
 {
-  return AudioChain_setEnableCyclesCnt(&AudioChainInstance, enable);
+  bootCtx.state     = AC_BOOT_IDLE;
+  bootCtx.bReported = false;
+  memset(&bootCtx.stats, 0, sizeof(bootCtx.stats));
+  bootCtx.startCycles = cycleMeasure_currentCycles();
+  bootCtx.state       = AC_BOOT_WAIT_FIRST_RUN;
 }
 
 
-bool AudioChainInstance_getCyclesCntStatus(void)
+/**
+* @brief  Record the graph build duration, to be called right after AudioChainInstance_initGraph
+*/
+void AudioChainInstance_bootGraphBuilt(void)
 {
-  return AudioChain_getCyclesCntStatus(&AudioChainInstance);
+  bootCtx.stats.buildUs = s_cyclesToUs(cycleMeasure_currentCycles() - bootCtx.startCycles);
 }
 
 
-bool AudioChainInstance_setEnableTraces(bool const enable)
+/**
+* @brief  Get the boot measures of the current graph
+* @param  pStats stats filled if available
+* @retval true if the first audio run has been reached
+*/
+bool AudioChainInstance_getBootStats(audio_chain_instance_boot_stats_t *const pStats)
 {
-  return AudioChain_setEnableTraces(&AudioChainInstance, enable);
-}
+  bool const bStatsReady = (bootCtx.state == AC_BOOT_DONE);
 
+  if (bStatsReady)
+  {
+    *pStats = bootCtx.stats;
+  }
 
-bool AudioChainInstance_getTracesStatus(void)
-{
-  return AudioChain_getTracesStatus(&AudioChainInstance);
+  return bStatsReady;
 }
 
 
-uint32_t AudioChainInstance_getCycleCountMeasureTimeout(void)
+void AudioChainInstance_error(const char *pFile, int const line, const char *pErrorMsg)
 {
-  return gEnvData.iCycleCountMeasureTimeout;
+  AudioChain_error(&AudioChainInstance, pFile, line, pErrorMsg);
 }
 
 
-uint32_t AudioChainInstance_getCycleCountCbTimeout(void)
+int32_t AudioChainInstance_getChunkAlgoOut(audio_chunk_t *const pChunk, uint8_t *const pAlgoId, uint8_t *const pChunkId)
 {
-  return gEnvData.iCycleCountCbTimeout;
-}
+  audio_algo_t *pAlgo = NULL;
+  int32_t       error = AudioChain_getChunkAlgoOut(&AudioChainInstance, pChunk, &pAlgo, pChunkId);
 
+  if (AudioError_isOk(error))
+  {
+    *pAlgoId = AudioAlgo_getIndex(pAlgo);
+  }
 
-int32_t AudioChainInstance_dumpFactoryEntry(void)
-{
-  return AudioChain_dumpFactoryEntry(&AudioChainInstance);
+  return error;
 }
 
 
-/**
-* @brief  Set an environment configuration
-*/
-int32_t AudioChainInstance_setEnvDescriptors(const char *pKey, uint32_t value)
+int32_t AudioChainInstance_getChunkAlgoIn(audio_chunk_t *const pChunk, uint8_t *const pAlgoId, uint8_t *const pChunkId)
 {
-  int32_t  error = AUDIO_ERR_MGNT_ERROR;
-  if (pKey != NULL)
+  audio_algo_t *pAlgo = NULL;
+  int32_t       error = AudioChain_getChunkAlgoIn(&AudioChainInstance, pChunk, &pAlgo, pChunkId);
+
+  if (AudioError_isOk(error))
   {
-    error  = AudioAlgo_setCommonDescConfig(NULL, tEnvParams, pKey, (void *)value);  /*cstat !MISRAC2012-Rule-11.6 cast to pointer because it's the API*/
+    *pAlgoId = AudioAlgo_getIndex(pAlgo);
   }
+
   return error;
 }
 
 
-
 /**
-* @brief  Set an environment configuration
+* @brief  Choose the sample format of the user chunks so that the number of
+*         sample format conversions (sfc) done inside the algos is minimal.
+*         Chunks tied by an algo type consistency are retyped together, a type is
+*         only selected if every connected algo supports it and if it removes
+*         at least one conversion; the original type is kept otherwise.
+*         Must be called before AudioChain_configPendingChunks.
+* @param  pHdle audio chain handle
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
 */
-int32_t AudioChainInstance_dumpEnvDescriptors(void)
+int32_t AudioChainInstance_optimizeChunksType(audio_chain_t *const pHdle)
 {
-  const audio_algo_descriptor_t  *pCommonDesc = tEnvParams;
-  while (pCommonDesc->pName)
+  audio_chain_instance_type_plan_t *const tPlan = tTypePlan;
+  audio_algo_list_t                *pAlgoList;
+  uint8_t                           nbChunks         = 0U;
+  uint32_t                          nbConvRemoved    = 0UL;
+  uint32_t                          nbCyclesSaved    = 0UL;
+  int32_t                           chunksRamDelta   = 0L;
+  int32_t                           error            = AUDIO_ERR_MGNT_NONE;
+
+  memset(tTypePlan, 0, sizeof(tTypePlan));
+
+  /* register user chunks & tie the ones which must share the same type */
+  for (pAlgoList = AudioChain_getAlgosList(pHdle); pAlgoList != NULL; pAlgoList = pAlgoList->next)
   {
-    s_trace("%-29s : %-20s\n", "Name",  pCommonDesc->pName);
-    s_trace("\t%-21s : %-14s\n", "Description",  pCommonDesc->pDescription);
-    s_trace("\t%-21s : %-14s\n", "Expected Value",  pCommonDesc->pExpectedValue);
-    pCommonDesc++;
+    audio_algo_factory_t const *const pFactory = AudioAlgo_getFactory(pAlgoList->pAlgo);
+    audio_chunk_list_t               *pChunksIn  = AudioAlgo_getChunksIn(pAlgoList->pAlgo);
+    audio_chunk_list_t               *pChunksOut = AudioAlgo_getChunksOut(pAlgoList->pAlgo);
+
+    for (audio_chunk_list_t *pList = pChunksIn; pList != NULL; pList = pList->next)
+    {
+      (void)s_typePlan_addChunk(tPlan, &nbChunks, pList->pChunk);
+    }
+    for (audio_chunk_list_t *pList = pChunksOut; pList != NULL; pList = pList->next)
+    {
+      (void)s_typePlan_addChunk(tPlan, &nbChunks, pList->pChunk);
+    }
+
+    if ((pFactory != NULL) && (pFactory->pCapabilities != NULL))
+    {
+      audio_capability_chunk_consistency_t const *const pConsistency = &pFactory->pCapabilities->chunks_consistency;
+
+      if (((uint32_t)pConsistency->in_out & (uint32_t)ABUFF_PARAM_TYPE) != 0UL)
+      {
+        s_typePlan_join(tPlan, nbChunks, pChunksIn, pChunksOut);
+      }
+      if (((uint32_t)pConsistency->in & (uint32_t)ABUFF_PARAM_TYPE) != 0UL)
+      {
+        s_typePlan_join(tPlan, nbChunks, pChunksIn, NULL);
+      }
+      if (((uint32_t)pConsistency->out & (uint32_t)ABUFF_PARAM_TYPE) != 0UL)
+      {
+        s_typePlan_join(tPlan, nbChunks, pChunksOut, NULL);
+      }
+    }
   }
-  return AUDIO_ERR_MGNT_NONE;
-}
 
+  /* accumulate supported types and conversion costs per chunk */
+  for (pAlgoList = AudioChain_getAlgosList(pHdle); pAlgoList != NULL; pAlgoList = pAlgoList->next)
+  {
+    audio_algo_factory_t const *const pFactory = AudioAlgo_getFactory(pAlgoList->pAlgo);
 
+    if ((pFactory != NULL) && (pFactory->pCapabilities != NULL))
+    {
+      audio_algo_common_t const *const pCapabilities = pFactory->pCapabilities;
+      audio_buffer_type_t        const nativeType    = s_typePlan_getNativeType(pCapabilities);
 
-/**
-* @brief  Get an environment configuration
-*         Documented in the header
-*/
-int32_t AudioChainInstance_getEnvConfig(const char *pKey, void *pParam)
-{
-  int32_t  error = AUDIO_ERR_MGNT_ERROR;
-  if ((pKey != NULL) && (pParam != NULL))
+      s_typePlan_addEndPoints(tPlan, nbChunks, AudioAlgo_getChunksIn(pAlgoList->pAlgo),  (uint32_t)pCapabilities->iosIn.type,  nativeType);
+      s_typePlan_addEndPoints(tPlan, nbChunks, AudioAlgo_getChunksOut(pAlgoList->pAlgo), (uint32_t)pCapabilities->iosOut.type, nativeType);
+    }
+  }
+
+  /* gather costs on group roots */
+  for (uint8_t i = 0U; i < nbChunks; i++)
   {
-    error = AudioChainFactory_getAlgoCommonDescConfig(NULL, tEnvParams, pKey, pParam);
+    uint8_t const root = s_typePlan_find(tPlan, i);
+    if (root != i)
+    {
+      tPlan[root].typeMask &= tPlan[i].typeMask;
+      for (uint8_t t = 0U; t < AC_TYPE_PLAN_NB_TYPES; t++)
+      {
+        tPlan[root].nbConv[t]        += tPlan[i].nbConv[t];
+        tPlan[root].nbConvSamples[t] += tPlan[i].nbConvSamples[t];
+      }
+      if (tPlan[i].pConf->bufferType != tPlan[root].pConf->bufferType)
+      {
+        tPlan[root].typeMask = 0UL;   /* inconsistent group: left as is, graph init will report it */
+      }
+    }
   }
-  return error;
-}
 
+  /* select the cheapest type for each group, before any chunk of the group is retyped */
+  for (uint8_t i = 0U; i < nbChunks; i++)
+  {
+    if (s_typePlan_find(tPlan, i) == i)
+    {
+      uint8_t const curT  = tPlan[i].pConf->bufferType - (uint8_t)ABUFF_FORMAT_FIXED16;
+      uint8_t       bestT = curT;
+
+      for (uint8_t t = 0U; t < AC_TYPE_PLAN_NB_TYPES; t++)
+      {
+        if (((tPlan[i].typeMask & (1UL << ((uint32_t)ABUFF_FORMAT_FIXED16 + t))) != 0UL) && (tPlan[i].nbConv[t] < tPlan[i].nbConv[bestT]))
+        {
+          bestT = t;
+        }
+      }
+      tPlan[i].curT  = curT;
+      tPlan[i].bestT = bestT;
+    }
+  }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-///////////////////////////////////// static (local) routines definition ///////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  /* retype the chunks of each group */
+  for (uint8_t i = 0U; i < nbChunks; i++)
+  {
+    uint8_t const root  = s_typePlan_find(tPlan, i);
+    uint8_t const curT  = tPlan[root].curT;
+    uint8_t const bestT = tPlan[root].bestT;
 
-static void s_error(void)
-{
-  trace_setAsynchronous(false);
-  trace_print(TRACE_OUTPUT_UART, TRACE_LVL_ERROR, "Audio Chain error => stop graph\n");
-  AudioChainInstance_deinitGraphRequest();
-}
+    if (bestT != curT)
+    {
+      audio_chunk_conf_t *const pConf = tPlan[i].pConf;
+      uint32_t            const nbSamples = (uint32_t)pConf->nbFrames * (uint32_t)pConf->nbChannels * pConf->nbElements;
+      uint8_t             const newType   = (uint8_t)ABUFF_FORMAT_FIXED16 + bestT;
+
+      chunksRamDelta += (int32_t)(nbSamples * ABUFF_SAMPLES_SIZE(newType)) - (int32_t)(nbSamples * ABUFF_SAMPLES_SIZE(pConf->bufferType));
+      if (i == root)
+      {
+        nbConvRemoved += tPlan[root].nbConv[curT] - tPlan[root].nbConv[bestT];
+        nbCyclesSaved += (tPlan[root].nbConvSamples[curT] - tPlan[root].nbConvSamples[bestT]) * AC_TYPE_PLAN_CYCLES_PER_SAMPLE;
+      }
+      if (gEnvData.bLogInit != 0U)
+      {
+        AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "chunk %s: type %d -> %d", pConf->pName, pConf->bufferType, newType);
+      }
+      pConf->bufferType = newType;
+    }
+  }
 
+  if (nbChunks == AC_TYPE_PLAN_MAX_CHUNKS)
+  {
+    AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_WARNING, NULL, 0, "chunks type optimization limited to the first %d chunks", AC_TYPE_PLAN_MAX_CHUNKS);
+  }
+  AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "chunks type optimization: %lu conversions removed, ~%lu cycles/frame saved, chunks RAM %+ld bytes", nbConvRemoved, nbCyclesSaved, chunksRamDelta);
 
-static void s_enable_CRC_peripheral(void)
-{
-  __HAL_RCC_CRC_CLK_ENABLE();
-  // reset is managed by the PDM lib
+  return error;
 }
 
 
 /**
-* @brief  Set/Get default log cycles
-*
+* @brief  Let the output chunk of AUDIO_ALGO_FLAGS_MISC_IN_PLACE algos point
+*         to the buffer of their input chunk, so that the samples are processed
+*         in place and downstream algos read them from the same memory.
+*         An output chunk is aliased only if both chunks are single frame user
+*         chunks with the same layout, the algo is the only reader of its input
+*         and the only writer of its output, and all the algos around run at
+*         the same priority level (no frame can be overwritten before it is read).
+*         This is a copy avoidance: copying algos (passThrough) skip their copy
+*         and the frame working set shrinks, but no chunks RAM is saved. Chunks
+*         buffers are allocated by the audio chain before this call and stay
+*         owned by it: the buffer of an aliased chunk stays allocated, unused,
+*         and is given back by AudioChainInstance_restoreInPlaceChunks.
+*         Must be called after AudioChain_configPendingChunks and before AudioChain_initGraph.
+* @param  pHdle audio chain handle
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
 */
-static int32_t s_envCb_setDefaultCyclesMngtCb(audio_algo_t *const pNull, void *const arg)
+int32_t AudioChainInstance_aliasInPlaceChunks(audio_chain_t *const pHdle)
 {
-  (void)pNull;  // unused parameter
-  uint8_t value = (uint8_t)(uint32_t)arg;   /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
-  gEnvData.bDefaultCycleCountMngtCb = value;
-  return AUDIO_ERR_MGNT_NONE;
-}
+  audio_algo_list_t *pAlgoList;
+  uint32_t           bytesCopySkipped = 0UL;  /* bytes/frame no more copied: only copying algos (passThrough) save a copy, the other in-place algos still process the whole frame */
+  int32_t            error            = AUDIO_ERR_MGNT_NONE;
 
+  nbInPlace = 0U;
+  for (pAlgoList = AudioChain_getAlgosList(pHdle); (pAlgoList != NULL) && AudioError_isOk(error); pAlgoList = pAlgoList->next)
+  {
+    audio_chunk_t *pChunkIn  = NULL;
+    audio_chunk_t *pChunkOut = NULL;
 
-static int32_t s_envCb_getDefaultCyclesMngtCb(audio_algo_t *const pNull, void **const pData)
-{
-  (void)pNull;  // unused parameter
-  *((uint32_t *)pData) = (uint32_t)gEnvData.bDefaultCycleCountMngtCb;
-  return AUDIO_ERR_MGNT_NONE;
+    if (s_inPlace_isCandidate(pHdle, pAlgoList->pAlgo, &pChunkIn, &pChunkOut))
+    {
+      if (nbInPlace < AC_IN_PLACE_MAX_CHUNKS)
+      {
+        tInPlace[nbInPlace].pChunk = pChunkOut;
+        tInPlace[nbInPlace].pData  = AudioChunk_getPdata(pChunkOut);
+
+        error = AudioChunk_setPdata(pChunkOut, AudioChunk_getPdata(pChunkIn));
+        if (AudioError_isOk(error))
+        {
+          error = AudioChunk_setChannelsBuffPtr(pChunkOut);
+        }
+        if (AudioError_isOk(error))
+        {
+          audio_algo_factory_t const *const pFactory  = AudioAlgo_getFactory(pAlgoList->pAlgo);
+          uint32_t                    const chunkSize = AudioBuffer_getBufferSize(AudioChunk_getBuffInfo(pChunkOut));
+
+          if ((pFactory != NULL) && (pFactory->pCapabilities != NULL) && (strcmp(pFactory->pCapabilities->pName, "passThrough") == 0))
+          {
+            bytesCopySkipped += chunkSize;
+          }
+          if (gEnvData.bLogInit != 0U)
+          {
+            AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "chunk %s: shares %s buffer (%s in place)", AudioChunk_getConf(pChunkOut)->pName, AudioChunk_getConf(pChunkIn)->pName, AudioAlgo_getInstanceName(pAlgoList->pAlgo));
+          }
+        }
+        nbInPlace++;
+      }
+      else
+      {
+        AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_WARNING, NULL, 0, "in-place chunks limited to %d chunks", AC_IN_PLACE_MAX_CHUNKS);
+      }
+    }
+  }
+
+  AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "in-place chunks: %d chunks aliased, %lu bytes/frame of copies avoided", nbInPlace, bytesCopySkipped);
+
+  if (AudioError_isError(error))
+  {
+    (void)AudioChainInstance_restoreInPlaceChunks();
+  }
+
+  return error;
 }
 
 
 /**
-* @brief  Set/Get call-back cycles timeout
-*
+* @brief  Give back to aliased chunks their own buffer so that the audio chain
+*         releases the buffers it allocated. Must be called before AudioChain_deinitGraph.
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
 */
-static int32_t s_envCb_setCyclesMngtCbTimeout(audio_algo_t *const pNull, void *const arg)
+int32_t AudioChainInstance_restoreInPlaceChunks(void)
 {
-  (void)pNull;  // unused parameter
-  uint32_t value = (uint32_t)arg; /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
-  gEnvData.iCycleCountCbTimeout = value;
-  return AUDIO_ERR_MGNT_NONE;
+  int32_t error = AUDIO_ERR_MGNT_NONE;
+
+  for (uint8_t i = 0U; i < nbInPlace; i++)
+  {
+    error = AudioError_update(error, AudioChunk_setPdata(tInPlace[i].pChunk, tInPlace[i].pData));
+    error = AudioError_update(error, AudioChunk_setChannelsBuffPtr(tInPlace[i].pChunk));
+  }
+  nbInPlace = 0U;
+
+  return error;
 }
 
 
-static int32_t s_envCb_getCyclesMngtCbTimeout(audio_algo_t *const pNull, void **const pData)
+/**
+* @brief  Split the graph algos between the normal and the low priority process passes.
+*         An algo is critical when a system output chunk depends on its outputs; the
+*         instances of the placeable consumers (tPlaceable) which are not critical may
+*         run in the low priority pass so that the normal pass only runs the path to the
+*         system outputs. The library latches the prio level from the factory the algo
+*         is configured with and has no per-instance setter: the decision is applied by
+*         AudioChainInstance_initStaticGraph, which configures these instances with a
+*         low prio level copy of their factory. acSdk graphs bind the factory in
+*         acAlgoCreate, before the graph topology is known: their algos keep the prio
+*         level of their wrapper and the decision is only reported.
+*         Must be called before AudioChain_initGraph.
+* @param  pHdle audio chain handle
+* @retval Error; AUDIO_ERR_MGNT_NONE if no error
+*/
+int32_t AudioChainInstance_placeAlgos(audio_chain_t *const pHdle)
+{
+  audio_algo_list_t *pAlgoList;
+  bool               changed = true;
+  bool               skipped = false;
+
+  AudioChainInstance_resetPlacement();
+  for (pAlgoList = AudioChain_getAlgosList(pHdle); (pAlgoList != NULL) && !skipped; pAlgoList = pAlgoList->next)
+  {
+    if (placementCtx.nbAlgos < AC_PLACEMENT_MAX_ALGOS)
+    {
+      placementCtx.tAlgos[placementCtx.nbAlgos] = pAlgoList->pAlgo;
+      placementCtx.nbAlgos++;
+    }
+    else
+    {
+      AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_WARNING, NULL, 0, "algo placement limited to %d algos, skipped", AC_PLACEMENT_MAX_ALGOS);
+      AudioChainInstance_resetPlacement();
+      skipped = true;
+    }
+  }
+
+  /* criticality flows backward from the system outputs: iterate until no more algo is marked */
+  while (changed && !skipped)
+  {
+    changed = false;
+    for (uint8_t i = 0U; i < placementCtx.nbAlgos; i++)
+    {
+      if (!placementCtx.bCritical[i] && s_placement_feedsCritical(placementCtx.tAlgos[i]))
+      {
+        placementCtx.bCritical[i] = true;
+        changed                   = true;
+      }
+    }
+  }
+
+  for (uint8_t i = 0U; i < placementCtx.nbAlgos; i++)
+  {
+    placementCtx.bLow[i] = !placementCtx.bCritical[i] && (s_placement_findPlaceable(AudioAlgo_getFactory(placementCtx.tAlgos[i])) != NULL);
+  }
+  if (!skipped)
+  {
+    s_placement_trace(pHdle, false);
+  }
+
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+/**
+* @brief  Forget the algos placement; called when the graph is released since the
+*         placement keeps the algos handles
+*/
+void AudioChainInstance_resetPlacement(void)
+{
+  memset(&placementCtx, 0, sizeof(placementCtx));
+}
+
+
+/**
+* @brief  Worst-case latencies of the process passes of the running graph from the
+*         measured max cycles (cycles count must be enabled, see bLogCycles).
+*         The normal pass latency is the dataInOut of all algos plus the process of the
+*         normal priority algos; the low pass one adds the process of the low priority
+*         algos since it is preempted by the normal pass.
+* @param  pStats placement stats
+* @retval true if the placement was computed, false if AudioChainInstance_placeAlgos didn't run
+*/
+bool AudioChainInstance_getPlacement(audio_chain_instance_placement_t *const pStats)
+{
+  bool     ok            = (placementCtx.nbAlgos != 0U);
+  uint32_t dataInOutUs   = 0UL;
+  uint32_t normalUs      = 0UL;
+  uint32_t lowUs         = 0UL;
+  bool     measured      = false;
+
+  if (ok)
+  {
+    memset(pStats, 0, sizeof(*pStats));
+    pStats->nbAlgos = placementCtx.nbAlgos;
+    for (uint8_t i = 0U; i < placementCtx.nbAlgos; i++)
+    {
+      audio_algo_t *const pAlgo     = placementCtx.tAlgos[i];
+      uint32_t      const processUs = s_placement_maxUs(AudioAlgo_getProcessCyclesMgntStats(pAlgo));
+
+      if (placementCtx.bCritical[i])
+      {
+        pStats->nbCritical++;
+      }
+      dataInOutUs += s_placement_maxUs(AudioAlgo_getDataInOutCyclesMgntStats(pAlgo));
+      if (AudioAlgo_getPrioLevel(pAlgo) == AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW)
+      {
+        pStats->nbLow++;
+        lowUs += processUs;
+      }
+      else
+      {
+        normalUs += processUs;
+      }
+      measured = measured || (processUs != 0UL);
+
+      for (audio_chunk_list_t *pList = AudioAlgo_getChunksOut(pAlgo); (pList != NULL) && (pStats->frameUs == 0UL); pList = pList->next)
+      {
+        audio_chunk_conf_t const *const pConf = AudioChunk_getConf(pList->pChunk);
+
+        if (AudioChunk_isSystem(pList->pChunk) && (pConf->timeFreq == (uint8_t)ABUFF_FORMAT_TIME) && (pConf->fs != 0UL))
+        {
+          pStats->frameUs = (uint32_t)(((uint64_t)pConf->nbElements * 1000000ULL) / (uint64_t)pConf->fs);
+        }
+      }
+    }
+    pStats->criticalUs = dataInOutUs + normalUs;
+    pStats->lowUs      = pStats->criticalUs + lowUs;
+    pStats->bMeasured  = measured;
+  }
+
+  return ok;
+}
+
+
+/**
+* @brief  Tells if a system output chunk depends on the algo outputs (last placement)
+* @param  pAlgo algo handle
+* @retval true if the algo is on the critical path
+*/
+bool AudioChainInstance_isCriticalAlgo(audio_algo_t *const pAlgo)
+{
+  int8_t const idx = s_placement_findAlgo(pAlgo);
+
+  return (idx >= 0) && placementCtx.bCritical[idx];
+}
+
+
+bool AudioChainInstance_setEnableCyclesCnt(bool const enable)
+{
+  return AudioChain_setEnableCyclesCnt(&AudioChainInstance, enable);
+}
+
+
+bool AudioChainInstance_getCyclesCntStatus(void)
+{
+  return AudioChain_getCyclesCntStatus(&AudioChainInstance);
+}
+
+
+bool AudioChainInstance_setEnableTraces(bool const enable)
+{
+  return AudioChain_setEnableTraces(&AudioChainInstance, enable);
+}
+
+
+bool AudioChainInstance_getTracesStatus(void)
+{
+  return AudioChain_getTracesStatus(&AudioChainInstance);
+}
+
+
+uint32_t AudioChainInstance_getCycleCountMeasureTimeout(void)
+{
+  return gEnvData.iCycleCountMeasureTimeout;
+}
+
+
+uint32_t AudioChainInstance_getCycleCountCbTimeout(void)
+{
+  return gEnvData.iCycleCountCbTimeout;
+}
+
+
+int32_t AudioChainInstance_dumpFactoryEntry(void)
+{
+  return AudioChain_dumpFactoryEntry(&AudioChainInstance);
+}
+
+
+/**
+* @brief  Set an environment configuration
+*/
+int32_t AudioChainInstance_setEnvDescriptors(const char *pKey, uint32_t value)
+{
+  int32_t  error = AUDIO_ERR_MGNT_ERROR;
+  if (pKey != NULL)
+  {
+    error  = AudioAlgo_setCommonDescConfig(NULL, tEnvParams, pKey, (void *)value);  /*cstat !MISRAC2012-Rule-11.6 cast to pointer because it's the API*/
+  }
+  return error;
+}
+
+
+
+/**
+* @brief  Set an environment configuration
+*/
+int32_t AudioChainInstance_dumpEnvDescriptors(void)
+{
+  const audio_algo_descriptor_t  *pCommonDesc = tEnvParams;
+  while (pCommonDesc->pName)
+  {
+    s_trace("%-29s : %-20s\n", "Name",  pCommonDesc->pName);
+    s_trace("\t%-21s : %-14s\n", "Description",  pCommonDesc->pDescription);
+    s_trace("\t%-21s : %-14s\n", "Expected Value",  pCommonDesc->pExpectedValue);
+    pCommonDesc++;
+  }
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+
+/**
+* @brief  Get an environment configuration
+*         Documented in the header
+*/
+int32_t AudioChainInstance_getEnvConfig(const char *pKey, void *pParam)
+{
+  int32_t  error = AUDIO_ERR_MGNT_ERROR;
+  if ((pKey != NULL) && (pParam != NULL))
+  {
+    error = AudioChainFactory_getAlgoCommonDescConfig(NULL, tEnvParams, pKey, pParam);
+  }
+  return error;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////// static (local) routines definition ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void s_error(void)
+{
+  trace_setAsynchronous(false);
+  trace_print(TRACE_OUTPUT_UART, TRACE_LVL_ERROR, "Audio Chain error => stop graph\n");
+  AudioChainInstance_deinitGraphRequest();
+}
+
+
+static void s_enable_CRC_peripheral(void)
+{
+  __HAL_RCC_CRC_CLK_ENABLE();
+  // reset is managed by the PDM lib
+}
+
+
+/**
+* @brief  Set/Get default log cycles
+*
+*/
+static int32_t s_envCb_setDefaultCyclesMngtCb(audio_algo_t *const pNull, void *const arg)
+{
+  (void)pNull;  // unused parameter
+  uint8_t value = (uint8_t)(uint32_t)arg;   /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
+  gEnvData.bDefaultCycleCountMngtCb = value;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+static int32_t s_envCb_getDefaultCyclesMngtCb(audio_algo_t *const pNull, void **const pData)
+{
+  (void)pNull;  // unused parameter
+  *((uint32_t *)pData) = (uint32_t)gEnvData.bDefaultCycleCountMngtCb;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+/**
+* @brief  Set/Get call-back cycles timeout
+*
+*/
+static int32_t s_envCb_setCyclesMngtCbTimeout(audio_algo_t *const pNull, void *const arg)
+{
+  (void)pNull;  // unused parameter
+  uint32_t value = (uint32_t)arg; /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
+  gEnvData.iCycleCountCbTimeout = value;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+static int32_t s_envCb_getCyclesMngtCbTimeout(audio_algo_t *const pNull, void **const pData)
 {
   (void)pNull;  // unused parameter
   *((uint32_t *)pData) = gEnvData.iCycleCountCbTimeout;
@@ -766,6 +1562,788 @@ static int32_t s_envCb_getTuning(audio_algo_t *const pNull, void **const pData)
 }
 
 
+/**
+* @brief  Set/Get chunks type optimization
+*
+*/
+static int32_t s_envCb_setOptimChunksType(audio_algo_t *const pNull, void *const arg)
+{
+  (void)pNull;  // unused parameter
+  uint8_t value = (uint8_t)(uint32_t)arg; /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
+  gEnvData.bOptimChunksType = value;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+static int32_t s_envCb_getOptimChunksType(audio_algo_t *const pNull, void **const pData)
+{
+  (void)pNull;  // unused parameter
+  *((uint32_t *)pData) = (uint32_t)gEnvData.bOptimChunksType;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+/**
+* @brief  Set/Get in-place chunks
+*
+*/
+static int32_t s_envCb_setInPlaceChunks(audio_algo_t *const pNull, void *const arg)
+{
+  (void)pNull;  // unused parameter
+  uint8_t value = (uint8_t)(uint32_t)arg; /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
+  gEnvData.bInPlaceChunks = value;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+static int32_t s_envCb_getInPlaceChunks(audio_algo_t *const pNull, void **const pData)
+{
+  (void)pNull;  // unused parameter
+  *((uint32_t *)pData) = (uint32_t)gEnvData.bInPlaceChunks;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+/**
+* @brief  Set/Get automatic process priority placement
+*
+*/
+static int32_t s_envCb_setAutoPrioPlacement(audio_algo_t *const pNull, void *const arg)
+{
+  (void)pNull;  // unused parameter
+  uint8_t value = (uint8_t)(uint32_t)arg; /*cstat !MISRAC2012-Rule-11.6 cast from pointer because it's the API*/
+  gEnvData.bAutoPrioPlacement = value;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+static int32_t s_envCb_getAutoPrioPlacement(audio_algo_t *const pNull, void **const pData)
+{
+  (void)pNull;  // unused parameter
+  *((uint32_t *)pData) = (uint32_t)gEnvData.bAutoPrioPlacement;
+  return AUDIO_ERR_MGNT_NONE;
+}
+
+
+/**
+* @brief  Chunks type planner helpers: union-find on chunks tied by an algo type consistency
+*
+*/
+static uint8_t s_typePlan_find(audio_chain_instance_type_plan_t *const pPlan, uint8_t const id)
+{
+  uint8_t root = id;
+  while (pPlan[root].parent != root)
+  {
+    pPlan[root].parent = pPlan[pPlan[root].parent].parent; /* path halving */
+    root               = pPlan[root].parent;
+  }
+  return root;
+}
+
+
+static uint8_t s_typePlan_getId(audio_chain_instance_type_plan_t const *const pPlan, uint8_t const nbChunks, audio_chunk_t const *const pChunk)
+{
+  uint8_t id = AC_TYPE_PLAN_MAX_CHUNKS;
+  for (uint8_t i = 0U; (i < nbChunks) && (id == AC_TYPE_PLAN_MAX_CHUNKS); i++)
+  {
+    if (pPlan[i].pChunk == pChunk)
+    {
+      id = i;
+    }
+  }
+  return id;
+}
+
+
+/* only pending user chunks in time domain PCM formats are candidates; system chunks type is imposed by the HW */
+static uint8_t s_typePlan_addChunk(audio_chain_instance_type_plan_t *const pPlan, uint8_t *const pNbChunks, audio_chunk_t *const pChunk)
+{
+  uint8_t id = s_typePlan_getId(pPlan, *pNbChunks, pChunk);
+
+  if ((id == AC_TYPE_PLAN_MAX_CHUNKS) && (*pNbChunks < AC_TYPE_PLAN_MAX_CHUNKS) && !AudioChunk_isSystem(pChunk) && !AudioChunk_isConfigured(pChunk))
+  {
+    audio_chunk_conf_t *const pConf = AudioChunk_getConf(pChunk);
+
+    if ((pConf != NULL) &&
+        (pConf->timeFreq == (uint8_t)ABUFF_FORMAT_TIME) &&
+        (pConf->bufferType >= (uint8_t)ABUFF_FORMAT_FIXED16) &&
+        (pConf->bufferType <= (uint8_t)ABUFF_FORMAT_FLOAT))
+    {
+      id                 = *pNbChunks;
+      pPlan[id].pChunk   = pChunk;
+      pPlan[id].pConf    = pConf;
+      pPlan[id].parent   = id;
+      pPlan[id].typeMask = (uint32_t)AUDIO_CAPABILITY_TYPE_FIXED16_FIXED32_FLOAT;
+      (*pNbChunks)++;
+    }
+  }
+  return id;
+}
+
+
+/* tie all chunks of pList (and pList2 if not NULL) */
+static void s_typePlan_join(audio_chain_instance_type_plan_t *const pPlan, uint8_t const nbChunks, audio_chunk_list_t *pList, audio_chunk_list_t *pList2)
+{
+  uint8_t first = AC_TYPE_PLAN_MAX_CHUNKS;
+
+  for (uint8_t l = 0U; l < 2U; l++)
+  {
+    for (audio_chunk_list_t *pCur = (l == 0U) ? pList : pList2; pCur != NULL; pCur = pCur->next)
+    {
+      uint8_t const id = s_typePlan_getId(pPlan, nbChunks, pCur->pChunk);
+
+      if (id == AC_TYPE_PLAN_MAX_CHUNKS)
+      {
+        /* tied to a chunk whose type can't change (system, configured, ...): the whole group is frozen */
+        if (first != AC_TYPE_PLAN_MAX_CHUNKS)
+        {
+          pPlan[s_typePlan_find(pPlan, first)].typeMask = 0UL;
+        }
+        first = AC_TYPE_PLAN_MAX_CHUNKS + 1U;
+      }
+      else if (first == (AC_TYPE_PLAN_MAX_CHUNKS + 1U))
+      {
+        pPlan[s_typePlan_find(pPlan, id)].typeMask = 0UL;
+      }
+      else if (first == AC_TYPE_PLAN_MAX_CHUNKS)
+      {
+        first = id;
+      }
+      else
+      {
+        uint8_t const rootA = s_typePlan_find(pPlan, first);
+        uint8_t const rootB = s_typePlan_find(pPlan, id);
+        if (rootA != rootB)
+        {
+          pPlan[rootB].parent    = rootA;
+          pPlan[rootA].typeMask &= pPlan[rootB].typeMask;
+          pPlan[rootB].typeMask  = pPlan[rootA].typeMask;
+        }
+      }
+    }
+  }
+}
+
+
+/* an algo endpoint restricts the chunk type to the algo capabilities and costs one conversion if the chunk type isn't the algo native one */
+static void s_typePlan_addEndPoints(audio_chain_instance_type_plan_t *const pPlan, uint8_t const nbChunks, audio_chunk_list_t *pList, uint32_t const typeMask, audio_buffer_type_t const nativeType)
+{
+  for (audio_chunk_list_t *pCur = pList; pCur != NULL; pCur = pCur->next)
+  {
+    uint8_t const id = s_typePlan_getId(pPlan, nbChunks, pCur->pChunk);
+
+    if (id != AC_TYPE_PLAN_MAX_CHUNKS)
+    {
+      pPlan[id].typeMask &= typeMask;
+      if (nativeType != ABUFF_FORMAT_UNKNOWN)
+      {
+        uint32_t const nbSamples = (uint32_t)pPlan[id].pConf->nbChannels * pPlan[id].pConf->nbElements;
+
+        for (uint8_t t = 0U; t < AC_TYPE_PLAN_NB_TYPES; t++)
+        {
+          if (((uint8_t)ABUFF_FORMAT_FIXED16 + t) != (uint8_t)nativeType)
+          {
+            pPlan[id].nbConv[t]++;
+            pPlan[id].nbConvSamples[t] += nbSamples;
+          }
+        }
+      }
+    }
+  }
+}
+
+
+static audio_buffer_type_t s_typePlan_getNativeType(audio_algo_common_t const *const pCapabilities)
+{
+  audio_buffer_type_t nativeType = ABUFF_FORMAT_UNKNOWN;
+
+  if (pCapabilities->pName != NULL)
+  {
+    for (audio_chain_instance_native_type_t const *pCur = tNativeTypes; (pCur->pName != NULL) && (nativeType == ABUFF_FORMAT_UNKNOWN); pCur++)
+    {
+      if (strcmp(pCur->pName, pCapabilities->pName) == 0)
+      {
+        nativeType = pCur->nativeType;
+      }
+    }
+  }
+  return nativeType;
+}
+
+
+/**
+* @brief  Graph swap helpers: system outputs ramp applied at the end of each
+*         audio run (system out buffers are final once AudioChain_run returns),
+*         graph rebuild in the low priority context & graph allocations sum
+*
+*/
+static void s_swap_applyRamp(void)
+{
+  ac_sys_ios_t const *const pSysIos    = AudioChainSysIOs_get();
+  uint32_t            const nbRuns     = swapCtx.nbRuns;
+  float                     gainStart  = 0.0f;
+  float                     gainEnd    = 0.0f;
+
+  switch (swapCtx.state)
+  {
+    case AC_SWAP_FADE_OUT:
+      gainStart = 1.0f - ((float)nbRuns         / (float)AC_SWAP_FADE_RUNS);
+      gainEnd   = 1.0f - ((float)(nbRuns + 1UL) / (float)AC_SWAP_FADE_RUNS);
+      break;
+    case AC_SWAP_FADE_IN:
+      gainStart = (float)nbRuns         / (float)AC_SWAP_FADE_RUNS;
+      gainEnd   = (float)(nbRuns + 1UL) / (float)AC_SWAP_FADE_RUNS;
+      break;
+    default:
+      break;
+  }
+
+  for (uint8_t i = 0U; i < pSysIos->out.nb; i++)
+  {
+    s_swap_rampBuffer(AudioChunk_getBuffInfo(&pSysIos->out.pIos[i].hdle), gainStart, gainEnd);
+  }
+
+  switch (swapCtx.state)
+  {
+    case AC_SWAP_FADE_OUT:
+      swapCtx.nbRuns = nbRuns + 1UL;
+      if (swapCtx.nbRuns >= AC_SWAP_FADE_RUNS)
+      {
+        swapCtx.mutedMs = AudioChainInstance_getNbMsFromStart();
+        swapCtx.nbRuns  = 0UL;
+        swapCtx.state   = AC_SWAP_MUTED;
+      }
+      break;
+    case AC_SWAP_FADE_IN:
+      if (nbRuns == 0UL)
+      {
+        swapCtx.stats.gapMs = (uint32_t)(AudioChainInstance_getNbMsFromStart() - swapCtx.mutedMs);
+      }
+      swapCtx.nbRuns = nbRuns + 1UL;
+      if (swapCtx.nbRuns >= AC_SWAP_FADE_RUNS)
+      {
+        swapCtx.stats.swapMs = (uint32_t)(AudioChainInstance_getNbMsFromStart() - swapCtx.requestMs);
+        swapCtx.bStatsReady  = true;
+        swapCtx.state        = AC_SWAP_IDLE;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+
+static void s_swap_rampBuffer(audio_buffer_t const *const pBuff, float const gainStart, float const gainEnd)
+{
+  void *const pData = (pBuff != NULL) ? AudioBuffer_getPdata(pBuff) : NULL;
+
+  if (pData != NULL)
+  {
+    uint32_t const nbElements  = AudioBuffer_getNbElements(pBuff);
+    uint32_t const nbChannels  = (uint32_t)AudioBuffer_getNbChannels(pBuff);
+    bool     const interleaved = (AudioBuffer_getInterleaved(pBuff) == ABUFF_FORMAT_INTERLEAVED);
+    uint8_t  const type        = (uint8_t)AudioBuffer_getType(pBuff);
+    float    const gainIncr    = (nbElements > 0UL) ? ((gainEnd - gainStart) / (float)nbElements) : 0.0f;
+
+    for (uint32_t ch = 0UL; ch < nbChannels; ch++)
+    {
+      uint32_t const offset = interleaved ? ch         : (ch * nbElements);
+      uint32_t const incr   = interleaved ? nbChannels : 1UL;
+      float          gain   = gainStart;
+
+      for (uint32_t spl = 0UL; spl < nbElements; spl++)
+      {
+        uint32_t const idx = offset + (spl * incr);
+
+        switch (type)
+        {
+          case ABUFF_FORMAT_FIXED16:
+            ((int16_t *)pData)[idx] = (int16_t)(gain * (float)((int16_t *)pData)[idx]);
+            break;
+          case ABUFF_FORMAT_FIXED32:
+            ((int32_t *)pData)[idx] = (int32_t)(gain * (float)((int32_t *)pData)[idx]);
+            break;
+          case ABUFF_FORMAT_FLOAT:
+            ((float *)pData)[idx] *= gain;
+            break;
+          default:
+            break;
+        }
+        gain += gainIncr;
+      }
+    }
+  }
+}
+
+
+static void s_swap_rebuild(void)
+{
+  uint32_t const cyclesStart = cycleMeasure_currentCycles();
+
+  AudioChainInstance_deinitTuning();
+  if (AudioError_isError(AudioChainInstance_restoreInPlaceChunks()))
+  {
+    AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChainInstance_restoreInPlaceChunks error");
+  }
+  AudioChainInstance_deinitGraph();
+  swapCtx.pInitGraphCb();
+  AudioChainInstance_initTuning();
+
+  swapCtx.stats.rebuildCycles = cycleMeasure_currentCycles() - cyclesStart;
+  swapCtx.stats.newGraphRam   = s_swap_getGraphRam();
+  if (swapCtx.stats.newGraphRam > swapCtx.stats.peakRam)
+  {
+    swapCtx.stats.peakRam = swapCtx.stats.newGraphRam;
+  }
+  AudioChain_trace(&AudioChainInstance, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "graph swap: rebuild %lu us, graph RAM %lu -> %lu bytes (peak %lu)",
+                   (uint32_t)(((uint64_t)swapCtx.stats.rebuildCycles * 1000000ULL) / (uint64_t)cycleMeasure_getSystemCoreClock()),
+                   swapCtx.stats.oldGraphRam,
+                   swapCtx.stats.newGraphRam,
+                   swapCtx.stats.peakRam);
+
+  swapCtx.nbRuns = 0UL;
+  swapCtx.state  = AC_SWAP_FADE_IN;
+}
+
+
+static uint32_t s_cyclesToUs(uint32_t const cycles)
+{
+  return (uint32_t)(((uint64_t)cycles * 1000000ULL) / (uint64_t)cycleMeasure_getSystemCoreClock());
+}
+
+
+static audio_chunk_t *s_staticGraph_getChunk(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const chunkId)
+{
+  audio_chain_instance_static_chunk_t const *const pDescr  = &pGraph->pChunksDescr[chunkId];
+  audio_chain_sys_connections_t       const       *pSysCnx = NULL;
+  audio_chunk_t                                   *pChunk  = NULL;
+
+  switch (pDescr->sysType)
+  {
+    case AC_STATIC_CHUNK_SYS_IN:
+      pSysCnx = AudioChainSysIOs_getCnxIn();
+      break;
+    case AC_STATIC_CHUNK_SYS_OUT:
+      pSysCnx = AudioChainSysIOs_getCnxOut();
+      break;
+    default:
+      pChunk = &pGraph->pChunks[chunkId];
+      break;
+  }
+  if ((pSysCnx != NULL) && (pDescr->sysId < pSysCnx->nb))
+  {
+    pChunk = pSysCnx->pConf[pDescr->sysId].pSysChunk;
+  }
+
+  return pChunk;
+}
+
+
+/**
+* @brief  Same as acAlgoCreate: the algo handle and its configs are provided by the graph
+*         description instead of being allocated, and the configs are copied from their
+*         tuned binary images instead of being parsed from the factory default strings.
+*/
+static int32_t s_staticGraph_createAlgo(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const algoId, CycleStatsCb_t *const pCycleCount)
+{
+  audio_chain_instance_static_algo_t const *const pDescr   = &pGraph->pAlgosDescr[algoId];
+  audio_algo_factory_t               const *const pFactory = s_placement_getFactory(pDescr->pFactory, algoId);
+  audio_algo_t                             *const pAlgo    = &pGraph->pAlgos[algoId];
+  int32_t                                         error    = AUDIO_ERR_MGNT_NONE;
+
+  if ((pFactory->pStaticParamTemplate != NULL) && (pDescr->pStaticConfig != NULL))
+  {
+    memcpy(pDescr->pStaticConfig, pDescr->pStaticInit, pFactory->pStaticParamTemplate->szBytes);
+  }
+  if ((pFactory->pDynamicParamTemplate != NULL) && (pDescr->pDynamicConfig != NULL))
+  {
+    memcpy(pDescr->pDynamicConfig, pDescr->pDynamicInit, pFactory->pDynamicParamTemplate->szBytes);
+  }
+  for (uint8_t i = 0U; AudioError_isOk(error) && (i < pDescr->nbAddrParams); i++)
+  {
+    audio_chain_instance_static_param_t const *const pParam    = &pDescr->pAddrParams[i];
+    audio_descriptor_params_t           const *const pTemplate = (pParam->bDynamic != 0U) ? pFactory->pDynamicParamTemplate : pFactory->pStaticParamTemplate;
+    void                                      *const pConfig   = (pParam->bDynamic != 0U) ? pDescr->pDynamicConfig       : pDescr->pStaticConfig;
+
+    error = AudioDescriptor_applyParamConfigStr(&pTemplate->pParam[pParam->paramId], pConfig, pParam->pValue, NULL);
+  }
+
+  if (AudioError_isOk(error))
+  {
+    memset(pAlgo, 0, sizeof(audio_algo_t));
+    error = AudioAlgo_config(pAlgo,
+                             pDescr->state,
+                             pDescr->pDesc,
+                             pDescr->pStaticConfig,
+                             pDescr->pDynamicConfig,
+                             pFactory,
+                             gEnvData.iCycleCountMeasureTimeout,
+                             gEnvData.iCycleCountCbTimeout,
+                             pCycleCount,
+                             pGraph->algoMemPool);
+  }
+  if (AudioError_isOk(error))
+  {
+    error = AudioAlgo_setUtilsHdle(pAlgo, AudioChain_getUtilsHdle(&AudioChainInstance));
+  }
+  if (AudioError_isOk(error) && (pDescr->controlCb != NULL))
+  {
+    AudioAlgo_setCtrlCb(pAlgo, pDescr->controlCb);
+  }
+  if (AudioError_isOk(error))
+  {
+    error = AudioChain_registerAlgos(&AudioChainInstance, pAlgo, NULL);
+  }
+
+  return error;
+}
+
+
+/**
+* @brief  Same as acPipePlay(AC_START) without the environment keys lookups
+*/
+static int32_t s_staticGraph_start(void)
+{
+  int32_t error = AUDIO_ERR_MGNT_NONE;
+
+  if (placementCtx.nbAlgos != 0U)
+  {
+    s_placement_trace(&AudioChainInstance, true);
+  }
+  if (gEnvData.bOptimChunksType != 0U)
+  {
+    error = AudioChainInstance_optimizeChunksType(&AudioChainInstance);
+  }
+  if (AudioError_isOk(error))
+  {
+    error = AudioChain_configPendingChunks(&AudioChainInstance);
+  }
+  if (AudioError_isOk(error) && (gEnvData.bInPlaceChunks != 0U))
+  {
+    error = AudioChainInstance_aliasInPlaceChunks(&AudioChainInstance);
+  }
+  if (AudioError_isOk(error))
+  {
+    trace_setAsynchronous(false);
+    error = AudioChain_initGraph(&AudioChainInstance); // may return a warning which doesn't prevent the graph to run
+    if (AudioError_isWarning(error))
+    {
+      error = AUDIO_ERR_MGNT_NONE; // ignore warnings
+    }
+  }
+  if (AudioError_isOk(error))
+  {
+    trace_setAsynchronous(true);
+  }
+  else
+  {
+    error = AudioError_update(error, AudioChainInstance_restoreInPlaceChunks());
+    error = AudioError_update(error, AudioChain_deinitGraph(&AudioChainInstance));
+    AudioChainInstance_resetPlacement();
+  }
+
+  return error;
+}
+
+
+/**
+* @brief  Same as AudioChainInstance_placeAlgos from the graph description, before the algos
+*         creation, so that the non-critical placeable instances are configured with the
+*         low prio level copy of their factory (see s_placement_getFactory)
+*/
+static void s_staticGraph_place(audio_chain_instance_static_graph_t const *const pGraph)
+{
+  bool changed = true;
+
+  AudioChainInstance_resetPlacement();
+  if (pGraph->nbAlgos > AC_PLACEMENT_MAX_ALGOS)
+  {
+    AudioChain_trace(&AudioChainInstance, "AUDIO_CHAIN", TRACE_LVL_WARNING, NULL, 0, "algo placement limited to %d algos, skipped", AC_PLACEMENT_MAX_ALGOS);
+  }
+  else
+  {
+    placementCtx.nbAlgos = pGraph->nbAlgos;
+    while (changed)
+    {
+      changed = false;
+      for (uint8_t cnxId = 0U; cnxId < pGraph->nbCnx; cnxId++)
+      {
+        audio_chain_instance_static_cnx_t const *const pCnx = &pGraph->pCnx[cnxId];
+
+        if ((pCnx->bOut != 0U) && !placementCtx.bCritical[pCnx->algoId] && s_staticGraph_feedsCritical(pGraph, pCnx->chunkId))
+        {
+          placementCtx.bCritical[pCnx->algoId] = true;
+          changed                              = true;
+        }
+      }
+    }
+    for (uint8_t algoId = 0U; algoId < pGraph->nbAlgos; algoId++)
+    {
+      placementCtx.tAlgos[algoId] = &pGraph->pAlgos[algoId];
+      placementCtx.bLow[algoId]   = !placementCtx.bCritical[algoId] && (s_placement_findPlaceable(pGraph->pAlgosDescr[algoId].pFactory) != NULL);
+    }
+  }
+}
+
+
+/**
+* @brief  Tells if the chunk is a system output or is read by an algo already known as critical
+*/
+static bool s_staticGraph_feedsCritical(audio_chain_instance_static_graph_t const *const pGraph, uint8_t const chunkId)
+{
+  bool critical = (pGraph->pChunksDescr[chunkId].sysType == (uint8_t)AC_STATIC_CHUNK_SYS_OUT);
+
+  for (uint8_t cnxId = 0U; (cnxId < pGraph->nbCnx) && !critical; cnxId++)
+  {
+    audio_chain_instance_static_cnx_t const *const pCnx = &pGraph->pCnx[cnxId];
+
+    critical = (pCnx->bOut == 0U) && (pCnx->chunkId == chunkId) && placementCtx.bCritical[pCnx->algoId];
+  }
+
+  return critical;
+}
+
+
+static uint32_t s_swap_getGraphRam(void)
+{
+  memAllocStat_t const *const pBuffersMallocStats = AudioChain_getBuffersMallocStatsPtr(&AudioChainInstance);
+  memAllocStat_t const *const pChunksMallocStats  = AudioChain_getChunksMallocStatsPtr(&AudioChainInstance);
+  uint32_t                    ram                 = 0UL;
+
+  for (uint8_t pool = 0U; pool < (uint8_t)AUDIO_MEM_NB_POOL; pool++)
+  {
+    ram += (pBuffersMallocStats != NULL) ? (uint32_t)pBuffersMallocStats[pool].totalAllocatedAllocSize : 0UL;
+    ram += (pChunksMallocStats  != NULL) ? (uint32_t)pChunksMallocStats[pool].totalAllocatedAllocSize  : 0UL;
+  }
+  for (audio_algo_list_t *pAlgoList = AudioChain_getAlgosList(&AudioChainInstance); pAlgoList != NULL; pAlgoList = pAlgoList->next)
+  {
+    memAllocStat_t const *const pAlgoMallocStats = AudioAlgo_getMallocStats(pAlgoList->pAlgo);
+
+    for (uint8_t pool = 0U; (pool < (uint8_t)AUDIO_MEM_NB_POOL) && (pAlgoMallocStats != NULL); pool++)
+    {
+      ram += (uint32_t)pAlgoMallocStats[pool].totalAllocatedAllocSize;
+    }
+  }
+
+  return ram;
+}
+
+
+/**
+* @brief  In-place chunks helpers: count the algos reading & writing a chunk and
+*         gather their priority levels, then check an algo output may share its input buffer
+*
+*/
+static void s_inPlace_scanChunk(audio_chain_t *const pHdle, audio_chunk_t const *const pChunk, uint8_t *const pNbReaders, uint8_t *const pNbWriters, uint32_t *const pPrioMask)
+{
+  for (audio_algo_list_t *pAlgoList = AudioChain_getAlgosList(pHdle); pAlgoList != NULL; pAlgoList = pAlgoList->next)
+  {
+    uint32_t const prioBit = 1UL << (uint32_t)AudioAlgo_getPrioLevel(pAlgoList->pAlgo);
+
+    for (audio_chunk_list_t *pList = AudioAlgo_getChunksIn(pAlgoList->pAlgo); pList != NULL; pList = pList->next)
+    {
+      if (pList->pChunk == pChunk)
+      {
+        (*pNbReaders)++;
+        *pPrioMask |= prioBit;
+      }
+    }
+    for (audio_chunk_list_t *pList = AudioAlgo_getChunksOut(pAlgoList->pAlgo); pList != NULL; pList = pList->next)
+    {
+      if (pList->pChunk == pChunk)
+      {
+        (*pNbWriters)++;
+        *pPrioMask |= prioBit;
+      }
+    }
+  }
+}
+
+
+/**
+* @brief  Placement helpers: an algo feeds the critical path if one of its outputs is a
+*         system chunk or is read by an algo already known as critical
+*
+*/
+static bool s_placement_feedsCritical(audio_algo_t *const pAlgo)
+{
+  bool critical = false;
+
+  for (audio_chunk_list_t *pOut = AudioAlgo_getChunksOut(pAlgo); (pOut != NULL) && !critical; pOut = pOut->next)
+  {
+    critical = AudioChunk_isSystem(pOut->pChunk);
+    for (uint8_t i = 0U; (i < placementCtx.nbAlgos) && !critical; i++)
+    {
+      if (placementCtx.bCritical[i])
+      {
+        for (audio_chunk_list_t *pIn = AudioAlgo_getChunksIn(placementCtx.tAlgos[i]); (pIn != NULL) && !critical; pIn = pIn->next)
+        {
+          critical = (pIn->pChunk == pOut->pChunk);
+        }
+      }
+    }
+  }
+
+  return critical;
+}
+
+
+static int8_t s_placement_findAlgo(audio_algo_t const *const pAlgo)
+{
+  int8_t idx = -1;
+
+  for (uint8_t i = 0U; (i < placementCtx.nbAlgos) && (idx < 0); i++)
+  {
+    if (placementCtx.tAlgos[i] == pAlgo)
+    {
+      idx = (int8_t)i;
+    }
+  }
+
+  return idx;
+}
+
+
+static audio_chain_instance_placeable_t *s_placement_findPlaceable(audio_algo_factory_t const *const pFactory)
+{
+  audio_chain_instance_placeable_t *pPlaceable = NULL;
+
+  if ((pFactory != NULL) && (pFactory->pCapabilities != NULL) && (pFactory->pCapabilities->pName != NULL))
+  {
+    for (audio_chain_instance_placeable_t *pCur = tPlaceable; (pCur->pName != NULL) && (pPlaceable == NULL); pCur++)
+    {
+      if (strcmp(pFactory->pCapabilities->pName, pCur->pName) == 0)
+      {
+        pPlaceable = pCur;
+      }
+    }
+  }
+
+  return pPlaceable;
+}
+
+
+/**
+* @brief  Factory to configure the algo with: the wrapper factory, or its low prio level
+*         copy if the placement moved the algo to the low priority pass. The wrapper
+*         capabilities are left untouched (they may be in flash).
+*/
+static audio_algo_factory_t const *s_placement_getFactory(audio_algo_factory_t const *const pFactory, uint8_t const algoId)
+{
+  audio_algo_factory_t const *pPlaced = pFactory;
+
+  if ((algoId < placementCtx.nbAlgos) && placementCtx.bLow[algoId])
+  {
+    audio_chain_instance_placeable_t *const pPlaceable = s_placement_findPlaceable(pFactory);
+
+    if (pPlaceable != NULL)
+    {
+      pPlaceable->lowCommon                = *pFactory->pCapabilities;
+      pPlaceable->lowCommon.prio_level     = AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW;
+      pPlaceable->lowFactory               = *pFactory;
+      pPlaceable->lowFactory.pCapabilities = &pPlaceable->lowCommon;
+      pPlaced                              = &pPlaceable->lowFactory;
+    }
+  }
+
+  return pPlaced;
+}
+
+
+static void s_placement_trace(audio_chain_t *const pHdle, bool const bApplied)
+{
+  uint8_t nbCritical = 0U;
+  uint8_t nbLow      = 0U;
+
+  for (uint8_t i = 0U; i < placementCtx.nbAlgos; i++)
+  {
+    if (placementCtx.bCritical[i])
+    {
+      nbCritical++;
+    }
+    if (placementCtx.bLow[i])
+    {
+      nbLow++;
+    }
+    if (gEnvData.bLogInit != 0U)
+    {
+      AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "algo %s: %s priority pass%s", AudioAlgo_getInstanceName(placementCtx.tAlgos[i]), (bApplied && placementCtx.bLow[i]) ? "low" : "normal", placementCtx.bCritical[i] ? ", critical path" : "");
+    }
+  }
+  if (bApplied)
+  {
+    AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "algo placement: %d algos, %d on the critical path, %d in the low priority pass", placementCtx.nbAlgos, nbCritical, nbLow);
+  }
+  else
+  {
+    AudioChain_trace(pHdle, "AUDIO_CHAIN", TRACE_LVL_INFO, NULL, 0, "algo placement: %d algos, %d on the critical path, %d could run in the low priority pass (acSdk graph: wrapper prio levels kept)", placementCtx.nbAlgos, nbCritical, nbLow);
+  }
+}
+
+
+static uint32_t s_placement_maxUs(CycleStatsTypeDef const *const pStats)
+{
+  return (pStats != NULL) ? s_cyclesToUs(cycleMeasure_maxCycles(pStats, CYCLES_LAST_MEASURE)) : 0UL;
+}
+
+
+static bool s_inPlace_isCandidate(audio_chain_t *const pHdle, audio_algo_t *const pAlgo, audio_chunk_t **const ppChunkIn, audio_chunk_t **const ppChunkOut)
+{
+  audio_algo_factory_t const *const pFactory   = AudioAlgo_getFactory(pAlgo);
+  audio_chunk_list_t         *const pChunksIn  = AudioAlgo_getChunksIn(pAlgo);
+  audio_chunk_list_t         *const pChunksOut = AudioAlgo_getChunksOut(pAlgo);
+  bool                              candidate  = false;
+
+  if ((pFactory != NULL) && (pFactory->pCapabilities != NULL) && ((pFactory->pCapabilities->misc.flags & AUDIO_ALGO_FLAGS_MISC_IN_PLACE) != 0U))
+  {
+    /* exactly one input & one output user chunks */
+    candidate = (pChunksIn != NULL) && (pChunksIn->next == NULL) && (pChunksOut != NULL) && (pChunksOut->next == NULL);
+    candidate = candidate && (pChunksIn->pChunk != pChunksOut->pChunk);
+    candidate = candidate && !AudioChunk_isSystem(pChunksIn->pChunk) && !AudioChunk_isSystem(pChunksOut->pChunk);
+  }
+
+  if (candidate)
+  {
+    audio_chunk_conf_t const *const pConfIn  = AudioChunk_getConf(pChunksIn->pChunk);
+    audio_chunk_conf_t const *const pConfOut = AudioChunk_getConf(pChunksOut->pChunk);
+
+    /* same memory layout, single frame so that read & write pointers never move */
+    candidate = (pConfIn->nbFrames    == 1U)                    &&
+                (pConfOut->nbFrames   == 1U)                    &&
+                (pConfIn->bufferType  == pConfOut->bufferType)  &&
+                (pConfIn->interleaved == pConfOut->interleaved) &&
+                (pConfIn->nbChannels  == pConfOut->nbChannels)  &&
+                (pConfIn->nbElements  == pConfOut->nbElements)  &&
+                (pConfIn->timeFreq    == pConfOut->timeFreq)    &&
+                (AudioChunk_getPdata(pChunksIn->pChunk)  != NULL) &&
+                (AudioChunk_getPdata(pChunksOut->pChunk) != NULL);
+  }
+
+  if (candidate)
+  {
+    uint8_t  nbReadersIn  = 0U;
+    uint8_t  nbWritersIn  = 0U;
+    uint8_t  nbReadersOut = 0U;
+    uint8_t  nbWritersOut = 0U;
+    uint32_t prioMask     = 0UL;
+
+    s_inPlace_scanChunk(pHdle, pChunksIn->pChunk,  &nbReadersIn,  &nbWritersIn,  &prioMask);
+    s_inPlace_scanChunk(pHdle, pChunksOut->pChunk, &nbReadersOut, &nbWritersOut, &prioMask);
+
+    /* input is consumed by this algo only, output is produced by this algo only, and a single task runs them all */
+    candidate = (nbReadersIn == 1U) && (nbWritersOut == 1U) && ((prioMask & (prioMask - 1UL)) == 0UL);
+  }
+
+  if (candidate)
+  {
+    *ppChunkIn  = pChunksIn->pChunk;
+    *ppChunkOut = pChunksOut->pChunk;
+  }
+
+  return candidate;
+}
+
+
 /**
 * @brief  Set the trace mode
 *
@@ -40,6 +40,92 @@ typedef struct
   bool                         logCmsisOs;
 } audio_chain_instance_params_t;
 
+typedef struct
+{
+  uint32_t                     swapMs;          /* from the swap request to the end of the new graph fade-in */
+  uint32_t                     gapMs;           /* output muted between old graph fade-out and new graph fade-in */
+  uint32_t                     rebuildCycles;   /* old graph deinit + new graph init, in the low priority context */
+  uint32_t                     oldGraphRam;     /* algos, chunks & buffers allocations of the old graph */
+  uint32_t                     newGraphRam;     /* algos, chunks & buffers allocations of the new graph */
+  uint32_t                     peakRam;         /* largest graph allocations seen during the swap */
+} audio_chain_instance_swap_stats_t;
+
+typedef enum
+{
+  AC_STATIC_CHUNK_USER,                         /* chunk instantiated from its static description */
+  AC_STATIC_CHUNK_SYS_IN,                       /* system input chunk, sysId is its index in AudioChainSysIOs_getCnxIn()  */
+  AC_STATIC_CHUNK_SYS_OUT                       /* system output chunk, sysId is its index in AudioChainSysIOs_getCnxOut() */
+} audio_chain_instance_static_chunk_type_t;
+
+typedef struct
+{
+  char                                const *pName;
+  uint8_t                                    sysType;        /* audio_chain_instance_static_chunk_type_t */
+  uint8_t                                    sysId;
+  audio_chunk_conf_t                         conf;           /* pre-resolved chunk configuration (user chunks only) */
+} audio_chain_instance_static_chunk_t;
+
+typedef struct
+{
+  uint8_t                                    bDynamic;       /* parameter of the dynamic config, else of the static config */
+  uint8_t                                    paramId;        /* index of the parameter in the factory template */
+  char                                const *pValue;         /* address parameters can't be pre-resolved: applied at init */
+} audio_chain_instance_static_param_t;
+
+typedef struct
+{
+  char                                const *pDesc;
+  audio_algo_factory_t                const *pFactory;
+  audio_algo_state_t                         state;
+  audio_algo_cb_t                            controlCb;
+  void                                      *pStaticConfig;  /* RAM owned by the graph, refilled from pStaticInit at each init  */
+  void                                      *pDynamicConfig; /* RAM owned by the graph, refilled from pDynamicInit at each init */
+  void                                const *pStaticInit;    /* binary image of the tuned static config  */
+  void                                const *pDynamicInit;   /* binary image of the tuned dynamic config */
+  audio_chain_instance_static_param_t const *pAddrParams;
+  uint8_t                                    nbAddrParams;
+} audio_chain_instance_static_algo_t;
+
+typedef struct
+{
+  uint8_t                                    algoId;
+  uint8_t                                    chunkId;
+  uint8_t                                    pinId;
+  uint8_t                                    bOut;           /* algo output, else algo input */
+} audio_chain_instance_static_cnx_t;
+
+typedef struct
+{
+  audio_algo_t                              *pAlgos;         /* nbAlgos  handles storage */
+  audio_chunk_t                             *pChunks;        /* nbChunks handles storage, unused for system chunks */
+  audio_chain_instance_static_algo_t  const *pAlgosDescr;
+  audio_chain_instance_static_chunk_t const *pChunksDescr;
+  audio_chain_instance_static_cnx_t   const *pCnx;
+  uint8_t                                    nbAlgos;
+  uint8_t                                    nbChunks;
+  uint8_t                                    nbCnx;
+  memPool_t                                  algoMemPool;
+  memPool_t                                  chunkMemPool;
+} audio_chain_instance_static_graph_t;
+
+typedef struct
+{
+  bool                         bStaticGraph;    /* graph built by AudioChainInstance_initStaticGraph, else through acSdk/LiveTune */
+  uint32_t                     buildUs;         /* AudioChainInstance_initGraph duration */
+  uint32_t                     firstSampleUs;   /* from the start of AudioChainInstance_initGraph to the first audio run */
+} audio_chain_instance_boot_stats_t;
+
+typedef struct
+{
+  uint8_t                      nbAlgos;
+  uint8_t                      nbCritical;      /* algos a system output chunk depends on */
+  uint8_t                      nbLow;           /* algos processed in the low priority pass */
+  bool                         bMeasured;       /* false until cycles count measured the algos (see bLogCycles) */
+  uint32_t                     frameUs;         /* frame deadline: system output chunk duration, 0 if unknown */
+  uint32_t                     criticalUs;      /* normal priority pass worst-case latency (dataInOut included) */
+  uint32_t                     lowUs;           /* low priority pass worst-case latency (normal pass preemption included) */
+} audio_chain_instance_placement_t;
+
 /* Exported variables ------------------------------------------------------- */
 extern audio_chain_t           AudioChainInstance;
 
@@ -62,6 +148,20 @@ int32_t                        AudioChainInstance_getChunkAlgoOut(audio_chunk_t
 int32_t                        AudioChainInstance_getChunkAlgoIn(audio_chunk_t  *const pChunk, uint8_t *const pAlgoId, uint8_t *const pChunkId);
 void                           AudioChainInstance_run(void);
 void                           AudioChainInstance_idle(void);
+int32_t                        AudioChainInstance_optimizeChunksType(audio_chain_t *const pHdle);
+int32_t                        AudioChainInstance_aliasInPlaceChunks(audio_chain_t *const pHdle);
+int32_t                        AudioChainInstance_restoreInPlaceChunks(void);
+int32_t                        AudioChainInstance_swapGraphRequest(void (*const pInitGraphCb)(void));
+bool                           AudioChainInstance_isSwapGraphPending(void);
+bool                           AudioChainInstance_getSwapGraphStats(audio_chain_instance_swap_stats_t *const pStats);
+int32_t                        AudioChainInstance_initStaticGraph(audio_chain_instance_static_graph_t const *const pGraph);
+void                           AudioChainInstance_bootStart(void);
+void                           AudioChainInstance_bootGraphBuilt(void);
+bool                           AudioChainInstance_getBootStats(audio_chain_instance_boot_stats_t *const pStats);
+int32_t                        AudioChainInstance_placeAlgos(audio_chain_t *const pHdle);
+void                           AudioChainInstance_resetPlacement(void);
+bool                           AudioChainInstance_getPlacement(audio_chain_instance_placement_t *const pStats);
+bool                           AudioChainInstance_isCriticalAlgo(audio_algo_t *const pAlgo);
 
 /* Common error routine */
 void                           AudioChainInstance_error(const char *pFile, int const line, const char *pErrorMsg);
@@ -27,8 +27,81 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "audio_chain_tasks_conf.h"
+#include "audio_chain.h"
 
 /* Exported types ------------------------------------------------------------*/
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+
+#ifndef AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB
+  #define AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB 8UL /* last overruns kept per process task */
+#endif
+
+/* snapshot recorded when a process frame ends after its deadline (trigger time + run duration) */
+typedef struct
+{
+  uint32_t    frameId;                  /* index of the late frame since task creation */
+  uint32_t    deadlineCycles;           /* budget given to the frame */
+  uint32_t    elapsedCycles;            /* from trigger to end of processing */
+  char const *pLongestAlgoName;         /* algo which took most cycles in this frame, NULL if cycles count is disabled */
+  uint32_t    longestAlgoCycles;        /* from the end of the previous algo of the frame, preemptions included */
+  uint16_t    nbPreemptions;            /* higher priority audio chain runs during the frame */
+  uint8_t     processQueueLevel;        /* messages still pending in process queue */
+  uint8_t     processLowLevelQueueLevel;/* messages still pending in low-level process queue */
+} audio_chain_task_overrun_t;
+
+typedef enum
+{
+  AUDIO_CHAIN_TASK_DATAINOUT,
+  AUDIO_CHAIN_TASK_PROCESS,
+  AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL,
+  AUDIO_CHAIN_TASK_CONTROL,
+  AUDIO_CHAIN_TASK_NB
+} audio_chain_task_id_t;
+
+/* stack & queue sizing of a task, used at its next creation */
+typedef struct
+{
+  uint32_t stackSize;                   /* bytes */
+  uint32_t queueDeepness;               /* messages */
+} audio_chain_task_size_t;
+
+/* peak levels measured since last AudioChain_task_resetLevels (calibration run) */
+typedef struct
+{
+  audio_chain_task_size_t size;         /* sizing of the task when measured */
+  uint32_t                stackPeak;    /* bytes, 0 if stack high water mark is not available */
+  uint32_t                queuePeak;    /* messages */
+  bool                    bMeasured;    /* task ran during calibration */
+} audio_chain_task_levels_t;
+
+/* control task triggers coalescing: a trigger is merged if a control run is already queued since
+   AudioChain_control services all algos with the latest parameters */
+typedef struct
+{
+  uint32_t nbTriggers;                  /* control requests */
+  uint32_t nbMerged;                    /* requests merged into an already queued control run */
+  uint32_t nbQueueFullAvoided;          /* merged requests which would have found the queue full */
+} audio_chain_task_control_stats_t;
+
+#endif // AUDIO_CHAIN_TASKS_OS_USED
+
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+/* bare metal run-to-completion scheduler: control & low-level process run in the slack left by each process pass */
+typedef struct
+{
+  uint32_t nbFrames;                    /* process passes measured */
+  int32_t  deadline;                    /* us, frame budget from the process trigger */
+  int32_t  lastSlack;                   /* us, deadline minus the process pass duration of the last frame; 0 without deadline */
+  int32_t  minSlack;                    /* us, worst frame; negative when a process pass missed its deadline */
+  uint32_t nbUnderruns;                 /* process passes ended after their deadline */
+  uint32_t nbDeferred;                  /* slack work postponed because its peak duration didn't fit */
+  uint32_t nbForced;                    /* slack work run after AUDIO_CHAIN_TASKS_NO_OS_MAX_DEFERRALS deferrals */
+  uint32_t nbOverBudget;                /* slack work which ended after the frame deadline */
+  int32_t  processLowLevelPeak;         /* us, low-level process budget: longest run, slowly decaying, preemptions excluded */
+  int32_t  controlPeak;                 /* us, control budget: longest run, slowly decaying, preemptions excluded */
+} audio_chain_task_slack_stats_t;
+#endif // AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
@@ -50,6 +123,25 @@ void AudioChain_task_create_control(bool const logTaskQueueLevels);
 void AudioChain_task_trigger_control(void);
 void AudioChain_task_terminate_control(void);
 
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+void     AudioChain_task_setDeadline(uint32_t const runNs);
+uint32_t AudioChain_task_getOverruns(audio_capability_prio_level_t const prioLevel, audio_chain_task_overrun_t *const pSnapshots, uint32_t *const pNbSnapshots);
+
+void     AudioChain_task_setSizes(audio_chain_task_size_t        const pSizes[AUDIO_CHAIN_TASK_NB]);
+void     AudioChain_task_getSizes(audio_chain_task_size_t              pSizes[AUDIO_CHAIN_TASK_NB]);
+bool     AudioChain_task_persistSizes(audio_chain_task_size_t    const pSizes[AUDIO_CHAIN_TASK_NB]);
+void     AudioChain_task_resetLevels(void);
+void     AudioChain_task_getLevels(audio_chain_task_levels_t           pLevels[AUDIO_CHAIN_TASK_NB]);
+void     AudioChain_task_getControlStats(audio_chain_task_control_stats_t *const pStats);
+bool     AudioChain_task_getSizedConfig(uint32_t                 const marginPcent, audio_chain_task_size_t pSizes[AUDIO_CHAIN_TASK_NB]);
+#endif // AUDIO_CHAIN_TASKS_OS_USED
+
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+void     AudioChain_task_setDeadline(uint32_t const runNs);
+void     AudioChain_task_getSlackStats(audio_chain_task_slack_stats_t *const pStats);
+void     AudioChain_task_resetSlackStats(void);
+#endif // AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,11 +22,25 @@
 
 #ifdef AUDIO_CHAIN_TASKS_OS_USED
 
+#include <string.h>
 #include "st_os_hl.h"
+#include "cycles.h"
 
 /* Global variables ----------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
+#ifndef AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB
+  #define AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB        32UL  /* power of 2, must be >= queues deepness */
+#endif
+
+#ifndef AUDIO_CHAIN_TASKS_CONTROL_COALESCING
+  #define AUDIO_CHAIN_TASKS_CONTROL_COALESCING          1     /* merge control triggers while a control run is queued */
+#endif
+
+#ifndef AUDIO_CHAIN_TASKS_MIN_STACK_SIZE
+  #define AUDIO_CHAIN_TASKS_MIN_STACK_SIZE              512UL /* floor of calibrated stacks (bytes) */
+#endif
+
 /* Private macros ------------------------------------------------------------*/
 #ifndef AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS
   #define AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS      7UL
@@ -52,6 +66,10 @@
   #define AUDIO_CHAIN_CONTROL_TASK_STACK_SIZE           1024UL
 #endif
 
+#if (AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB < AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS) || (AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB < AUDIO_CHAIN_TASKS_LL_MESSAGE_QUEUE_DEEPNESS)
+  #error "AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB must be greater or equal to process queues deepness"
+#endif
+
 /* WARNING: if tasks cycles measure is used: audioCapture task and audioChain tasks must all have different priorities with FreeRTOS (tasks of same priority mustn't interrupt each other) */
 /* moreover, they must all have a higher priority than ST_OS_HL_TASK_BACKGROUND_PRIO */
 
@@ -72,6 +90,21 @@
 #endif
 
 
+typedef struct audio_chain_task_deadline
+{
+  audio_capability_prio_level_t          const prioLevel;
+  struct audio_chain_task_deadline const *const pHigherPrio;                                   /* process task preempting this one, if any */
+  uint32_t volatile                      nbTriggers;
+  uint32_t volatile                      nbFrames;
+  uint32_t                               triggerCycles[AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB]; /* trigger timestamps of queued frames */
+  uint32_t                               frameTriggerCycles;
+  uint32_t                               frameStartCycles;
+  uint32_t                               framePreemptions;
+  uint32_t                               nbOverruns;
+  audio_chain_task_overrun_t             snapshots[AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB];
+} audio_chain_task_deadline_t;
+
+
 /* Private function prototypes -----------------------------------------------*/
 static void s_audioChainDataInOut_Thread(ARGUMENT_TYPE       argument);
 static void s_audioChainProcess_Thread(ARGUMENT_TYPE         argument);
@@ -83,12 +116,41 @@ static void s_audioChain_process(uint16_t              const param, ARGUMENT_TYP
 static void s_audioChain_processLowLevel(uint16_t      const param, ARGUMENT_TYPE argument);
 static void s_audioChain_control(uint16_t              const param, ARGUMENT_TYPE argument);
 
+static void     s_deadline_trigger(audio_chain_task_deadline_t          *const pDeadline, void *const pHdle);
+static void     s_deadline_frameStart(audio_chain_task_deadline_t       *const pDeadline);
+static void     s_deadline_frameEnd(audio_chain_task_deadline_t         *const pDeadline);
+static uint32_t s_deadline_preemptions(audio_chain_task_deadline_t const *const pDeadline);
+static uint8_t  s_deadline_queueLevel(void                              *const pHdle);
+static uint32_t s_deadline_algoEnd(audio_chain_task_deadline_t    const *const pDeadline, audio_algo_t *const pAlgo, uint32_t const frameCycles);
+static uint32_t s_deadline_longestAlgo(audio_chain_task_deadline_t const *const pDeadline, uint32_t const frameEndCycles, char const **const ppName);
+
+static void     s_levels_record(audio_chain_task_id_t                   const id, void *const pHdle);
+static void     s_levels_reset(audio_chain_task_id_t                    const id, void *const pHdle);
+
 /* Private variables ---------------------------------------------------------*/
 static void *AudioChainDataInOut_Thread_handler       = NULL;
 static void *AudioChainProcess_Thread_handler         = NULL;
 static void *AudioChainProcessLowLevel_Thread_handler = NULL;
 static void *AudioChainControl_Thread_handler         = NULL;
 
+static uint32_t volatile           s_nbHighPrioRuns      = 0UL;  /* dataInOut and control runs, they preempt process tasks */
+static uint32_t                    s_deadlineCycles      = 0UL;  /* 0 if deadline monitoring is off */
+static audio_chain_task_deadline_t s_processDeadline     = {.prioLevel = AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_NORMAL, .pHigherPrio = NULL};
+static audio_chain_task_deadline_t s_processLowDeadline  = {.prioLevel = AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW,    .pHigherPrio = &s_processDeadline};
+
+static audio_chain_task_size_t     s_taskSizes[AUDIO_CHAIN_TASK_NB] =
+{
+  [AUDIO_CHAIN_TASK_DATAINOUT]         = {.stackSize = AUDIO_CHAIN_DATAINOUT_TASK_STACK_SIZE,         .queueDeepness = AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS},
+  [AUDIO_CHAIN_TASK_PROCESS]           = {.stackSize = AUDIO_CHAIN_PROCESS_TASK_STACK_SIZE,           .queueDeepness = AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS},
+  [AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL] = {.stackSize = AUDIO_CHAIN_PROCESS_LOW_LEVEL_TASK_STACK_SIZE, .queueDeepness = AUDIO_CHAIN_TASKS_LL_MESSAGE_QUEUE_DEEPNESS},
+  [AUDIO_CHAIN_TASK_CONTROL]           = {.stackSize = AUDIO_CHAIN_CONTROL_TASK_STACK_SIZE,           .queueDeepness = AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS}
+};
+static audio_chain_task_levels_t   s_taskLevels[AUDIO_CHAIN_TASK_NB];
+
+static bool volatile               s_controlPending      = false;  /* a control run is queued and not started yet */
+static uint32_t volatile           s_controlBurstLevel   = 0UL;    /* queue level the triggers merged since last run would have reached */
+static audio_chain_task_control_stats_t s_controlStats;
+
 /* Functions Definition ------------------------------------------------------*/
 
 static st_os_hl_msg_t const msg_process =
@@ -108,13 +170,16 @@ static st_os_hl_msg_t const msg_process =
 */
 void AudioChain_task_create_dataInOut(bool const logTaskQueueLevels)
 {
+  audio_chain_task_size_t const *const pSize = &s_taskSizes[AUDIO_CHAIN_TASK_DATAINOUT];
+
   if (AudioChainDataInOut_Thread_handler == NULL)
   {
+    s_taskLevels[AUDIO_CHAIN_TASK_DATAINOUT].size = *pSize;
     st_os_hl_task_create("AC_DataIO_Thread",                        // thread_name
                          "AC_DataIO_WakeMsg",                       // queue_name
-                         AUDIO_CHAIN_DATAINOUT_TASK_STACK_SIZE,     // stack_size
+                         pSize->stackSize,                          // stack_size
                          AUDIO_CHAIN_TASK_DATAINOUT_PRIO,           // priority
-                         AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS,  // queue_deepness
+                         pSize->queueDeepness,                      // queue_deepness
                          osWaitForever,                             // queue_timeout
                          s_audioChainDataInOut_Thread,              // thread_func
                          s_audioChain_dataInOut,                    // task_func
@@ -138,6 +203,7 @@ void AudioChain_task_create_dataInOut(bool const logTaskQueueLevels)
 */
 void AudioChain_task_terminate_dataInOut(void)
 {
+  s_levels_record(AUDIO_CHAIN_TASK_DATAINOUT, AudioChainDataInOut_Thread_handler);
   if (st_os_hl_task_terminate(&AudioChainDataInOut_Thread_handler, 1000UL))
   {
     AudioChainDataInOut_Thread_handler = NULL;
@@ -181,13 +247,16 @@ static void s_audioChainDataInOut_Thread(ARGUMENT_TYPE argument)
 */
 void AudioChain_task_create_process(bool const logTaskQueueLevels)
 {
+  audio_chain_task_size_t const *const pSize = &s_taskSizes[AUDIO_CHAIN_TASK_PROCESS];
+
   if (AudioChainProcess_Thread_handler == NULL)
   {
+    s_taskLevels[AUDIO_CHAIN_TASK_PROCESS].size = *pSize;
     st_os_hl_task_create("AC_Proc_Thread",                          // thread_name
                          "AC_Proc_WakeMsg",                         // queue_name
-                         AUDIO_CHAIN_PROCESS_TASK_STACK_SIZE,       // stack_size
+                         pSize->stackSize,                          // stack_size
                          AUDIO_CHAIN_TASK_PROCESS_PRIO,             // priority
-                         AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS,  // queue_deepness
+                         pSize->queueDeepness,                      // queue_deepness
                          osWaitForever,                             // queue_timeout
                          s_audioChainProcess_Thread,                // thread_func
                          s_audioChain_process,                      // task_func
@@ -217,6 +286,7 @@ void AudioChain_task_create_process(bool const logTaskQueueLevels)
 */
 void AudioChain_task_terminate_process(void)
 {
+  s_levels_record(AUDIO_CHAIN_TASK_PROCESS, AudioChainProcess_Thread_handler);
   if (st_os_hl_task_terminate(&AudioChainProcess_Thread_handler, 1000UL))
   {
     AudioChainProcess_Thread_handler = NULL;
@@ -241,7 +311,7 @@ void AudioChain_task_terminate_process(void)
 */
 void AudioChain_task_trigger_process(void)
 {
-  st_os_hl_task_trigger(AudioChainProcess_Thread_handler, msg_process);
+  s_deadline_trigger(&s_processDeadline, AudioChainProcess_Thread_handler);
 }
 
 
@@ -267,13 +337,16 @@ static void s_audioChainProcess_Thread(ARGUMENT_TYPE argument)
 */
 void AudioChain_task_create_process_lowlevel(bool const logTaskQueueLevels)
 {
+  audio_chain_task_size_t const *const pSize = &s_taskSizes[AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL];
+
   if (AudioChainProcessLowLevel_Thread_handler == NULL)
   {
+    s_taskLevels[AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL].size = *pSize;
     st_os_hl_task_create("AC_ProcLL_Thread",                            // thread_name
                          "AC_ProcLL_WakeMsg",                           // queue_name
-                         AUDIO_CHAIN_PROCESS_LOW_LEVEL_TASK_STACK_SIZE, // stack_size
+                         pSize->stackSize,                              // stack_size
                          AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL_PRIO,       // priority
-                         AUDIO_CHAIN_TASKS_LL_MESSAGE_QUEUE_DEEPNESS,   // queue_deepness
+                         pSize->queueDeepness,                          // queue_deepness
                          osWaitForever,                                 // queue_timeout
                          s_audioChainProcessLowLevel_Thread,            // thread_func
                          s_audioChain_processLowLevel,                  // task_func
@@ -297,6 +370,7 @@ void AudioChain_task_create_process_lowlevel(bool const logTaskQueueLevels)
 */
 void AudioChain_task_terminate_process_lowlevel(void)
 {
+  s_levels_record(AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL, AudioChainProcessLowLevel_Thread_handler);
   if (st_os_hl_task_terminate(&AudioChainProcessLowLevel_Thread_handler, 1000UL))
   {
     AudioChainProcessLowLevel_Thread_handler = NULL;
@@ -315,7 +389,7 @@ void AudioChain_task_terminate_process_lowlevel(void)
 */
 void AudioChain_task_trigger_process_lowlevel(void)
 {
-  st_os_hl_task_trigger(AudioChainProcessLowLevel_Thread_handler, msg_process);
+  s_deadline_trigger(&s_processLowDeadline, AudioChainProcessLowLevel_Thread_handler);
 }
 
 
@@ -341,13 +415,16 @@ static void s_audioChainProcessLowLevel_Thread(ARGUMENT_TYPE argument)
 */
 void AudioChain_task_create_control(bool const logTaskQueueLevels)
 {
+  audio_chain_task_size_t const *const pSize = &s_taskSizes[AUDIO_CHAIN_TASK_CONTROL];
+
   if (AudioChainControl_Thread_handler == NULL)
   {
+    s_taskLevels[AUDIO_CHAIN_TASK_CONTROL].size = *pSize;
     st_os_hl_task_create("AC_Control_Thread",                       // thread_name
                          "AC_Control_WakeMsg",                      // queue_name
-                         AUDIO_CHAIN_CONTROL_TASK_STACK_SIZE,       // stack_size
+                         pSize->stackSize,                          // stack_size
                          AUDIO_CHAIN_TASK_CONTROL_PRIO,             // priority
-                         AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS,  // queue_deepness
+                         pSize->queueDeepness,                      // queue_deepness
                          osWaitForever,                             // queue_timeout
                          s_audioChainControl_Thread,                // thread_func
                          s_audioChain_control,                      // task_func
@@ -371,6 +448,7 @@ void AudioChain_task_create_control(bool const logTaskQueueLevels)
 */
 void AudioChain_task_terminate_control(void)
 {
+  s_levels_record(AUDIO_CHAIN_TASK_CONTROL, AudioChainControl_Thread_handler);
   if (st_os_hl_task_terminate(&AudioChainControl_Thread_handler, 1000UL))
   {
     AudioChainControl_Thread_handler = NULL;
@@ -389,7 +467,41 @@ void AudioChain_task_terminate_control(void)
 */
 void AudioChain_task_trigger_control(void)
 {
-  st_os_hl_task_trigger(AudioChainControl_Thread_handler, msg_process);
+  bool     send      = true;
+  uint32_t sentLevel = 0UL;
+
+  ST_OS_DISABLE_IRQ();
+  s_controlStats.nbTriggers++;
+  #if AUDIO_CHAIN_TASKS_CONTROL_COALESCING
+  if (s_controlPending)
+  {
+    /* queued control run will apply this request too */
+    send = false;
+    s_controlBurstLevel++;
+    s_controlStats.nbMerged++;
+    if (s_controlBurstLevel > s_taskSizes[AUDIO_CHAIN_TASK_CONTROL].queueDeepness)
+    {
+      s_controlStats.nbQueueFullAvoided++;
+    }
+  }
+  else
+  {
+    s_controlPending    = true;
+    s_controlBurstLevel = 1UL;
+  }
+  sentLevel = s_controlBurstLevel;
+  #endif
+  ST_OS_ENABLE_IRQ();
+
+  while (send && !st_os_hl_task_trigger(AudioChainControl_Thread_handler, msg_process))
+  {
+    ST_OS_DISABLE_IRQ();
+    /* triggers merged since the failed send rely on it: send again for them, else nothing is queued anymore */
+    send             = (s_controlBurstLevel > sentLevel);
+    sentLevel        = s_controlBurstLevel;
+    s_controlPending = send;
+    ST_OS_ENABLE_IRQ();
+  }
 }
 
 
@@ -404,12 +516,391 @@ static void s_audioChainControl_Thread(ARGUMENT_TYPE argument)
 }
 
 
+/* ---------------------------------------------------------------------------*/
+/* Deadline API --------------------------------------------------------------*/
+/* ---------------------------------------------------------------------------*/
+
+/**
+* @brief  sets the deadline of process frames (relative to their trigger) and resets overrun records
+* @param  runNs run duration in ns (0 disables deadline monitoring)
+* @retval None
+*/
+void AudioChain_task_setDeadline(uint32_t const runNs)
+{
+  s_deadlineCycles                  = (uint32_t)(((uint64_t)runNs * (uint64_t)cycleMeasure_getSystemCoreClock()) / 1000000000ULL);
+  s_processDeadline.nbOverruns      = 0UL;
+  s_processLowDeadline.nbOverruns   = 0UL;
+}
+
+
+/**
+* @brief  copies the last overrun snapshots of a process task (oldest first)
+* @param  prioLevel    process task (normal or low-level)
+* @param  pSnapshots   output table of AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB entries
+* @param  pNbSnapshots returned number of valid entries
+* @retval total number of overruns since last AudioChain_task_setDeadline
+*/
+uint32_t AudioChain_task_getOverruns(audio_capability_prio_level_t const prioLevel, audio_chain_task_overrun_t *const pSnapshots, uint32_t *const pNbSnapshots)
+{
+  audio_chain_task_deadline_t const *const pDeadline = (prioLevel == AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW) ? &s_processLowDeadline : &s_processDeadline;
+  uint32_t                                 nbOverruns;
+  uint32_t                                 nbSnapshots;
+
+  st_os_lock_tasks();
+  nbOverruns  = pDeadline->nbOverruns;
+  nbSnapshots = (nbOverruns < AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB) ? nbOverruns : AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB;
+  for (uint32_t i = 0UL; i < nbSnapshots; i++)
+  {
+    pSnapshots[i] = pDeadline->snapshots[(nbOverruns - nbSnapshots + i) % AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB];
+  }
+  st_os_unlock_tasks();
+  *pNbSnapshots = nbSnapshots;
+
+  return nbOverruns;
+}
+
+
+/* ---------------------------------------------------------------------------*/
+/* Sizing API ----------------------------------------------------------------*/
+/* ---------------------------------------------------------------------------*/
+
+/**
+* @brief  returns control triggers coalescing counters
+* @param  pStats counters
+* @retval None
+*/
+void AudioChain_task_getControlStats(audio_chain_task_control_stats_t *const pStats)
+{
+  ST_OS_DISABLE_IRQ();
+  *pStats = s_controlStats;
+  ST_OS_ENABLE_IRQ();
+}
+
+
+/**
+* @brief  sets stack & queue sizes of the tasks; applied at their next creation, i.e. next graph init
+*         (typically sizes computed by AudioChain_task_getSizedConfig during a previous calibration run);
+*         sizes aren't kept across a reset unless stored by AudioChain_task_persistSizes and given back
+*         here at boot, or pasted in audio_chain_tasks_conf.h from the defines printed by the "tasksize" command
+* @param  pSizes sizes indexed by audio_chain_task_id_t
+* @retval None
+*/
+void AudioChain_task_setSizes(audio_chain_task_size_t const pSizes[AUDIO_CHAIN_TASK_NB])
+{
+  for (uint32_t id = 0UL; id < (uint32_t)AUDIO_CHAIN_TASK_NB; id++)
+  {
+    uint32_t const queueDeepness = (pSizes[id].queueDeepness == 0UL) ? 1UL : pSizes[id].queueDeepness;
+
+    /* deadline monitoring keeps one timestamp per queued frame */
+    s_taskSizes[id].queueDeepness = (queueDeepness > AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB) ? AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB : queueDeepness;
+    s_taskSizes[id].stackSize     = (pSizes[id].stackSize < AUDIO_CHAIN_TASKS_MIN_STACK_SIZE) ? AUDIO_CHAIN_TASKS_MIN_STACK_SIZE : pSizes[id].stackSize;
+  }
+}
+
+
+void AudioChain_task_getSizes(audio_chain_task_size_t pSizes[AUDIO_CHAIN_TASK_NB])
+{
+  memcpy(pSizes, s_taskSizes, sizeof(s_taskSizes));
+}
+
+
+/**
+* @brief  stores the tasks sizes in non volatile memory; to be redefined by the application (livetune
+*         stores them in its registry and gives them back to AudioChain_task_setSizes at boot)
+* @param  pSizes sizes indexed by audio_chain_task_id_t
+* @retval true if the sizes are kept across a reset
+*/
+__weak bool AudioChain_task_persistSizes(audio_chain_task_size_t const pSizes[AUDIO_CHAIN_TASK_NB])
+{
+  (void)pSizes;
+  return false;
+}
+
+
+/**
+* @brief  starts a calibration run: forgets stack & queue peaks measured so far, the sizing of the tasks is kept;
+*         queue peaks of running tasks restart from their current level but their stack peaks can't restart:
+*         they are the high water marks since the tasks creation until the tasks are created again (next graph init)
+* @param  None
+* @retval None
+*/
+void AudioChain_task_resetLevels(void)
+{
+  s_levels_reset(AUDIO_CHAIN_TASK_DATAINOUT,         AudioChainDataInOut_Thread_handler);
+  s_levels_reset(AUDIO_CHAIN_TASK_PROCESS,           AudioChainProcess_Thread_handler);
+  s_levels_reset(AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL, AudioChainProcessLowLevel_Thread_handler);
+  s_levels_reset(AUDIO_CHAIN_TASK_CONTROL,           AudioChainControl_Thread_handler);
+}
+
+
+/**
+* @brief  returns stack & queue peaks since last AudioChain_task_resetLevels, including running tasks
+* @param  pLevels levels indexed by audio_chain_task_id_t
+* @retval None
+*/
+void AudioChain_task_getLevels(audio_chain_task_levels_t pLevels[AUDIO_CHAIN_TASK_NB])
+{
+  s_levels_record(AUDIO_CHAIN_TASK_DATAINOUT,         AudioChainDataInOut_Thread_handler);
+  s_levels_record(AUDIO_CHAIN_TASK_PROCESS,           AudioChainProcess_Thread_handler);
+  s_levels_record(AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL, AudioChainProcessLowLevel_Thread_handler);
+  s_levels_record(AUDIO_CHAIN_TASK_CONTROL,           AudioChainControl_Thread_handler);
+  memcpy(pLevels, s_taskLevels, sizeof(s_taskLevels));
+}
+
+
+/**
+* @brief  computes tasks sizes from the peaks of the calibration run plus a safety margin;
+*         tasks which didn't run (or whose stack couldn't be measured) keep their current sizes
+* @param  marginPcent safety margin in percent of the peaks
+* @param  pSizes      returned sizes indexed by audio_chain_task_id_t
+* @retval true if all tasks which ran had their stack measured, else false
+*/
+bool AudioChain_task_getSizedConfig(uint32_t const marginPcent, audio_chain_task_size_t pSizes[AUDIO_CHAIN_TASK_NB])
+{
+  audio_chain_task_levels_t tLevels[AUDIO_CHAIN_TASK_NB];
+  bool                      allMeasured = true;
+
+  AudioChain_task_getLevels(tLevels);
+  for (uint32_t id = 0UL; id < (uint32_t)AUDIO_CHAIN_TASK_NB; id++)
+  {
+    audio_chain_task_levels_t const *const pLevels = &tLevels[id];
+
+    pSizes[id] = s_taskSizes[id];
+    if (pLevels->bMeasured)
+    {
+      uint32_t const queueMargin = ((pLevels->queuePeak * marginPcent) + 99UL) / 100UL;
+      uint32_t const queueSize   = pLevels->queuePeak + ((queueMargin == 0UL) ? 1UL : queueMargin);
+
+      pSizes[id].queueDeepness = (queueSize > AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB) ? AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB : queueSize;
+      if (pLevels->stackPeak != 0UL)
+      {
+        uint32_t const stackSize = ((pLevels->stackPeak + ((pLevels->stackPeak * marginPcent) / 100UL)) + 7UL) & ~7UL;  // 8 bytes stack alignment
+
+        pSizes[id].stackSize = (stackSize < AUDIO_CHAIN_TASKS_MIN_STACK_SIZE) ? AUDIO_CHAIN_TASKS_MIN_STACK_SIZE : stackSize;
+      }
+      else
+      {
+        allMeasured = false;
+      }
+    }
+  }
+
+  return allMeasured;
+}
+
+
 /* Private Functions Definition ------------------------------------------------------*/
 
+/**
+* @brief  forgets stack & queue peaks of a task, keeps its sizing
+* @param  id    task id
+* @param  pHdle task handle (NULL if task isn't running)
+* @retval None
+*/
+static void s_levels_reset(audio_chain_task_id_t const id, void *const pHdle)
+{
+  audio_chain_task_levels_t *const pLevels = &s_taskLevels[id];
+
+  pLevels->stackPeak = 0UL;
+  pLevels->queuePeak = 0UL;
+  pLevels->bMeasured = false;
+  st_os_hl_task_reset_queue_max(pHdle);
+}
+
+
+/**
+* @brief  updates stack & queue peaks of a task; must be called before the task is terminated
+* @param  id    task id
+* @param  pHdle task handle (NULL if task isn't running)
+* @retval None
+*/
+static void s_levels_record(audio_chain_task_id_t const id, void *const pHdle)
+{
+  if (pHdle != NULL)
+  {
+    audio_chain_task_levels_t *const pLevels = &s_taskLevels[id];
+    uint32_t                         stackFree;
+    uint32_t                         queuePeak;
+
+    if (st_os_hl_task_get_levels(pHdle, &stackFree, &queuePeak) && (stackFree <= pLevels->size.stackSize))
+    {
+      uint32_t const stackPeak = pLevels->size.stackSize - stackFree;
+
+      pLevels->stackPeak = (stackPeak > pLevels->stackPeak) ? stackPeak : pLevels->stackPeak;
+    }
+    pLevels->queuePeak = (queuePeak > pLevels->queuePeak) ? queuePeak : pLevels->queuePeak;
+    pLevels->bMeasured = true;
+  }
+}
+
+
+/**
+* @brief  timestamps the frame and sends it to the process task
+* @param  pDeadline deadline context of the process task
+* @param  pHdle     process task handle
+* @retval None
+*/
+static void s_deadline_trigger(audio_chain_task_deadline_t *const pDeadline, void *const pHdle)
+{
+  /* timestamp is written before the trigger since process task may run at once; frame is counted only if queued */
+  pDeadline->triggerCycles[pDeadline->nbTriggers & (AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB - 1UL)] = cycleMeasure_currentCycles();
+  if (st_os_hl_task_trigger(pHdle, msg_process))
+  {
+    pDeadline->nbTriggers++;
+  }
+}
+
+
+/**
+* @brief  number of higher priority audio chain runs so far
+* @param  pDeadline deadline context of the process task
+* @retval counter
+*/
+static uint32_t s_deadline_preemptions(audio_chain_task_deadline_t const *const pDeadline)
+{
+  uint32_t nbRuns = s_nbHighPrioRuns;
+
+  if (pDeadline->pHigherPrio != NULL)
+  {
+    nbRuns += pDeadline->pHigherPrio->nbFrames;
+  }
+  return nbRuns;
+}
+
+
+/**
+* @brief  number of frames waiting in the queue of a process task
+* @param  pHdle process task handle
+* @retval queue level
+*/
+static uint8_t s_deadline_queueLevel(void *const pHdle)
+{
+  uint32_t const level = st_os_hl_task_get_queue_level(pHdle);
+
+  return (level > 0xFFUL) ? 0xFFU : (uint8_t)level;
+}
+
+
+/**
+* @brief  end of the last process measure of an algo, if it ran in the current frame of the process task
+* @param  pDeadline   deadline context of the process task
+* @param  pAlgo       algo
+* @param  frameCycles cycles from frame start to frame end
+* @retval cycles from frame start to the algo end, 0 if the algo didn't run in this frame
+*/
+static uint32_t s_deadline_algoEnd(audio_chain_task_deadline_t const *const pDeadline, audio_algo_t *const pAlgo, uint32_t const frameCycles)
+{
+  uint32_t algoEnd = 0UL;
+
+  if (AudioAlgo_getPrioLevel(pAlgo) == pDeadline->prioLevel)
+  {
+    CycleStatsTypeDef const *const pStats = AudioAlgo_getProcessCyclesMgntStats(pAlgo);
+
+    /* lastCycles holds the stop timestamp of a measure which is not running */
+    if ((pStats != NULL) && (pStats->nextState == START_CYCLES) && (pStats->current.count != 0UL))
+    {
+      algoEnd = pStats->lastCycles - pDeadline->frameStartCycles;
+      algoEnd = (algoEnd <= frameCycles) ? algoEnd : 0UL;
+    }
+  }
+  return algoEnd;
+}
+
+
+/**
+* @brief  returns the algo which took most cycles in the frame that just ended; only called for late frames
+*         so that on-time frames don't walk the algos list. Algos of a process task run one after the
+*         other, the duration of an algo is taken from the end of the algo which ended just before it
+*         (or from the frame start), preemptions included
+* @param  pDeadline      deadline context of the process task
+* @param  frameEndCycles frame end timestamp
+* @param  ppName         returned algo instance name (NULL if no cycles were measured)
+* @retval cycles of the longest algo
+*/
+static uint32_t s_deadline_longestAlgo(audio_chain_task_deadline_t const *const pDeadline, uint32_t const frameEndCycles, char const **const ppName)
+{
+  uint32_t           const frameCycles   = frameEndCycles - pDeadline->frameStartCycles;
+  uint32_t                 longestCycles = 0UL;
+  audio_algo_list_t *const pAlgosList    = AudioChain_getAlgosList(&AudioChainInstance);
+  audio_algo_list_t       *pAlgoList;
+
+  *ppName = NULL;
+  for (pAlgoList = pAlgosList; pAlgoList != NULL; pAlgoList = pAlgoList->next)
+  {
+    uint32_t const algoEnd = s_deadline_algoEnd(pDeadline, pAlgoList->pAlgo, frameCycles);
+
+    if (algoEnd != 0UL)
+    {
+      uint32_t           algoStart = 0UL;
+      audio_algo_list_t *pPrevList;
+
+      for (pPrevList = pAlgosList; pPrevList != NULL; pPrevList = pPrevList->next)
+      {
+        uint32_t const prevEnd = s_deadline_algoEnd(pDeadline, pPrevList->pAlgo, frameCycles);
+
+        algoStart = ((prevEnd < algoEnd) && (prevEnd > algoStart)) ? prevEnd : algoStart;
+      }
+      if ((algoEnd - algoStart) > longestCycles)
+      {
+        longestCycles = algoEnd - algoStart;
+        *ppName       = AudioAlgo_getInstanceName(pAlgoList->pAlgo);
+      }
+    }
+  }
+
+  return longestCycles;
+}
+
+
+/**
+* @brief  starts a process frame
+* @param  pDeadline deadline context of the process task
+* @retval None
+*/
+static void s_deadline_frameStart(audio_chain_task_deadline_t *const pDeadline)
+{
+  pDeadline->frameTriggerCycles = pDeadline->triggerCycles[pDeadline->nbFrames & (AUDIO_CHAIN_TASKS_DEADLINE_TRIGGERS_NB - 1UL)];
+  pDeadline->framePreemptions   = s_deadline_preemptions(pDeadline);
+  pDeadline->frameStartCycles   = cycleMeasure_currentCycles();
+}
+
+
+/**
+* @brief  ends a process frame and records a snapshot if its deadline is missed
+* @param  pDeadline deadline context of the process task
+* @retval None
+*/
+static void s_deadline_frameEnd(audio_chain_task_deadline_t *const pDeadline)
+{
+  uint32_t const frameEndCycles = cycleMeasure_currentCycles();
+  uint32_t const elapsedCycles  = frameEndCycles - pDeadline->frameTriggerCycles;
+
+  pDeadline->nbFrames++;
+  if ((s_deadlineCycles != 0UL) && (elapsedCycles > s_deadlineCycles))
+  {
+    audio_chain_task_overrun_t *const pSnapshot = &pDeadline->snapshots[pDeadline->nbOverruns % AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB];
+    char const                       *pLongestAlgoName;
+    uint32_t                    const longestCycles = s_deadline_longestAlgo(pDeadline, frameEndCycles, &pLongestAlgoName);
+
+    pSnapshot->frameId                   = pDeadline->nbFrames - 1UL;
+    pSnapshot->deadlineCycles            = s_deadlineCycles;
+    pSnapshot->elapsedCycles             = elapsedCycles;
+    pSnapshot->pLongestAlgoName          = pLongestAlgoName;
+    pSnapshot->longestAlgoCycles         = longestCycles;
+    pSnapshot->nbPreemptions             = (uint16_t)(s_deadline_preemptions(pDeadline) - pDeadline->framePreemptions);
+    pSnapshot->processQueueLevel         = s_deadline_queueLevel(AudioChainProcess_Thread_handler);
+    pSnapshot->processLowLevelQueueLevel = s_deadline_queueLevel(AudioChainProcessLowLevel_Thread_handler);
+    pDeadline->nbOverruns++;
+  }
+}
+
+
 static void s_audioChain_dataInOut(uint16_t const param, ARGUMENT_TYPE argument)
 {
   int32_t error = AudioChain_dataInOut(&AudioChainInstance);
 
+  s_nbHighPrioRuns++;
+
   if (AudioError_isError(error))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_dataInOut error");
@@ -427,29 +918,42 @@ static void s_audioChain_process(uint16_t const param, ARGUMENT_TYPE argument)
     AudioChain_task_trigger_process_lowlevel();
   }
 
+  s_deadline_frameStart(&s_processDeadline);
   error = AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_NORMAL);
   if (AudioError_isError(error))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_process error");
   }
+  s_deadline_frameEnd(&s_processDeadline);
 }
 
 
 static void s_audioChain_processLowLevel(uint16_t const param, ARGUMENT_TYPE argument)
 {
-  int32_t error = AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW);
+  int32_t error;
 
+  s_deadline_frameStart(&s_processLowDeadline);
+  error = AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW);
   if (AudioError_isError(error))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_process low-level error");
   }
+  s_deadline_frameEnd(&s_processLowDeadline);
 }
 
 
 static void s_audioChain_control(uint16_t const param, ARGUMENT_TYPE argument)
 {
-  int32_t error = AudioChain_control(&AudioChainInstance);
+  int32_t error;
+
+  /* triggers received from now on need a new run */
+  ST_OS_DISABLE_IRQ();
+  s_controlPending    = false;
+  s_controlBurstLevel = 0UL;
+  ST_OS_ENABLE_IRQ();
 
+  error = AudioChain_control(&AudioChainInstance);
+  s_nbHighPrioRuns++;
   if (AudioError_isError(error))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_control error");
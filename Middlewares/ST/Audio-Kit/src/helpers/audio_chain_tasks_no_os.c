@@ -20,9 +20,50 @@
 #include "audio_chain_instance.h"
 #include "audio_chain_tasks.h"
 #ifndef AUDIO_CHAIN_TASKS_OS_USED
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+#include <string.h>
+#include "cycles.h"
+#include "irq_utils.h"
+#endif
 /* Global variables ----------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+typedef enum
+{
+  AUDIO_CHAIN_SLACK_WORK_PROCESS_LOW_LEVEL,                 /* first: it carries audio */
+  AUDIO_CHAIN_SLACK_WORK_CONTROL,
+  AUDIO_CHAIN_SLACK_WORK_NB
+} audio_chain_slack_work_id_t;
+
+/* work run to completion in the slack left by the process pass */
+typedef struct
+{
+  uint8_t  volatile nbPending;                              /* triggers not served yet */
+  uint8_t           nbDeferrals;                            /* consecutive slacks too short for this work */
+  uint32_t          peakCycles;                             /* budget needed to start it: longest run, slowly decaying */
+  void            (*pRun)(void);
+} audio_chain_slack_work_t;
+
+typedef struct
+{
+  bool                     volatile bStarted;               /* process pass running: control goes through the slack */
+  uint32_t                 volatile triggerCycles;          /* start of the current frame */
+  uint32_t                          deadlineCycles;         /* 0: no budget, slack work runs unconditionally */
+  uint32_t                 volatile preemptCycles;          /* time spent in the dataInOut & process IRQs, not charged to the slack work they preempt */
+  audio_chain_slack_work_t          work[AUDIO_CHAIN_SLACK_WORK_NB];
+  audio_chain_task_slack_stats_t    stats;                  /* in cycles, converted by AudioChain_task_getSlackStats */
+} audio_chain_slack_scheduler_t;
+#endif
+
 /* Private defines -----------------------------------------------------------*/
+#ifndef AUDIO_CHAIN_TASKS_NO_OS_MAX_DEFERRALS
+  #define AUDIO_CHAIN_TASKS_NO_OS_MAX_DEFERRALS 4U          /* slacks skipped before a work is forced whatever its budget */
+#endif
+
+#ifndef AUDIO_CHAIN_TASKS_NO_OS_PEAK_DECAY_SHIFT
+  #define AUDIO_CHAIN_TASKS_NO_OS_PEAK_DECAY_SHIFT 5U       /* a shorter run brings the work budget 1/32 of the way down to it */
+#endif
+
 /* Private macros ------------------------------------------------------------*/
 
 
@@ -42,7 +83,6 @@
   #define AUDIO_CHAIN_TASK_CONTROL_PRIO 9UL
 #endif
 
-/* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
 void AudioChain_control_IRQHandler(void);
@@ -50,6 +90,26 @@ void AudioChain_process_IRQHandler(void);
 void AudioChain_process_lowlevel_IRQHandler(void);
 void AudioChain_dataInOut_IRQHandler(void);
 
+static void s_run_control(void);
+static void s_run_process_lowlevel(void);
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+static void s_slack_post(audio_chain_slack_work_id_t const id);
+static void s_slack_run(void);
+static int32_t s_slack_toUs(int32_t const cycles);
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+static audio_chain_slack_scheduler_t s_slack =
+{
+  .work =
+  {
+    [AUDIO_CHAIN_SLACK_WORK_PROCESS_LOW_LEVEL] = {.pRun = s_run_process_lowlevel},
+    [AUDIO_CHAIN_SLACK_WORK_CONTROL]           = {.pRun = s_run_control}
+  }
+};
+#endif
+
 
 /* Functions Definition ------------------------------------------------------*/
 
@@ -70,11 +130,19 @@ void AudioChain_task_trigger_dataInOut(void)
 */
 void AudioChain_dataInOut_IRQHandler(void)
 {
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  uint32_t const startCycles = cycleMeasure_currentCycles();
+  #endif
+
   NVIC_ClearPendingIRQ(AudioChain_dataInOut_IRQ);
   if (AudioError_isError(AudioChain_dataInOut(&AudioChainInstance)))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_dataInOut_IRQHandler error");
   }
+
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  s_slack.preemptCycles += cycleMeasure_currentCycles() - startCycles;
+  #endif
 }
 
 /**
@@ -106,6 +174,9 @@ void AudioChain_task_terminate_dataInOut(void)
 */
 void AudioChain_task_trigger_process(void)
 {
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  s_slack.triggerCycles = cycleMeasure_currentCycles();
+  #endif
   if (((uint32_t)AudioChain_getPrioLevel(&AudioChainInstance) & (uint32_t)AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW) != 0UL)
   {
     AudioChain_task_trigger_process_lowlevel();
@@ -120,12 +191,51 @@ void AudioChain_task_trigger_process(void)
 */
 void AudioChain_process_IRQHandler(void)
 {
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  uint32_t const startCycles  = cycleMeasure_currentCycles();
+  uint32_t const preemptStart = s_slack.preemptCycles;
+  #endif
+
   NVIC_ClearPendingIRQ(AudioChain_process_IRQ);
 
   if (AudioError_isError(AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_NORMAL)))
   {
     AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_process error");
   }
+
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  {
+    uint32_t const endCycles = cycleMeasure_currentCycles();
+
+    /* without deadline there is no slack: stats stay at 0 */
+    if (s_slack.deadlineCycles != 0UL)
+    {
+      int32_t const slackCycles = (int32_t)(s_slack.deadlineCycles - (endCycles - s_slack.triggerCycles));
+
+      s_slack.stats.lastSlack = slackCycles;
+      if ((s_slack.stats.nbFrames == 0UL) || (slackCycles < s_slack.stats.minSlack))
+      {
+        s_slack.stats.minSlack = slackCycles;
+      }
+      if (slackCycles < 0L)
+      {
+        s_slack.stats.nbUnderruns++;
+      }
+    }
+    s_slack.stats.nbFrames++;
+    /* a dataInOut pass nested in this one is already accounted */
+    s_slack.preemptCycles += (endCycles - startCycles) - (s_slack.preemptCycles - preemptStart);
+
+    /* control & low-level work start once the frame is produced */
+    for (uint8_t id = 0U; id < (uint8_t)AUDIO_CHAIN_SLACK_WORK_NB; id++)
+    {
+      if (s_slack.work[id].nbPending != 0U)
+      {
+        NVIC_SetPendingIRQ(AudioChain_process_lowlevel_IRQ);
+      }
+    }
+  }
+  #endif
 }
 
 /**
@@ -135,10 +245,16 @@ void AudioChain_process_IRQHandler(void)
 */
 void AudioChain_task_create_process(bool const logCmsisOs)
 {
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  /* the low-level IRQ runs the slack work, control included, even without low priority algos */
+  AudioChain_task_create_process_lowlevel(logCmsisOs);
+  s_slack.bStarted = true;
+  #else
   if (((uint32_t)AudioChain_getPrioLevel(&AudioChainInstance) & (uint32_t)AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW) != 0UL)
   {
     AudioChain_task_create_process_lowlevel(logCmsisOs);
   }
+  #endif
   HAL_NVIC_SetPriority(AudioChain_process_IRQ, AUDIO_CHAIN_TASK_PROCESS_PRIO, 0);
   HAL_NVIC_EnableIRQ(AudioChain_process_IRQ);
 }
@@ -152,6 +268,18 @@ void AudioChain_task_terminate_process(void)
 {
   HAL_NVIC_SetPriority(AudioChain_process_IRQ, 0x0F, 0);
   HAL_NVIC_DisableIRQ(AudioChain_process_IRQ);
+
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  AudioChain_task_terminate_process_lowlevel();
+  s_slack.bStarted = false;
+  s_slack.work[AUDIO_CHAIN_SLACK_WORK_PROCESS_LOW_LEVEL].nbPending = 0U;
+  if (s_slack.work[AUDIO_CHAIN_SLACK_WORK_CONTROL].nbPending != 0U)
+  {
+    /* no more frames: pending control requests get back their own IRQ */
+    s_slack.work[AUDIO_CHAIN_SLACK_WORK_CONTROL].nbPending = 0U;
+    NVIC_SetPendingIRQ(AudioChain_control_IRQ);
+  }
+  #endif
 }
 
 
@@ -162,7 +290,16 @@ void AudioChain_task_terminate_process(void)
 */
 void AudioChain_task_trigger_control(void)
 {
-  NVIC_SetPendingIRQ(AudioChain_control_IRQ);
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  if (s_slack.bStarted)
+  {
+    s_slack_post(AUDIO_CHAIN_SLACK_WORK_CONTROL);
+  }
+  else
+  #endif
+  {
+    NVIC_SetPendingIRQ(AudioChain_control_IRQ);
+  }
 }
 
 /**
@@ -174,10 +311,7 @@ void AudioChain_task_trigger_control(void)
 void AudioChain_control_IRQHandler(void)
 {
   NVIC_ClearPendingIRQ(AudioChain_control_IRQ);
-  if (AudioError_isError(AudioChain_control(&AudioChainInstance)))
-  {
-    AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_control error");
-  }
+  s_run_control();
 }
 
 /**
@@ -210,7 +344,11 @@ void AudioChain_task_terminate_control(void)
 */
 void AudioChain_task_trigger_process_lowlevel(void)
 {
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  s_slack_post(AUDIO_CHAIN_SLACK_WORK_PROCESS_LOW_LEVEL); // run after the normal process pass
+  #else
   NVIC_SetPendingIRQ(AudioChain_process_lowlevel_IRQ);
+  #endif
 }
 
 /**
@@ -222,10 +360,11 @@ void AudioChain_process_lowlevel_IRQHandler(void)
 {
   NVIC_ClearPendingIRQ(AudioChain_process_lowlevel_IRQ);
 
-  if (AudioError_isError(AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW)))
-  {
-    AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_process low-level error");
-  }
+  #ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+  s_slack_run();
+  #else
+  s_run_process_lowlevel();
+  #endif
 }
 
 /**
@@ -249,9 +388,157 @@ void AudioChain_task_terminate_process_lowlevel(void)
   HAL_NVIC_SetPriority(AudioChain_process_lowlevel_IRQ, 0x0F, 0);
   HAL_NVIC_DisableIRQ(AudioChain_process_lowlevel_IRQ);
 }
+
 #else
 #error "process is now split into two priority level, please complete your audio_chain_tasks_conf.h with AudioChain_process_lowlevel_IRQHandler definition"
 #endif
 
+
+static void s_run_control(void)
+{
+  if (AudioError_isError(AudioChain_control(&AudioChainInstance)))
+  {
+    AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_control error");
+  }
+}
+
+
+static void s_run_process_lowlevel(void)
+{
+  if (AudioError_isError(AudioChain_process(&AudioChainInstance, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW)))
+  {
+    AudioChain_error(&AudioChainInstance, __FILE__, __LINE__, "AudioChain_process low-level error");
+  }
+}
+
+
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+/* ---------------------------------------------------------------------------*/
+/* Slack scheduler -----------------------------------------------------------*/
+/* ---------------------------------------------------------------------------*/
+
+/**
+* @brief  sets the deadline of process frames (relative to their trigger) and resets slack stats
+* @param  runNs run duration in ns (0 disables budgets: slack work runs as soon as the process pass ends)
+* @retval None
+*/
+void AudioChain_task_setDeadline(uint32_t const runNs)
+{
+  s_slack.deadlineCycles = (uint32_t)(((uint64_t)runNs * (uint64_t)cycleMeasure_getSystemCoreClock()) / 1000000000ULL);
+  AudioChain_task_resetSlackStats();
+}
+
+
+/**
+* @brief  returns per-frame slack stats in us since last reset
+* @param  pStats stats
+* @retval None
+*/
+void AudioChain_task_getSlackStats(audio_chain_task_slack_stats_t *const pStats)
+{
+  disable_irq_with_cnt();
+  *pStats = s_slack.stats;
+  enable_irq_with_cnt();
+
+  pStats->deadline                = s_slack_toUs((int32_t)s_slack.deadlineCycles);
+  pStats->lastSlack               = s_slack_toUs(pStats->lastSlack);
+  pStats->minSlack                = s_slack_toUs(pStats->minSlack);
+  pStats->processLowLevelPeak     = s_slack_toUs((int32_t)s_slack.work[AUDIO_CHAIN_SLACK_WORK_PROCESS_LOW_LEVEL].peakCycles);
+  pStats->controlPeak             = s_slack_toUs((int32_t)s_slack.work[AUDIO_CHAIN_SLACK_WORK_CONTROL].peakCycles);
+}
+
+
+/**
+* @brief  resets slack stats; the measured work budgets are kept
+* @param  None
+* @retval None
+*/
+void AudioChain_task_resetSlackStats(void)
+{
+  disable_irq_with_cnt();
+  memset(&s_slack.stats, 0, sizeof(s_slack.stats));
+  enable_irq_with_cnt();
+}
+
+
+static void s_slack_post(audio_chain_slack_work_id_t const id)
+{
+  disable_irq_with_cnt();
+  if (s_slack.work[id].nbPending < UINT8_MAX)
+  {
+    s_slack.work[id].nbPending++;
+  }
+  enable_irq_with_cnt();
+}
+
+
+/**
+* @brief  runs pending work to completion while its peak duration fits before the frame deadline;
+*         work that doesn't fit waits for a later slack, at most AUDIO_CHAIN_TASKS_NO_OS_MAX_DEFERRALS times
+* @param  None
+* @retval None
+*/
+static void s_slack_run(void)
+{
+  for (uint8_t id = 0U; id < (uint8_t)AUDIO_CHAIN_SLACK_WORK_NB; id++)
+  {
+    audio_chain_slack_work_t *const pWork = &s_slack.work[id];
+    bool                            fits  = true;
+
+    while ((pWork->nbPending != 0U) && fits)
+    {
+      uint32_t const elapsed   = cycleMeasure_currentCycles() - s_slack.triggerCycles;
+      uint32_t const remaining = (elapsed < s_slack.deadlineCycles) ? (s_slack.deadlineCycles - elapsed) : 0UL;
+
+      fits = (s_slack.deadlineCycles == 0UL) || (pWork->peakCycles <= remaining);
+      if (fits || (pWork->nbDeferrals >= AUDIO_CHAIN_TASKS_NO_OS_MAX_DEFERRALS))
+      {
+        uint32_t const start        = cycleMeasure_currentCycles();
+        uint32_t const preemptStart = s_slack.preemptCycles;
+        uint32_t       cycles;
+
+        if (!fits)
+        {
+          s_slack.stats.nbForced++;
+        }
+        pWork->pRun();
+        /* own duration: the process & dataInOut passes which preempted the work don't count */
+        cycles = (cycleMeasure_currentCycles() - start) - (s_slack.preemptCycles - preemptStart);
+        if (cycles > pWork->peakCycles)
+        {
+          pWork->peakCycles = cycles;
+        }
+        else
+        {
+          /* a longer run once (cache misses, other IRQs) must not defer this work forever */
+          pWork->peakCycles -= (pWork->peakCycles - cycles) >> AUDIO_CHAIN_TASKS_NO_OS_PEAK_DECAY_SHIFT;
+        }
+        if ((s_slack.deadlineCycles != 0UL) && ((cycleMeasure_currentCycles() - s_slack.triggerCycles) > s_slack.deadlineCycles))
+        {
+          s_slack.stats.nbOverBudget++;
+        }
+        disable_irq_with_cnt();
+        pWork->nbPending--;
+        enable_irq_with_cnt();
+        pWork->nbDeferrals = 0U;
+        fits               = true;
+      }
+      else
+      {
+        /* retried after the next process pass */
+        pWork->nbDeferrals++;
+        s_slack.stats.nbDeferred++;
+      }
+    }
+  }
+}
+
+
+static int32_t s_slack_toUs(int32_t const cycles)
+{
+  return (int32_t)(((int64_t)cycles * 1000000LL) / (int64_t)cycleMeasure_getSystemCoreClock());
+}
+#endif // AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+
 #endif  /*AUDIO_CHAIN_TASKS_OS_USED*/
 
@@ -24,7 +24,10 @@
 #include "string.h"
 #include "st_os_monitor_cpu.h"
 #include "audio_chain_instance.h"
+#include "audio_chain_tasks.h"
+#include "passthrough/audio_chain_passThrough.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifndef CPU_MONITOR__TASK_NAME
@@ -246,6 +249,339 @@ static void stm32_term_acsdk_cpu(int argc, char *argv[])
 
 
 
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+/**
+* @brief  print the last process frames which missed their deadline
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_overrun(int argc, char *argv[])
+{
+  static audio_capability_prio_level_t const tPrioLevels[] = {AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_NORMAL, AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW};
+  static char                          const *tTaskNames[] = {"process", "process low-level"};
+  audio_chain_task_overrun_t                  tSnapshots[AUDIO_CHAIN_TASKS_OVERRUN_SNAPSHOTS_NB];
+
+  for (uint32_t task = 0UL; task < (sizeof(tPrioLevels) / sizeof(tPrioLevels[0])); task++)
+  {
+    uint32_t       nbSnapshots;
+    uint32_t const nbOverruns = AudioChain_task_getOverruns(tPrioLevels[task], tSnapshots, &nbSnapshots);
+
+    UTIL_TERM_printf("%s task: %lu overrun(s)\n", tTaskNames[task], nbOverruns);
+    for (uint32_t i = 0UL; i < nbSnapshots; i++)
+    {
+      audio_chain_task_overrun_t const *const pSnapshot = &tSnapshots[i];
+
+      UTIL_TERM_printf("  frame %lu: %lu/%lu cycles, longest algo %s (%lu cycles), %u preemption(s), queues %u/%u\n",
+                       pSnapshot->frameId,
+                       pSnapshot->elapsedCycles,
+                       pSnapshot->deadlineCycles,
+                       (pSnapshot->pLongestAlgoName != NULL) ? pSnapshot->pLongestAlgoName : "n/a",
+                       pSnapshot->longestAlgoCycles,
+                       pSnapshot->nbPreemptions,
+                       pSnapshot->processQueueLevel,
+                       pSnapshot->processLowLevelQueueLevel);
+    }
+  }
+}
+
+
+/**
+* @brief  print control task triggers coalescing counters
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_control(int argc, char *argv[])
+{
+  audio_chain_task_control_stats_t stats;
+
+  AudioChain_task_getControlStats(&stats);
+  UTIL_TERM_printf("control requests: %lu, merged: %lu, queue full avoided: %lu\n", stats.nbTriggers, stats.nbMerged, stats.nbQueueFullAvoided);
+}
+
+
+/**
+* @brief  calibration of tasks stacks & queues: "reset" starts a calibration run, "apply [margin]" sets
+*         the sized configuration for the tasks next creation (next graph init) and stores it when the
+*         application supports it (AudioChain_task_persistSizes), otherwise prints the peaks
+*         measured so far and the sized configuration with the given margin (default 20 %)
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_tasksize(int argc, char *argv[])
+{
+  static char const *const  tTaskNames[AUDIO_CHAIN_TASK_NB] = {"dataInOut", "process", "process low-level", "control"};
+  audio_chain_task_levels_t tLevels[AUDIO_CHAIN_TASK_NB];
+  audio_chain_task_size_t   tSizes[AUDIO_CHAIN_TASK_NB];
+  uint32_t                  marginPcent = 20UL;
+
+  if ((argc >= 2) && (strcmp(argv[1], "reset") == 0))
+  {
+    AudioChain_task_resetLevels();
+    UTIL_TERM_printf_cr("Calibration started (stack peaks of running tasks restart at next graph init)");
+  }
+  else if ((argc >= 2) && (strcmp(argv[1], "apply") == 0))
+  {
+    if (argc >= 3)
+    {
+      marginPcent = (uint32_t)strtoul(argv[2], NULL, 10);
+    }
+    (void)AudioChain_task_getSizedConfig(marginPcent, tSizes);
+    AudioChain_task_setSizes(tSizes);
+    if (AudioChain_task_persistSizes(tSizes))
+    {
+      UTIL_TERM_printf_cr("Sized configuration applied at next graph init and stored");
+    }
+    else
+    {
+      UTIL_TERM_printf_cr("Sized configuration applied at next graph init, lost at reset: paste the defines in audio_chain_tasks_conf.h to keep it");
+    }
+  }
+  else
+  {
+    bool     allMeasured;
+    uint32_t queueDeepness;
+
+    if (argc >= 2)
+    {
+      marginPcent = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+    AudioChain_task_getLevels(tLevels);
+    allMeasured = AudioChain_task_getSizedConfig(marginPcent, tSizes);
+    for (uint32_t id = 0UL; id < (uint32_t)AUDIO_CHAIN_TASK_NB; id++)
+    {
+      audio_chain_task_levels_t const *const pLevels = &tLevels[id];
+
+      if (pLevels->bMeasured)
+      {
+        UTIL_TERM_printf("%-18s: stack %5lu / %5lu -> %5lu bytes, queue %2lu / %2lu -> %2lu\n",
+                         tTaskNames[id],
+                         pLevels->stackPeak,
+                         pLevels->size.stackSize,
+                         tSizes[id].stackSize,
+                         pLevels->queuePeak,
+                         pLevels->size.queueDeepness,
+                         tSizes[id].queueDeepness);
+      }
+      else
+      {
+        UTIL_TERM_printf("%-18s: not run, kept %5lu bytes, queue %2lu\n", tTaskNames[id], tSizes[id].stackSize, tSizes[id].queueDeepness);
+      }
+    }
+    if (!allMeasured)
+    {
+      UTIL_TERM_printf_cr("stack high water mark not available (INCLUDE_uxTaskGetStackHighWaterMark), stacks kept");
+    }
+
+    /* sized configuration to paste in audio_chain_tasks_conf.h; queues of dataInOut/process/control share one define */
+    queueDeepness = (tSizes[AUDIO_CHAIN_TASK_DATAINOUT].queueDeepness > tSizes[AUDIO_CHAIN_TASK_PROCESS].queueDeepness) ? tSizes[AUDIO_CHAIN_TASK_DATAINOUT].queueDeepness : tSizes[AUDIO_CHAIN_TASK_PROCESS].queueDeepness;
+    queueDeepness = (queueDeepness > tSizes[AUDIO_CHAIN_TASK_CONTROL].queueDeepness) ? queueDeepness : tSizes[AUDIO_CHAIN_TASK_CONTROL].queueDeepness;
+    UTIL_TERM_printf("/* audio_chain_tasks_conf.h: sized with %lu %% margin */\n", marginPcent);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_DATAINOUT_TASK_STACK_SIZE         %luUL\n", tSizes[AUDIO_CHAIN_TASK_DATAINOUT].stackSize);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_PROCESS_TASK_STACK_SIZE           %luUL\n", tSizes[AUDIO_CHAIN_TASK_PROCESS].stackSize);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_PROCESS_LOW_LEVEL_TASK_STACK_SIZE %luUL\n", tSizes[AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL].stackSize);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_CONTROL_TASK_STACK_SIZE           %luUL\n", tSizes[AUDIO_CHAIN_TASK_CONTROL].stackSize);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_TASKS_MESSAGE_QUEUE_DEEPNESS      %luUL\n", queueDeepness);
+    UTIL_TERM_printf("#define AUDIO_CHAIN_TASKS_LL_MESSAGE_QUEUE_DEEPNESS   %luUL\n", tSizes[AUDIO_CHAIN_TASK_PROCESS_LOW_LEVEL].queueDeepness);
+  }
+}
+#endif
+
+
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+/**
+* @brief  print the per-frame slack left by the process pass and the control & low-level work scheduled in it
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_slack(int argc, char *argv[])
+{
+  audio_chain_task_slack_stats_t stats;
+
+  AudioChain_task_getSlackStats(&stats);
+  UTIL_TERM_printf("%lu frames, deadline %ld us: slack last %ld us, min %ld us, %lu underruns\n", stats.nbFrames, stats.deadline, stats.lastSlack, stats.minSlack, stats.nbUnderruns);
+  UTIL_TERM_printf("slack work: low-level process peak %ld us, control peak %ld us\n", stats.processLowLevelPeak, stats.controlPeak);
+  UTIL_TERM_printf("            %lu deferred, %lu forced, %lu over budget\n", stats.nbDeferred, stats.nbForced, stats.nbOverBudget);
+  if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+  {
+    AudioChain_task_resetSlackStats();
+  }
+}
+#endif
+
+
+/**
+* @brief  print the boot-to-first-sample time of the current graph
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_boot(int argc, char *argv[])
+{
+  audio_chain_instance_boot_stats_t stats;
+
+  if (AudioChainInstance_getBootStats(&stats))
+  {
+    UTIL_TERM_printf("%s graph: build %lu us, first sample %lu us\n", stats.bStaticGraph ? "static" : "acSdk", stats.buildUs, stats.firstSampleUs);
+  }
+  else
+  {
+    UTIL_TERM_printf("first audio run not reached\n");
+  }
+}
+
+
+#ifndef USE_LIVETUNE_DESIGNER
+/**
+* @brief  Rebuild routine of the "swap" command: the swap has deinit the audio chain graph,
+*         the acSdk pipe is released so that AudioChainInstance_initGraph can build it again
+*/
+static void s_swap_initGraph(void)
+{
+  (void)acPipeDelete(&AudioChainInstance);
+  (void)acTerminate();
+  AudioChainInstance_initGraph();
+}
+
+
+/**
+* @brief  rebuild the graph with the current audio configuration & environment through a faded swap,
+*         or print the measures of the last swap
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_swap(int argc, char *argv[])
+{
+  audio_chain_instance_swap_stats_t stats;
+
+  if ((argc >= 2) && (strcmp(argv[1], "stats") == 0))
+  {
+    if (AudioChainInstance_getSwapGraphStats(&stats))
+    {
+      UTIL_TERM_printf("swap %lu ms, gap %lu ms, rebuild %lu cycles, graph RAM %lu -> %lu bytes (peak %lu)\n",
+                       (unsigned long)stats.swapMs, (unsigned long)stats.gapMs, (unsigned long)stats.rebuildCycles,
+                       (unsigned long)stats.oldGraphRam, (unsigned long)stats.newGraphRam, (unsigned long)stats.peakRam);
+    }
+    else
+    {
+      UTIL_TERM_printf("no completed swap\n");
+    }
+  }
+  else if (AudioError_isError(AudioChainInstance_swapGraphRequest(s_swap_initGraph)))
+  {
+    UTIL_TERM_printf("swap already pending\n");
+  }
+  else
+  {
+    UTIL_TERM_printf("swap requested\n");
+  }
+}
+#endif
+
+
+/**
+* @brief  print the algos placement on the process priority passes and the paths worst-case latencies
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_placement(int argc, char *argv[])
+{
+  audio_chain_instance_placement_t stats;
+
+  if (AudioChainInstance_getPlacement(&stats))
+  {
+    for (audio_algo_list_t *pAlgoList = AudioChain_getAlgosList(&AudioChainInstance); pAlgoList != NULL; pAlgoList = pAlgoList->next)
+    {
+      UTIL_TERM_printf("%-20s %-6s %s\n",
+                       AudioAlgo_getInstanceName(pAlgoList->pAlgo),
+                       (AudioAlgo_getPrioLevel(pAlgoList->pAlgo) == AUDIO_CAPABILITY_PROCESS_PRIO_LEVEL_LOW) ? "low" : "normal",
+                       AudioChainInstance_isCriticalAlgo(pAlgoList->pAlgo) ? "critical path" : "");
+    }
+    UTIL_TERM_printf("%d algos, %d on the critical path, %d in the low priority pass\n", stats.nbAlgos, stats.nbCritical, stats.nbLow);
+    UTIL_TERM_printf("frame deadline %lu us\n", stats.frameUs);
+    if (stats.bMeasured)
+    {
+      UTIL_TERM_printf("worst-case latency: critical path %lu us, low priority path %lu us\n", stats.criticalUs, stats.lowUs);
+    }
+    else
+    {
+      UTIL_TERM_printf("worst-case latency: not measured (bLogCycles)\n");
+    }
+  }
+  else
+  {
+    UTIL_TERM_printf("algo placement not done (bAutoPrioPlacement)\n");
+  }
+}
+
+
+/**
+* @brief  print algos bypassed because of their neutral settings and the cycles reclaimed
+*
+* @param argc  num args
+* @param argv  args list
+*/
+
+static void stm32_term_acsdk_bypass(int argc, char *argv[])
+{
+  uint32_t reclaimedCycles = 0UL;
+  bool     reclaimedKnown  = true;
+  uint8_t  nbAlgos         = 0U;
+
+  for (uint8_t id = 0U; id < PASSTHROUGH_BYPASS_MAX_ALGOS; id++)
+  {
+    passThrough_bypass_t const *const pBypass = AudioChainWrp_passThrough_bypassGet(id);
+
+    if (pBypass != NULL)
+    {
+      bool const bOn = AudioChainWrp_passThrough_bypassIsOn(pBypass);
+
+      UTIL_TERM_printf("%-20s %-8s kernel %8lu cycles, copy %8lu cycles, %lu frame(s) bypassed\n",
+                       AudioAlgo_getInstanceName(pBypass->pAlgo),
+                       bOn ? "bypass" : (pBypass->bCopyPossible ? "active" : "n/a"),
+                       pBypass->kernelCycles,
+                       pBypass->copyCycles,
+                       pBypass->nbFramesBypassed);
+      if (bOn)
+      {
+        if ((pBypass->kernelCycles == 0UL) || (pBypass->kernelCycles < pBypass->copyCycles))
+        {
+          reclaimedKnown = false; /* kernel never measured since graph start */
+        }
+        else
+        {
+          reclaimedCycles += pBypass->kernelCycles - pBypass->copyCycles;
+        }
+      }
+      nbAlgos++;
+    }
+  }
+  if (nbAlgos == 0U)
+  {
+    UTIL_TERM_printf("no algo supports bypass in current graph\n");
+  }
+  else if (reclaimedKnown)
+  {
+    UTIL_TERM_printf("cycles reclaimed per frame: %lu\n", reclaimedCycles);
+  }
+  else
+  {
+    UTIL_TERM_printf("cycles reclaimed per frame: n/a (at least %lu, some kernels never measured)\n", reclaimedCycles);
+  }
+}
+
 ///**
 //* @brief  list algo
 //*
@@ -475,6 +811,20 @@ TERM_CMD_DECLARE("mem", NULL, "Print the memory status with algos memory usage s
 TERM_CMD_DECLARE("mem2", NULL, "Print the memory status with algos detailed memory usage", stm32_term_acsdk_mem2);
 TERM_CMD_DECLARE("task", NULL, "Print the task status", stm32_term_acsdk_task);
 TERM_CMD_DECLARE("cpu", NULL, "Print the cpu status", stm32_term_acsdk_cpu);
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+TERM_CMD_DECLARE("overrun", NULL, "Print the last process frames which missed their deadline", stm32_term_acsdk_overrun);
+TERM_CMD_DECLARE("control", NULL, "Print the control requests merged by the control task", stm32_term_acsdk_control);
+TERM_CMD_DECLARE("tasksize", "[reset|apply [margin %]|margin %]", "Calibrate the tasks stacks & queues and print the sized configuration", stm32_term_acsdk_tasksize);
+#endif
+#ifdef AUDIO_CHAIN_TASKS_NO_OS_SCHEDULER
+TERM_CMD_DECLARE("slack", "[reset]", "Print the per-frame slack and the control & low-level work run in it", stm32_term_acsdk_slack);
+#endif
+TERM_CMD_DECLARE("bypass", NULL, "Print the algos bypassed at neutral settings", stm32_term_acsdk_bypass);
+TERM_CMD_DECLARE("boot", NULL, "Print the graph build & boot-to-first-sample times", stm32_term_acsdk_boot);
+#ifndef USE_LIVETUNE_DESIGNER
+TERM_CMD_DECLARE("swap", "[stats]", "Rebuild the graph with the current audio config through a faded swap, or print the last swap measures", stm32_term_acsdk_swap);
+#endif
+TERM_CMD_DECLARE("placement", NULL, "Print the algos placement on the process priority passes and the paths worst-case latencies", stm32_term_acsdk_placement);
 //TERM_CMD_DECLARE("algos", NULL, "Display algo list in current graph", stm32_term_acsdk_algos);
 //TERM_CMD_DECLARE("algo_info", "[algo]", "Show the algo info", stm32_term_acsdk_algo_info);
 //TERM_CMD_DECLARE("algo_show", "[instance]", "Show all parameters for an algo ", stm32_term_acsdk_algo_show);
@@ -24,6 +24,9 @@
 #include "stm32_usart.h"
 #include "st_flash_storage.h"
 #include "string.h"
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+#include "audio_chain_tasks.h"
+#endif
 
 
 /* Private defines -----------------------------------------------------------*/
@@ -192,6 +195,20 @@ ST_Result livetune_create(void)
     pHandle->iStateFlag = pSystem->hUser.hStorage.stateStorage;
     pHandle->iChunkPool = pSystem->hUser.hStorage.iChunkMemoryPool;
     pHandle->iAlgoPool  = pSystem->hUser.hStorage.iAlgoMemoryPool;
+    #ifdef AUDIO_CHAIN_TASKS_OS_USED
+    /* tasks sizing stored by "tasksize apply", used from the first graph init */
+    if (pSystem->hUser.hStorage.tTaskStackSize[0] != 0U)
+    {
+      audio_chain_task_size_t tSizes[AUDIO_CHAIN_TASK_NB];
+
+      for (uint32_t id = 0U; id < (uint32_t)AUDIO_CHAIN_TASK_NB; id++)
+      {
+        tSizes[id].stackSize     = pSystem->hUser.hStorage.tTaskStackSize[id];
+        tSizes[id].queueDeepness = pSystem->hUser.hStorage.tTaskQueueDeepness[id];
+      }
+      AudioChain_task_setSizes(tSizes);
+    }
+    #endif
     st_base_set_debug_level(pSystem->iLogLevel);
     st_registry_unlock_sys(&pHandle->hRegistry, FALSE);
   }
@@ -1020,6 +1037,35 @@ uint32_t livetune_state_set_algo_pool(uint8_t mem_pool)
 }
 
 
+#ifdef AUDIO_CHAIN_TASKS_OS_USED
+/**
+* @brief record the audio chain tasks sizing in the registry, restored at boot (overloads the weak one of audio_chain_tasks_cmsisos.c)
+*/
+
+bool AudioChain_task_persistSizes(audio_chain_task_size_t const pSizes[AUDIO_CHAIN_TASK_NB])
+{
+  bool               bStored   = false;
+  livetune_instance *pInstance = livetune_get_instance();
+
+  if (pInstance)
+  {
+    st_persist_sys *pSystem = st_registry_lock_sys(&pInstance->hRegistry);
+    if (pSystem)
+    {
+      for (uint32_t id = 0U; id < (uint32_t)AUDIO_CHAIN_TASK_NB; id++)
+      {
+        pSystem->hUser.hStorage.tTaskStackSize[id]     = pSizes[id].stackSize;
+        pSystem->hUser.hStorage.tTaskQueueDeepness[id] = (uint8_t)pSizes[id].queueDeepness;
+      }
+      st_registry_unlock_sys(&pInstance->hRegistry, TRUE);
+      bStored = true;
+    }
+  }
+  return bStored;
+}
+#endif
+
+
 /**
 * @brief return true if the system is initialized
 */
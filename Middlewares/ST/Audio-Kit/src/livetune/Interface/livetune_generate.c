@@ -31,12 +31,42 @@
 
 /* Private defines -----------------------------------------------------------*/
 #define GENERATE_LONG_STRING_THRESHOLD 200U
+#define GENERATE_STATIC_GRAPH_MAX_ALGOS  32U
+#define GENERATE_STATIC_GRAPH_MAX_CHUNKS 64U
+#define GENERATE_STATIC_GRAPH_MAX_CNX    128U
+#define GENERATE_STATIC_WORDS_PER_LINE   8U
 
 /* Private macros ------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+typedef struct livetune_generate_static_cnx
+{
+  const char_t *pAlgoVarName;
+  const char_t *pChunkVarName;
+  uint32_t      pinId;
+  uint32_t      pinType;
+} livetune_generate_static_cnx;
+
+/* graph elements recorded while the acSdk code is generated, used to generate the static graph */
+typedef struct livetune_generate_static_graph_record
+{
+  livetune_helper_builder      *tAlgos[GENERATE_STATIC_GRAPH_MAX_ALGOS];
+  livetune_db_instance_cnx     *tChunks[GENERATE_STATIC_GRAPH_MAX_CHUNKS];
+  livetune_generate_static_cnx  tCnx[GENERATE_STATIC_GRAPH_MAX_CNX];
+  uint32_t                      nbAlgos;
+  uint32_t                      nbChunks;
+  uint32_t                      nbCnx;
+  int8_t                        bOverflow;
+} livetune_generate_static_graph_record;
+
 /* Global variables ----------------------------------------------------------*/
+static livetune_generate_static_graph_record hStaticGraphRecord;
+
 /* Private routines ----------------------------------------------------------*/
 static void trim_trailing_spaces_and_tabs(char *const pString);
+static void livetune_generate_static_graph_record_algo(livetune_helper_builder *pBuilder);
+static void livetune_generate_static_graph_record_chunk(livetune_db_instance_cnx *pCnx);
+static void livetune_generate_static_graph_record_cnx(const char_t *pAlgoVarName, uint32_t pinId, const char_t *pChunkVarName, uint32_t pinType);
+static ST_Result livetune_generate_static_graph(livetune_pipe *pHandle);
 
 
 
@@ -161,6 +191,7 @@ char_t *livetune_generate_code(livetune_pipe *pHandle)
     uint32_t buildId      = (uint32_t)st_os_sys_time() & 0xFFFFUL;
 
     pHandle->szHeaderList = 0;
+    memset(&hStaticGraphRecord, 0, sizeof(hStaticGraphRecord));
     livetune_generate_header_add(pHandle, "stdio.h");
     livetune_generate_header_add(pHandle, "string.h");
     livetune_generate_header_add(pHandle, "assert.h");
@@ -201,6 +232,7 @@ char_t *livetune_generate_code(livetune_pipe *pHandle)
 
     livetune_pipe_notify(pHandle, LIVETUNE_PIPE_PRE_INIT_GRAPH);
 
+    livetune_pipe_log(pHandle, LIVETUNE_LOG_CODE, "#ifndef CODE_GEN_STATIC_GRAPH\n");
     livetune_generate_fn_declare(pHandle, "void", "AudioChainInstance_initGraph(void)");
     livetune_generate_fn_declare(pHandle, "{", NULL);
 
@@ -279,10 +311,15 @@ char_t *livetune_generate_code(livetune_pipe *pHandle)
     livetune_generate_fn_body(pHandle, "}", NULL);
 
     livetune_generate_fn_declare(pHandle, "}", NULL);
+    livetune_pipe_log(pHandle, LIVETUNE_LOG_CODE, "#endif\n");
     livetune_pipe_log(pHandle, LIVETUNE_LOG_CODE, "\n\n");
     result = ST_OK;
   }
   if (result == ST_OK)
+  {
+    result = livetune_generate_static_graph(pHandle);
+  }
+  if (result == ST_OK)
   {
     result = livetune_generate_code_add_algo_list(pHandle);
   }
@@ -423,6 +460,7 @@ static void livetune_generate_create_chunk(livetune_helper_builder *pBuilder, li
 {
   if (pBuilder->pPipe->bGenerateCode)
   {
+    livetune_generate_static_graph_record_chunk(pCnx);
     livetune_generate_fn_body(pBuilder->pPipe, livetune_helper_format("// Create the chunk %s", pCnx->hAc.tVarName), NULL);
     /* Manage the sysio name */
     const char_t *pChunkName = pCnx->hAc.tVarName;
@@ -457,6 +495,7 @@ void livetune_generate_connect_pins(livetune_pipe *pHandle, char_t *pAlgoName, u
 {
   if (pHandle->bGenerateCode)
   {
+    livetune_generate_static_graph_record_cnx(pAlgoName, pinId, pChunkName, pinType);
     if (pinType == (uint32_t)ST_GENERATOR_PIN_TYPE_IN)
     {
       livetune_generate_fn_body(pHandle, livetune_helper_format("error = acPipeConnectPinIn(hPipe, %s, %d, %s);", pAlgoName, pinId, pChunkName), NULL);
@@ -1022,6 +1061,416 @@ void livetune_generate_algo_create(livetune_helper_builder *pBuilder, char_t *pO
   }
   livetune_generate_fn_body(pBuilder->pPipe, livetune_helper_format("error = acAlgoCreate(hPipe, \"%s\", \"%s\", &%s, 0, \"%s\");", pAlgoName, pBuilder->pInstance->pInstanceName, pBuilder->pInstance->hAc.tVarName, pBuilder->pInstance->pDescription), tScratchDescription);
   livetune_generate_fn_body(pBuilder->pPipe, "assert(error == 0);", NULL);
+  livetune_generate_static_graph_record_algo(pBuilder);
+}
+
+
+
+/**
+* @brief record an algo for the static graph generation
+*
+* @param pBuilder the instance builder
+*/
+static void livetune_generate_static_graph_record_algo(livetune_helper_builder *pBuilder)
+{
+  if ((pBuilder->pPipe->bGenerateCode != 0) && (pBuilder->pFactory != NULL))
+  {
+    if (hStaticGraphRecord.nbAlgos < GENERATE_STATIC_GRAPH_MAX_ALGOS)
+    {
+      hStaticGraphRecord.tAlgos[hStaticGraphRecord.nbAlgos++] = pBuilder;
+    }
+    else
+    {
+      hStaticGraphRecord.bOverflow = TRUE;
+    }
+  }
+}
+
+
+/**
+* @brief record a chunk for the static graph generation, a chunk could be created twice (sys io)
+*
+* @param pCnx the chunk connection
+*/
+static void livetune_generate_static_graph_record_chunk(livetune_db_instance_cnx *pCnx)
+{
+  int8_t bFound = FALSE;
+  for (uint32_t index = 0; index < hStaticGraphRecord.nbChunks; index++)
+  {
+    if (strcmp(hStaticGraphRecord.tChunks[index]->hAc.tVarName, pCnx->hAc.tVarName) == 0)
+    {
+      /* the sys io side wins, its chunk is created by AudioChainSysIOs */
+      if (pCnx->hAc.pSysIoName != NULL)
+      {
+        hStaticGraphRecord.tChunks[index] = pCnx;
+      }
+      bFound = TRUE;
+      break;
+    }
+  }
+  if (bFound == FALSE)
+  {
+    if (hStaticGraphRecord.nbChunks < GENERATE_STATIC_GRAPH_MAX_CHUNKS)
+    {
+      hStaticGraphRecord.tChunks[hStaticGraphRecord.nbChunks++] = pCnx;
+    }
+    else
+    {
+      hStaticGraphRecord.bOverflow = TRUE;
+    }
+  }
+}
+
+
+/**
+* @brief record a pin connection for the static graph generation
+*
+* @param pAlgoVarName  algo variable name
+* @param pinId         pin index
+* @param pChunkVarName chunk variable name
+* @param pinType       ST_GENERATOR_PIN_TYPE_IN or ST_GENERATOR_PIN_TYPE_OUT
+*/
+static void livetune_generate_static_graph_record_cnx(const char_t *pAlgoVarName, uint32_t pinId, const char_t *pChunkVarName, uint32_t pinType)
+{
+  if (hStaticGraphRecord.nbCnx < GENERATE_STATIC_GRAPH_MAX_CNX)
+  {
+    livetune_generate_static_cnx *pCnx = &hStaticGraphRecord.tCnx[hStaticGraphRecord.nbCnx++];
+    pCnx->pAlgoVarName  = pAlgoVarName;
+    pCnx->pChunkVarName = pChunkVarName;
+    pCnx->pinId         = pinId;
+    pCnx->pinType       = pinType;
+  }
+  else
+  {
+    hStaticGraphRecord.bOverflow = TRUE;
+  }
+}
+
+
+/**
+* @brief return the index of a recorded algo or chunk from its variable name
+*
+* @param pVarName variable name
+* @param bChunk   search a chunk, else an algo
+* @return index or -1 if not found
+*/
+static int32_t livetune_generate_static_graph_find(const char_t *pVarName, int8_t bChunk)
+{
+  int32_t  found = -1;
+  uint32_t nb    = (bChunk != FALSE) ? hStaticGraphRecord.nbChunks : hStaticGraphRecord.nbAlgos;
+  for (uint32_t index = 0; index < nb; index++)
+  {
+    const char_t *pName = (bChunk != FALSE) ? hStaticGraphRecord.tChunks[index]->hAc.tVarName : hStaticGraphRecord.tAlgos[index]->pInstance->hAc.tVarName;
+    if (strcmp(pName, pVarName) == 0)
+    {
+      found = (int32_t)index;
+      break;
+    }
+  }
+  return found;
+}
+
+
+/**
+* @brief return the sys io index of a chunk in the sys connections list
+*
+* @param pSysIoName the sys io variable name
+* @param type       AC_SYS_IN or AC_SYS_OUT
+* @return index or -1 if not found
+*/
+static int32_t livetune_generate_static_graph_find_sysio(const char_t *pSysIoName, livetune_ac_factory_sys_type type)
+{
+  int32_t  found = -1;
+  uint32_t nb    = livetune_ac_factory_get_sys_connection_nb(type);
+  for (uint32_t index = 0; index < nb; index++)
+  {
+    const audio_chain_sys_connection_conf_t *pConf = livetune_ac_factory_get_sys_connection_conf(type, (int32_t)index);
+    if ((pConf != NULL) && (strcmp(livetune_ac_factory_get_sys_connection_name(pConf), pSysIoName) == 0))
+    {
+      found = (int32_t)index;
+      break;
+    }
+  }
+  return found;
+}
+
+
+/**
+* @brief Generate the binary image of an algo config: the factory defaults overwritten by the tuned values.
+*        Address parameters can't be resolved at generation time, they are listed by livetune_generate_static_graph_addr_params
+*
+* @param pBuilder      the instance builder
+* @param pTemplate     static or dynamic param template
+* @param pControlIndex index of the first instance param string of the template
+* @param pSuffix       variable suffix
+*/
+static ST_Result livetune_generate_static_graph_config(livetune_helper_builder *pBuilder, const audio_descriptor_params_t *pTemplate, uint32_t *pControlIndex, const char_t *pSuffix)
+{
+  ST_Result result  = ST_OK;
+  uint32_t  nbWords = (pTemplate->szBytes + sizeof(uint32_t) - 1UL) / sizeof(uint32_t);
+  uint32_t *pImage  = st_os_mem_alloc(ST_Mem_Type_Designer, (nbWords + 1UL) * sizeof(uint32_t));
+
+  if (pImage == NULL)
+  {
+    result = ST_ERROR;
+  }
+  else
+  {
+    memset(pImage, 0, (nbWords + 1UL) * sizeof(uint32_t));
+    for (uint32_t paramID = 0; paramID < pTemplate->nbParams; paramID++)
+    {
+      audio_descriptor_param_t *pParam = &pTemplate->pParam[paramID];
+      const char_t             *pValue = LIVETUNE_STRING(pBuilder->pInstance, (*pControlIndex));
+
+      if (pParam->pDefault != NULL)
+      {
+        (void)AudioDescriptor_applyParamConfigStr(pParam, pImage, pParam->pDefault, NULL);
+      }
+      if (((pParam->iParamFlag & AUDIO_DESC_PARAM_TYPE_FLAG_PRIVATE) == 0UL) && (pParam->paramType != AUDIO_DESC_PARAM_TYPE_ADDRESS) && (pValue != NULL))
+      {
+        char_t *pTranslated = AudioChainJson_factory_translate_key_value(pParam, pValue);
+        if (AudioDescriptor_applyParamConfigStr(pParam, pImage, pTranslated, NULL) != 0)
+        {
+          livetune_pipe_log(pBuilder->pPipe, LIVETUNE_LOG_CODE, "#error \"%s: wrong value for %s\"\n", pBuilder->pInstance->pInstanceName, pParam->pName);
+        }
+        st_os_mem_free(pTranslated);
+      }
+      (*pControlIndex)++;
+    }
+
+    livetune_pipe_log(pBuilder->pPipe, LIVETUNE_LOG_CODE, "static const uint32_t %s_%sInit[%d] =\n{", pBuilder->pInstance->hAc.tVarName, pSuffix, nbWords + 1UL);
+    for (uint32_t indexWord = 0; indexWord < nbWords; indexWord++)
+    {
+      livetune_pipe_add_printf(pBuilder->pPipe, LIVETUNE_LOG_CODE, "%s0x%08lXUL%s", ((indexWord % GENERATE_STATIC_WORDS_PER_LINE) == 0UL) ? "\n  " : " ", pImage[indexWord], (indexWord + 1UL < nbWords) ? "," : "");
+    }
+    livetune_pipe_add_log(pBuilder->pPipe, LIVETUNE_LOG_CODE, "\n};\n");
+    livetune_pipe_log(pBuilder->pPipe, LIVETUNE_LOG_CODE, "static uint32_t       %s_%s[%d];\n", pBuilder->pInstance->hAc.tVarName, pSuffix, nbWords + 1UL);
+    st_os_mem_free(pImage);
+  }
+  return result;
+}
+
+
+/**
+* @brief Generate (or count) the address parameters of an algo, they are applied from their string at init
+*
+* @param pBuilder the instance builder
+* @param bEmit    generate the table entries, else only count them
+* @return number of address parameters
+*/
+static uint32_t livetune_generate_static_graph_addr_params(livetune_helper_builder *pBuilder, int8_t bEmit)
+{
+  const audio_descriptor_params_t *tTemplate[2] = {pBuilder->pFactory->pStaticParamTemplate, pBuilder->pFactory->pDynamicParamTemplate};
+  uint32_t                         indexControl = 0;
+  uint32_t                         nbParams     = 0;
+
+  for (uint8_t bDynamic = 0U; bDynamic < 2U; bDynamic++)
+  {
+    const audio_descriptor_params_t *pTemplate = tTemplate[bDynamic];
+    for (uint32_t paramID = 0; (pTemplate != NULL) && (paramID < pTemplate->nbParams); paramID++)
+    {
+      audio_descriptor_param_t *pParam = &pTemplate->pParam[paramID];
+      char_t                   *pValue = LIVETUNE_STRING(pBuilder->pInstance, indexControl);
+
+      if (((pParam->iParamFlag & AUDIO_DESC_PARAM_TYPE_FLAG_PRIVATE) == 0UL) && (pParam->paramType == AUDIO_DESC_PARAM_TYPE_ADDRESS) && (pValue != NULL))
+      {
+        if (livetune_ac_factory_is_default_value_string(pParam, pValue) == FALSE)
+        {
+          if (bEmit != FALSE)
+          {
+            char_t *pTranslated = AudioChainJson_factory_translate_key_value(pParam, pValue);
+            livetune_pipe_log(pBuilder->pPipe, LIVETUNE_LOG_CODE, "  {%dU, %dU, \"%s\"}, // %s\n", bDynamic, paramID, pTranslated, pParam->pName);
+            st_os_mem_free(pTranslated);
+          }
+          nbParams++;
+        }
+      }
+      indexControl++;
+    }
+  }
+  return nbParams;
+}
+
+
+/**
+* @brief Generate the statically initialized graph, selected by CODE_GEN_STATIC_GRAPH.
+*        The graph is the one recorded during the acSdk code generation, but algo & chunk
+*        configurations are generated as binary images, so AudioChainInstance_initStaticGraph
+*        doesn't have to lookup factories nor to parse parameter strings at boot.
+*
+* @param pHandle the instance handle
+*/
+static ST_Result livetune_generate_static_graph(livetune_pipe *pHandle)
+{
+  ST_Result result = ST_OK;
+
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "#ifdef CODE_GEN_STATIC_GRAPH\n");
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "// The graph is built from pre-resolved descriptions, it reduces the boot time (see the \"boot\" command)\n");
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "// The binary configs are only valid for the firmware version CODE_GEN_SDKVERSION, they must be regenerated after an algo update\n");
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "#include \"audio_chain_instance.h\"\n\n");
+
+  if (hStaticGraphRecord.bOverflow != FALSE)
+  {
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "#error \"the graph is too large to be generated as a static graph\"\n");
+  }
+
+  /* factories */
+  for (uint32_t indexAlgo = 0; indexAlgo < hStaticGraphRecord.nbAlgos; indexAlgo++)
+  {
+    const char_t *pAlgoName = livetune_factory_get_algo_name(hStaticGraphRecord.tAlgos[indexAlgo]->pFactory);
+    int8_t        bFound    = FALSE;
+    for (uint32_t indexPrev = 0; indexPrev < indexAlgo; indexPrev++)
+    {
+      if (hStaticGraphRecord.tAlgos[indexPrev]->pFactory == hStaticGraphRecord.tAlgos[indexAlgo]->pFactory)
+      {
+        bFound = TRUE;
+        break;
+      }
+    }
+    if (bFound == FALSE)
+    {
+      livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "extern audio_algo_factory_t %s;\n", livetune_ac_factory_get_factory_instance_name(pAlgoName));
+    }
+  }
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "\n");
+
+  /* algo configs */
+  for (uint32_t indexAlgo = 0; (result == ST_OK) && (indexAlgo < hStaticGraphRecord.nbAlgos); indexAlgo++)
+  {
+    livetune_helper_builder *pBuilder     = hStaticGraphRecord.tAlgos[indexAlgo];
+    uint32_t                 indexControl = 0;
+
+    livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "// %s configs\n", pBuilder->pInstance->pInstanceName);
+    if (pBuilder->pFactory->pStaticParamTemplate)
+    {
+      result = livetune_generate_static_graph_config(pBuilder, pBuilder->pFactory->pStaticParamTemplate, &indexControl, "staticConfig");
+    }
+    if ((result == ST_OK) && (pBuilder->pFactory->pDynamicParamTemplate))
+    {
+      result = livetune_generate_static_graph_config(pBuilder, pBuilder->pFactory->pDynamicParamTemplate, &indexControl, "dynamicConfig");
+    }
+    if ((result == ST_OK) && (livetune_generate_static_graph_addr_params(pBuilder, FALSE) != 0UL))
+    {
+      livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "static const audio_chain_instance_static_param_t %s_addrParams[] =\n{\n", pBuilder->pInstance->hAc.tVarName);
+      (void)livetune_generate_static_graph_addr_params(pBuilder, TRUE);
+      livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "};\n");
+    }
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "\n");
+  }
+
+  if (result == ST_OK)
+  {
+    /* handles storage */
+    livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "static audio_algo_t  tStaticGraphAlgos[%d];\n", (hStaticGraphRecord.nbAlgos != 0UL) ? hStaticGraphRecord.nbAlgos : 1UL);
+    livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "static audio_chunk_t tStaticGraphChunks[%d];\n\n", (hStaticGraphRecord.nbChunks != 0UL) ? hStaticGraphRecord.nbChunks : 1UL);
+
+    /* chunks */
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "static const audio_chain_instance_static_chunk_t tStaticGraphChunksDescr[] =\n{\n");
+    for (uint32_t indexChunk = 0; indexChunk < hStaticGraphRecord.nbChunks; indexChunk++)
+    {
+      livetune_db_instance_cnx    *pCnx  = hStaticGraphRecord.tChunks[indexChunk];
+      const livetune_chunk_conf_t *pConf = &pCnx->hAc.hConf;
+      if (pCnx->hAc.pSysIoName != NULL)
+      {
+        const char_t *pSysType = "AC_STATIC_CHUNK_SYS_IN";
+        int32_t       sysId    = livetune_generate_static_graph_find_sysio(pCnx->hAc.pSysIoName, AC_SYS_IN);
+        if (sysId < 0)
+        {
+          pSysType = "AC_STATIC_CHUNK_SYS_OUT";
+          sysId    = livetune_generate_static_graph_find_sysio(pCnx->hAc.pSysIoName, AC_SYS_OUT);
+        }
+        if (sysId < 0)
+        {
+          livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "#error \"%s: unknown system connection\"\n", pCnx->hAc.pSysIoName);
+        }
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  {.pName = \"%s\", .sysType = %s, .sysId = %dU},\n", pCnx->hAc.tVarName, pSysType, (sysId < 0) ? 0 : sysId);
+      }
+      else
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  {.pName = \"%s\", .sysType = AC_STATIC_CHUNK_USER, .conf = {%dU, %dU, %dU, %dU, %dU, %dU, %luUL, %luUL, NULL}},\n",
+                                 pCnx->hAc.tVarName, pConf->chunkType, pConf->timeFreq, pConf->bufferType, pConf->interleaved, pConf->nbFrames, pConf->nbChannels, pConf->nbElements, pConf->fs);
+      }
+    }
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "};\n\n");
+
+    /* algos */
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "static const audio_chain_instance_static_algo_t tStaticGraphAlgosDescr[] =\n{\n");
+    for (uint32_t indexAlgo = 0; indexAlgo < hStaticGraphRecord.nbAlgos; indexAlgo++)
+    {
+      livetune_helper_builder *pBuilder = hStaticGraphRecord.tAlgos[indexAlgo];
+      const char_t            *pVarName = pBuilder->pInstance->hAc.tVarName;
+      const char_t            *pCtrlCb  = "NULL";
+      if (livetune_helper_instance_has_control(pBuilder->pInstance))
+      {
+        pCtrlCb = livetune_helper_format("(audio_algo_cb_t)%s", pBuilder->sCbCtrlName);
+      }
+      livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  {\n    .pDesc          = \"%s\",\n", pBuilder->pInstance->pDescription);
+      livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "    .pFactory       = &%s,\n", livetune_ac_factory_get_factory_instance_name(livetune_factory_get_algo_name(pBuilder->pFactory)));
+      livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "    .state          = AUDIO_ALGO_STATE_ENABLED,\n    .controlCb      = %s,\n", pCtrlCb);
+      if (pBuilder->pFactory->pStaticParamTemplate)
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "    .pStaticConfig  = %s_staticConfig,\n    .pStaticInit    = %s_staticConfigInit,\n", pVarName, pVarName);
+      }
+      if (pBuilder->pFactory->pDynamicParamTemplate)
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "    .pDynamicConfig = %s_dynamicConfig,\n    .pDynamicInit   = %s_dynamicConfigInit,\n", pVarName, pVarName);
+      }
+      uint32_t nbAddrParams = livetune_generate_static_graph_addr_params(pBuilder, FALSE);
+      if (nbAddrParams != 0UL)
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "    .pAddrParams    = %s_addrParams,\n    .nbAddrParams   = %dU,\n", pVarName, nbAddrParams);
+      }
+      livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  },\n");
+    }
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "};\n\n");
+
+    /* connections */
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "static const audio_chain_instance_static_cnx_t tStaticGraphCnx[] =\n{\n");
+    for (uint32_t indexCnx = 0; indexCnx < hStaticGraphRecord.nbCnx; indexCnx++)
+    {
+      const livetune_generate_static_cnx *pCnx    = &hStaticGraphRecord.tCnx[indexCnx];
+      int32_t                             algoId  = livetune_generate_static_graph_find(pCnx->pAlgoVarName, FALSE);
+      int32_t                             chunkId = livetune_generate_static_graph_find(pCnx->pChunkVarName, TRUE);
+      if ((algoId < 0) || (chunkId < 0))
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "#error \"%s pin %d: connection to %s can't be generated statically\"\n", pCnx->pAlgoVarName, pCnx->pinId, pCnx->pChunkVarName);
+      }
+      else
+      {
+        livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  {%dU, %dU, %dU, %dU}, // %s %s %s\n", algoId, chunkId, pCnx->pinId, (pCnx->pinType == (uint32_t)ST_GENERATOR_PIN_TYPE_OUT) ? 1 : 0,
+                                 pCnx->pAlgoVarName, (pCnx->pinType == (uint32_t)ST_GENERATOR_PIN_TYPE_OUT) ? "->" : "<-", pCnx->pChunkVarName);
+      }
+    }
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "};\n\n");
+
+    /* graph */
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "static const audio_chain_instance_static_graph_t hStaticGraph =\n{\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .pAlgos       = tStaticGraphAlgos,\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .pChunks      = tStaticGraphChunks,\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .pAlgosDescr  = tStaticGraphAlgosDescr,\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .pChunksDescr = tStaticGraphChunksDescr,\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .pCnx         = tStaticGraphCnx,\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .nbAlgos      = (uint8_t)(sizeof(tStaticGraphAlgosDescr) / sizeof(tStaticGraphAlgosDescr[0])),\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .nbChunks     = (uint8_t)(sizeof(tStaticGraphChunksDescr) / sizeof(tStaticGraphChunksDescr[0])),\n");
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "  .nbCnx        = (uint8_t)(sizeof(tStaticGraphCnx) / sizeof(tStaticGraphCnx[0])),\n");
+    livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  .algoMemPool  = (memPool_t)%dU,\n", livetune_state_get_algo_pool());
+    livetune_pipe_add_printf(pHandle, LIVETUNE_LOG_CODE, "  .chunkMemPool = (memPool_t)%dU\n", livetune_state_get_chunk_pool());
+    livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "};\n\n");
+
+    livetune_generate_fn_declare(pHandle, "void", "AudioChainInstance_initGraph(void)");
+    livetune_generate_fn_declare(pHandle, "{", NULL);
+    livetune_generate_fn_body(pHandle, "if (AudioChainInstance_initStaticGraph(&hStaticGraph) != 0)", NULL);
+    livetune_generate_fn_body(pHandle, "{", NULL);
+    livetune_generate_fn_body(pHandle, "  acTrace(\"Ac static graph error\\n\");", NULL);
+    livetune_generate_fn_body(pHandle, "}", NULL);
+    livetune_generate_fn_body(pHandle, "else", NULL);
+    livetune_generate_fn_body(pHandle, "{", NULL);
+    livetune_generate_fn_body(pHandle, "  acTrace(\"Ac playing\\n\");", NULL);
+    livetune_generate_fn_body(pHandle, "}", NULL);
+    livetune_generate_fn_declare(pHandle, "}", NULL);
+  }
+  livetune_pipe_add_log(pHandle, LIVETUNE_LOG_CODE, "#endif\n\n");
+  return result;
 }
 
 
@@ -390,6 +390,7 @@ typedef enum
   CFG_TASK_PLL_READY_ID,
   CFG_TASK_APP_ADV_TIMER_ID,
   CFG_TASK_APP_LINKUP_RETRY_TIMER_ID,
+  CFG_TASK_APP_SCAN_BACKOFF_ID,
   /* USER CODE END CFG_Task_Id_t */
   CFG_TASK_NBR /* Shall be LAST in the list */
 } CFG_Task_Id_t;
@@ -593,6 +594,14 @@ typedef enum
 #define CODEC_RF_SETUP_US                       (1100u)
 #endif /* defined(__GNUC__) && defined(DEBUG) */
 
+/* Regulation of the PLL N fractional value requested by the clock corrector, Q8 values (256 is 1.0), see
+   codec_if_nfrac_pi.h. The defaults apply the requests unchanged. A KI below 256 makes the applied value follow
+   the requests with a bandwidth of about KI / 256 / (2 * pi * T), T being the corrections period; ALPHA is the
+   coefficient of the error low-pass filter, of bandwidth about ALPHA / 256 / (2 * pi * T) */
+#define CODEC_NFRAC_FILTER_ALPHA_Q8             (256)
+#define CODEC_NFRAC_PI_KP_Q8                    (0)
+#define CODEC_NFRAC_PI_KI_Q8                    (256)
+
 /******************************************************************************
  * TEST VALIDATION
  ******************************************************************************/
@@ -73,6 +73,7 @@ void MX_AudioInit(Audio_Role_t role,
                   Sampling_Freq_t sampling_frequency,
                   Frame_Duration_t frame_duration,
                   uint8_t *pSnkBuff,
+                  uint8_t snk_channels,
                   uint8_t *pSrcBuff);
 void MX_AudioDeInit(void);
 int32_t Start_TxAudio(void);
@@ -709,6 +709,7 @@ void MX_AudioInit(Audio_Role_t role,
                   Sampling_Freq_t sampling_frequency,
                   Frame_Duration_t frame_duration,
                   uint8_t *pSnkBuff,
+                  uint8_t snk_channels,
                   uint8_t *pSrcBuff)
 {
   uint32_t sample_per_frame;
@@ -813,7 +814,8 @@ void MX_AudioInit(Audio_Role_t role,
   }
 
   audio_conf.Device = AUDIO_OUT_DEVICE_HEADPHONE;
-  audio_conf.ChannelsNbr = 2;
+  /* with 1 channel the SAI is in mono mode and sends each sample on both slots */
+  audio_conf.ChannelsNbr = snk_channels;
   audio_conf.Volume = Current_Volume;
   if (BSP_AUDIO_OUT_Init(0x00, &audio_conf) != BSP_ERROR_NONE)
   {
@@ -824,7 +826,7 @@ void MX_AudioInit(Audio_Role_t role,
   }
 
   /* Start SAI clock without DMA interrupt */
-  uint8_t channel_at_snk = 2;   /* SAI is in stereo for Headset */
+  uint8_t channel_at_snk = snk_channels;   /* 1 in SAI mono mode: DMA carries one word per frame sample, the SAI repeats it on both slots */
   uint8_t buffer_nb = 2;        /* double buffer strategy for minimum latency*/
   uint8_t bytes_per_sample = 2;
 
@@ -618,10 +618,13 @@ static void board_process(void)
     {
       /*speaker_audio_announce(H5APP_PLAY_BIP);*/
       speaker_set_led(LED_GREEN, 0, 0);
-      HAL_Delay(300);
-      TMAPAPP_StopSink();
-      TMAPAPP_SwitchLanguage();
-      TMAPAPP_StartSink();
+      if (TMAPAPP_SwitchLanguage() != BLE_STATUS_SUCCESS)
+      {
+        /* not synchronized to the BIG: restart the sink on the new subgroup */
+        HAL_Delay(300);
+        TMAPAPP_StopSink();
+        TMAPAPP_StartSink();
+      }
     }
   }
 
@@ -653,6 +653,20 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void *p_Pckt)
           }
         }
         break;
+
+        case HCI_LE_EXTENDED_ADVERTISING_REPORT_SUBEVT_CODE:
+        {
+          hci_le_extended_advertising_report_event_rp0 *ext_adv_report_event =
+          (hci_le_extended_advertising_report_event_rp0 *) p_meta_evt->data;
+          /* RSSI used to rank the Broadcast Sources, only a source with a periodic advertising is a candidate */
+          if (ext_adv_report_event->Periodic_Adv_Interval != 0u)
+          {
+            TMAPAPP_AdvReportRSSI(&ext_adv_report_event->Address[0],
+                                  ext_adv_report_event->Advertising_SID,
+                                  (int8_t) ext_adv_report_event->RSSI);
+          }
+        }
+        break;
 #endif /* ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) */
 
         /* USER CODE END SUBEVENT */
@@ -25,6 +25,7 @@
 #include "stm32_seq.h"
 #include "stm32_timer.h"
 #include "codec_mngr.h"
+#include "codec_if.h"
 #include "ltv_utils.h"
 #include "cap.h"
 #include "tmap.h"
@@ -37,6 +38,17 @@
 /* Private includes ----------------------------------------------------------*/
 
 /* Private typedef -----------------------------------------------------------*/
+/* Broadcast Source matching the allow-list, ranked during the selection window */
+typedef struct
+{
+  uint8_t       AdvAddress[6];
+  uint8_t       AdvAddressType;
+  uint8_t       AdvSID;
+  uint32_t      BroadcastID;
+  int8_t        Priority;
+  int8_t        RSSI;
+  uint32_t      LastReportTs;
+} APP_BSNK_Candidate_t;
 
 /* Private defines -----------------------------------------------------------*/
 /*BAP mandatory supported delay definition*/
@@ -80,8 +92,13 @@
 
 
 #if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
-#define SCAN_INTERVAL                           (0x40) /* Scan Interval (*0.625ms): 40ms */
-#define SCAN_WINDOW                             (0x20) /* Scan Window (*0.625ms): 20ms */
+/* Adaptive scan: fast level after a user action or a PA sync loss, then the interval is doubled every
+ * SCAN_BACKOFF_MS without allowed source, down to the background level */
+#define SCAN_FAST_INTERVAL                      (0x40)  /* Scan Interval (*0.625ms): 40ms */
+#define SCAN_FAST_WINDOW                        (0x40)  /* Scan Window (*0.625ms): 40ms, continuous scan */
+#define SCAN_SLOW_INTERVAL                      (0x800) /* Scan Interval (*0.625ms): 1.28s */
+#define SCAN_SLOW_WINDOW                        (0x20)  /* Scan Window (*0.625ms): 20ms, 1.6% duty cycle */
+#define SCAN_BACKOFF_MS                         (2000u)
 #define PA_EVENT_SKIP                           (0u)
 #define PA_SYNC_TIMEOUT                         (0x03E8)
 #define BAP_BROADCAST_ENCRYPTION                (0u)
@@ -171,13 +188,13 @@
 
 #define VOLUME_STEP                     20
 
-#define NUM_SOURCES                     3
+#define NUM_DEFAULT_SOURCES             3
+
+#define RSSI_NOT_AVAILABLE              (127)
 
 /* Private macros ------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
-const char SourcesToSync[NUM_SOURCES][20] = {"Public_TV_1", "Music_Player_1", "Music_Player_2"};
-uint8_t SourceID = 0;
 uint8_t SubgroupID = 0;
 
 /* Codec Specific Capabilities defined in Basic Audio Profile Specification*/
@@ -314,6 +331,7 @@ static uint16_t *aSnkBuff = NULL;
 
 static uint16_t* pPrevData = NULL;
 static uint8_t Nb_Active_Ch = 0;
+static uint8_t Snk_Channels = 2;
 
 #if (APP_VCP_ROLE_RENDERER_SUPPORT == 1u)
 #if (APP_VCP_RDR_NUM_AIC_INSTANCES > 0)
@@ -335,6 +353,42 @@ uint32_t aAPP_BroadcastCode[4u] = {0x00000001, 0x00000002, 0x00000003, 0x0000000
 #else /*(BAP_BROADCAST_ENCRYPTION == 1)*/
 uint32_t aAPP_BroadcastCode[4u] = {0x00000000, 0x00000000, 0x00000000, 0x00000000};
 #endif /*(BAP_BROADCAST_ENCRYPTION == 1)*/
+
+/* Broadcast sink real-time measures */
+static APP_BSNK_StereoStats_t BSNK_StereoStats;
+static APP_BSNK_DecodeStats_t BSNK_DecodeStats;
+static const uint32_t BSNK_SampleFreqHz[SAMPLE_FREQ_48000_HZ + 1u] = {0, 8000, 11025, 16000, 22050, 24000, 32000,
+                                                                      44100, 48000};
+static uint32_t BSNK_FrameStartTs;
+static uint32_t BSNK_SlotReadyTs[2];
+static uint8_t BSNK_SlotsReady = 0x00;
+
+/* Language switch */
+static APP_BSNK_SwitchStats_t BSNK_SwitchStats;
+static uint32_t BSNK_SwitchStartCycles;
+static uint8_t BSNK_SwitchPending = 0;           /* measure armed, done on the first decoded frame */
+static uint8_t BSNK_SwitchRestart = 0;           /* switch by sink restart, measure armed by TMAPAPP_StartSink */
+static uint8_t BSNK_SwitchFast = 0;
+static uint8_t BSNK_BIGResync = 0;                /* BIG stopped for a re-sync on the same PA */
+
+/* Broadcast Source selection */
+static const char *const BSNK_DefaultSources[NUM_DEFAULT_SOURCES] = {"Public_TV_1", "Music_Player_1", "Music_Player_2"};
+static APP_BSNK_AllowEntry_t BSNK_DefaultAllowList[NUM_DEFAULT_SOURCES];
+static const APP_BSNK_AllowEntry_t *pBSNK_AllowList = &BSNK_DefaultAllowList[0];
+static uint8_t BSNK_AllowListSize = NUM_DEFAULT_SOURCES;
+static APP_BSNK_Candidate_t BSNK_Candidates[APP_BSNK_MAX_CANDIDATES];
+static uint8_t BSNK_NumCandidates = 0;
+static uint32_t BSNK_SelectWindowTs;
+static uint32_t BSNK_ScanStartTs;
+static uint32_t BSNK_SelectedBroadcastID = APP_BSNK_ANY_BROADCAST_ID;
+static uint32_t BSNK_SkippedBroadcastID = APP_BSNK_ANY_BROADCAST_ID;   /* skipped once by TMAPAPP_NextSource() */
+static APP_BSNK_SelectStats_t BSNK_SelectStats;
+
+/* Adaptive discovery scan */
+static UTIL_TIMER_Object_t BSNK_ScanBackoff_Timer;
+static APP_BSNK_ScanStats_t BSNK_ScanStats;
+static uint32_t BSNK_ScanSessionTs;
+static uint32_t BSNK_ScanLevelTs;
 #endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 
 /* Private functions prototypes-----------------------------------------------*/
@@ -353,6 +407,21 @@ static void APP_LinkupTaskHandler(void);
 #if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
 static uint8_t APP_BroadcastSetupAudio(Audio_Role_t role);
 static uint8_t APP_StartBroadcastAudio(Audio_Role_t role);
+static void APP_BSNK_SelectBIS(uint8_t BISIndex, Audio_Chnl_Allocation_t ChannelAlloc);
+static void APP_BSNK_AssignSlots(void);
+static void APP_BSNK_FrameRequested(void);
+static int8_t APP_BSNK_GetSlot(uint16_t ConnHandle);
+static uint8_t APP_BSNK_ResyncBIG(uint8_t SubgroupIdx);
+static void APP_BSNK_SwitchDone(void);
+static uint32_t APP_BSNK_GetCycles(void);
+static void APP_BSNK_AddCandidate(const BAP_Broadcast_Source_Adv_Report_Data_t *pReport, int8_t Priority, uint32_t Now);
+static void APP_BSNK_SelectSource(uint32_t Now);
+static uint8_t APP_BSNK_StartScan(uint8_t Level);
+static void APP_BSNK_SetScanLevel(uint8_t Level);
+static void APP_BSNK_StopScanSession(void);
+static void APP_BSNK_GetScanParams(uint8_t Level, uint16_t *pInterval, uint16_t *pWindow);
+static void APP_BSNK_ScanBackoff_TimerCallback(void *arg);
+static void APP_BSNK_ScanBackoffTask(void);
 #endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 static int32_t start_audio_source(void);
 static int32_t start_audio_sink(void);
@@ -387,6 +456,7 @@ static void TMAP_SchedulePendingContentControlOp(APP_ACL_Conn_t *pConn);
 /* Exported functions --------------------------------------------------------*/
 
 extern void APP_NotifyToRun(void);
+extern void CODEC_CLK_DumpNfracTrace(void);
 
 /* Functions Definition ------------------------------------------------------*/
 
@@ -448,6 +518,17 @@ void TMAPAPP_Init(uint8_t csip_config_id)
     UNUSED(status);
   }
 
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+  /* Default allow-list: the demonstration sources, whatever their Broadcast_ID */
+  for (uint8_t i = 0; i < NUM_DEFAULT_SOURCES; i++)
+  {
+    BSNK_DefaultAllowList[i].NameHash = TMAPAPP_NameHash((const uint8_t *) BSNK_DefaultSources[i],
+                                                         strlen(BSNK_DefaultSources[i]));
+    BSNK_DefaultAllowList[i].BroadcastID = APP_BSNK_ANY_BROADCAST_ID;
+    BSNK_DefaultAllowList[i].Priority = 0;
+  }
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
+
 #if (APP_VCP_ROLE_RENDERER_SUPPORT == 1u)
   /* volume initialization */
   if (VCP_RENDER_SetAbsVolume(Volume) != 0){
@@ -800,9 +881,34 @@ uint8_t TMAPAPP_StopAdvertising(void)
   return status;
 }
 
-void TMAPAPP_SwitchLanguage(void)
+/**
+  * @brief  Select the next subgroup (language) of the broadcast. When synchronized to the BIG, the
+  *         BISes of the new subgroup are taken from the BASE already parsed and only the BIG is
+  *         re-synchronized, the PA synchronization being kept
+  * @retval BLE_STATUS_SUCCESS if the BIG re-synchronization is started, else the sink has to be restarted
+  */
+uint8_t TMAPAPP_SwitchLanguage(void)
 {
-  SubgroupID = (SubgroupID + 1) % TMAPAPP_Context.BSNK.base_group.NumSubgroups;
+  uint8_t ret = HCI_COMMAND_DISALLOWED_ERR_CODE;
+
+  if (TMAPAPP_Context.BSNK.base_group.NumSubgroups > 0u)
+  {
+    SubgroupID = (SubgroupID + 1) % TMAPAPP_Context.BSNK.base_group.NumSubgroups;
+  }
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+  BSNK_SwitchStartCycles = APP_BSNK_GetCycles();
+  BSNK_SwitchPending = 0u;
+
+  ret = APP_BSNK_ResyncBIG(SubgroupID);
+  BSNK_SwitchFast = (ret == BLE_STATUS_SUCCESS);
+  /* frames of the old subgroup may still be decoded until the BIG is stopped: the measure is armed
+   * once it is, here for a BIG re-sync or by TMAPAPP_StartSink for a sink restart */
+  BSNK_SwitchPending = BSNK_SwitchFast;
+  BSNK_SwitchRestart = (BSNK_SwitchFast == 0u);
+  LOG_INFO_APP("Switch to subgroup %d by %s\n", SubgroupID, (BSNK_SwitchFast == 1u) ? "BIG re-sync" : "sink restart");
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
+
+  return ret;
 }
 
 uint8_t TMAPAPP_Disconnect(void)
@@ -1157,9 +1263,12 @@ void APP_NotifyTxAudioCplt(uint16_t AudioFrameSize)
   {
     if (TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_SYNCHRONIZED)
     {
+      APP_BSNK_FrameRequested();
       for (i = 0; i< TMAPAPP_Context.BSNK.current_num_bis; i++)
       {
-        CODEC_ReceiveData(TMAPAPP_Context.BSNK.current_BIS_conn_handles[i], 1, &aSnkBuff[0]  + AudioFrameSize/2 + i);
+        CODEC_ReceiveData(TMAPAPP_Context.BSNK.current_BIS_conn_handles[i],
+                          1,
+                          &aSnkBuff[0]  + AudioFrameSize/2 + TMAPAPP_Context.BSNK.current_BIS_slot[i]);
       }
     }
   }
@@ -1181,9 +1290,12 @@ void APP_NotifyTxAudioHalfCplt(void)
   {
     if (TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_SYNCHRONIZED)
     {
+      APP_BSNK_FrameRequested();
       for (i = 0; i< TMAPAPP_Context.BSNK.current_num_bis; i++)
       {
-        CODEC_ReceiveData(TMAPAPP_Context.BSNK.current_BIS_conn_handles[i], 1, &aSnkBuff[0] + i);
+        CODEC_ReceiveData(TMAPAPP_Context.BSNK.current_BIS_conn_handles[i],
+                          1,
+                          &aSnkBuff[0] + TMAPAPP_Context.BSNK.current_BIS_slot[i]);
       }
     }
   }
@@ -1195,23 +1307,81 @@ extern uint32_t Source_frame_size;
 
 void CODEC_NotifyDataReady(uint16_t conn_handle, void* decoded_data)
 {
-  /* When only one channel is active, duplicate it for fake stereo on SAI */
+  /* When only one channel is active on a stereo SAI buffer, duplicate it for fake stereo.
+   * With a mono SAI buffer (Snk_Channels = 1) the SAI mono mode does the duplication */
   uint32_t i;
   uint16_t *pData = (uint16_t *)(decoded_data);   /* 16 bits samples */
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+  int8_t slot = APP_BSNK_GetSlot(conn_handle);
 
-  if(pData == (pPrevData + 1)){
-    /* we start receiving two channels */
-    Nb_Active_Ch = 2;
+  if (slot >= 0)
+  {
+    uint32_t now = CODEC_CLK_GetHostTimestamp();
+
+    /* broadcast sink: the slots are known from the synchronized BISes */
+    Nb_Active_Ch = BSNK_StereoStats.nb_slots;
+    BSNK_SlotReadyTs[slot] = now;
+    BSNK_SlotsReady |= (1u << slot);
+    BSNK_StereoStats.decode_last_us[slot] = now - BSNK_FrameStartTs;
+    if (BSNK_SwitchPending == 1u)
+    {
+      APP_BSNK_SwitchDone();
+    }
+    if (BSNK_StereoStats.decode_last_us[slot] > BSNK_StereoStats.decode_peak_us[slot])
+    {
+      BSNK_StereoStats.decode_peak_us[slot] = BSNK_StereoStats.decode_last_us[slot];
+    }
+    if (BSNK_SlotsReady == 0x03)
+    {
+      BSNK_StereoStats.lr_skew_last_us = (BSNK_SlotReadyTs[1] > BSNK_SlotReadyTs[0]) ? (BSNK_SlotReadyTs[1] - BSNK_SlotReadyTs[0])
+                                                                                     : (BSNK_SlotReadyTs[0] - BSNK_SlotReadyTs[1]);
+      if (BSNK_StereoStats.lr_skew_last_us > BSNK_StereoStats.lr_skew_peak_us)
+      {
+        BSNK_StereoStats.lr_skew_peak_us = BSNK_StereoStats.lr_skew_last_us;
+      }
+    }
+    if ((BSNK_SlotsReady == ((1u << BSNK_StereoStats.nb_slots) - 1u))
+        && (BSNK_StereoStats.sample_freq <= SAMPLE_FREQ_48000_HZ))
+    {
+      /* every slot of the frame decoded at the broadcast rate */
+      BSNK_DecodeStats.nb_frames[BSNK_StereoStats.sample_freq]++;
+      if (BSNK_StereoStats.decode_last_us[slot] > BSNK_DecodeStats.peak_us[BSNK_StereoStats.sample_freq])
+      {
+        BSNK_DecodeStats.peak_us[BSNK_StereoStats.sample_freq] = BSNK_StereoStats.decode_last_us[slot];
+      }
+    }
+  }
+  else
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
+  {
+    if(pData == (pPrevData + 1)){
+      /* we start receiving two channels */
+      Nb_Active_Ch = 2;
+    }
   }
   pPrevData = pData;
 
-  if (Nb_Active_Ch < 2)
+  if (Nb_Active_Ch < Snk_Channels)
   {
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+    uint32_t start = CODEC_CLK_GetHostTimestamp();
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
+
     for (i = 0; i < Sink_frame_size/2; i+=2)
     {
       /* decoded_data is organized with a decimation equal to 2, so we duplicate each sample */
       pData[i+1] = pData[i];
     }
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+    if (slot >= 0)
+    {
+      BSNK_StereoStats.sw_dup_last_us = CODEC_CLK_GetHostTimestamp() - start;
+      if (BSNK_StereoStats.sw_dup_last_us > BSNK_StereoStats.sw_dup_peak_us)
+      {
+        BSNK_StereoStats.sw_dup_peak_us = BSNK_StereoStats.sw_dup_last_us;
+      }
+    }
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
   }
 }
 
@@ -1669,6 +1839,11 @@ uint8_t TMAPAPP_StartSink(void)
 
   LOG_INFO_APP(">>==  Start Sink\n");
 
+  BSNK_NumCandidates = 0u;
+  BSNK_ScanStartTs = HAL_GetTick();
+  BSNK_SwitchPending = BSNK_SwitchRestart;
+  BSNK_SwitchRestart = 0u;
+
   ret = CAP_Broadcast_StartAdvReportParsing();
   if (ret != BLE_STATUS_SUCCESS)
   {
@@ -1681,33 +1856,7 @@ uint8_t TMAPAPP_StartSink(void)
 
   if (ret == BLE_STATUS_SUCCESS)
   {
-    Scan_Param_Phy_t scan_param_phy;
-    scan_param_phy.Scan_Type     = 0x00; /*Passive scanning*/
-    scan_param_phy.Scan_Interval = SCAN_INTERVAL;
-    scan_param_phy.Scan_Window   = SCAN_WINDOW;
-    /* Starts an Observation procedure */
-    ret = aci_gap_ext_start_scan( 0x00,
-                                  GAP_OBSERVATION_PROC,
-                                  0x00,                         /* Address type: Public */
-                                  0x00,                         /* Filter duplicates: No */
-                                  0x00,                         /* Scan continuously until explicitly disable */
-                                  0x00,                         /* Scan continuously */
-                                  0x00,                         /* Filter policy: Accept all */
-                                  HCI_SCANNING_PHYS_LE_1M,
-                                  &scan_param_phy);
-    if (ret != BLE_STATUS_SUCCESS)
-    {
-      LOG_INFO_APP("  Fail   : aci_gap_ext_start_scan() function with Scan procedure 0x%02X, result: 0x%02X\n",
-                   GAP_OBSERVATION_PROC,
-                   ret);
-    }
-    else
-    {
-      LOG_INFO_APP("  Success: aci_gap_ext_start_scan() function with Scan procedure 0x%02X\n",
-                   GAP_OBSERVATION_PROC);
-      TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_SCANNING;
-      App_Notify_Evt(START_SCAN);
-    }
+    ret = APP_BSNK_StartScan(0u);
   }
 
   return ret;
@@ -1735,6 +1884,7 @@ uint8_t TMAPAPP_StopSink(void)
       TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_IDLE;
       App_Notify_Evt(STOP_SCAN);
       LOG_INFO_APP("  Success: aci_gap_terminate_gap_proc() function\n");
+      APP_BSNK_StopScanSession();
     }
   }
 
@@ -1780,6 +1930,8 @@ uint8_t TMAPAPP_StopSink(void)
       App_Notify_Evt(BIG_SYNC_LOST);
     }
   }
+  BSNK_BIGResync = 0u;
+  BSNK_SwitchPending = 0u;
 
   LOG_INFO_APP("   >>==  MX_AudioDeInit()\n");
   MX_AudioDeInit();
@@ -1794,7 +1946,10 @@ uint8_t TMAPAPP_StopSink(void)
 
 void TMAPAPP_NextSource(void)
 {
-  SourceID = (SourceID + 1) % NUM_SOURCES;
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+  /* The current source is ranked last at the next selection, so that another allowed source is chosen if present */
+  BSNK_SkippedBroadcastID = BSNK_SelectedBroadcastID;
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 }
 
 void TMAPAPP_ClearDatabase(void)
@@ -2439,6 +2594,15 @@ static tBleStatus CAPAPP_Init(Audio_Role_t AudioRole, uint8_t csip_config_id)
 #endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) */
   /*Register the Task dedicated to retry a Linkup procedure*/
   UTIL_SEQ_RegTask( 1u <<CFG_TASK_APP_LINKUP_RETRY_TIMER_ID, UTIL_SEQ_RFU,APP_LinkupTaskHandler);
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+  /*Register the Task dedicated to the back-off of the discovery scan*/
+  UTIL_SEQ_RegTask( 1u <<CFG_TASK_APP_SCAN_BACKOFF_ID, UTIL_SEQ_RFU, APP_BSNK_ScanBackoffTask);
+  UTIL_TIMER_Create(&BSNK_ScanBackoff_Timer,
+                    SCAN_BACKOFF_MS,
+                    UTIL_TIMER_ONESHOT,
+                    &APP_BSNK_ScanBackoff_TimerCallback,
+                    0);
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) */
 
   return status;
 }
@@ -4048,6 +4212,11 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
     {
       uint8_t status;
       LOG_INFO_APP(">>== CAP_BROADCAST_AUDIO_DOWN_EVT\n");
+      if (BSNK_BIGResync == 1u)
+      {
+        /* BIG re-synchronized to another subgroup: keep the PA sync and the audio clock */
+        break;
+      }
       MX_AudioDeInit();
 
       if (TMAPAPP_Context.BSNK.PASyncState != APP_PA_SYNC_STATE_IDLE)
@@ -4087,33 +4256,7 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
 
         if (status == BLE_STATUS_SUCCESS)
         {
-          Scan_Param_Phy_t scan_param_phy;
-          scan_param_phy.Scan_Type     = 0x00; /*Passive scanning*/
-          scan_param_phy.Scan_Interval = SCAN_INTERVAL;
-          scan_param_phy.Scan_Window   = SCAN_WINDOW;
-          /* Starts an Observation procedure */
-          status = aci_gap_ext_start_scan( 0x00,
-                                          GAP_OBSERVATION_PROC,
-                                          0x00,                         /* Address type: Public */
-                                          0x00,                         /* Filter duplicates: No */
-                                          0x00,                         /* Scan continuously until explicitly disable */
-                                          0x00,                         /* Scan continuously */
-                                          0x00,                         /* Filter policy: Accept all */
-                                          HCI_SCANNING_PHYS_LE_1M,
-                                          &scan_param_phy);
-          if (status != BLE_STATUS_SUCCESS)
-          {
-            LOG_INFO_APP("  Fail   : aci_gap_ext_start_scan() function with Scan procedure 0x%02X, result: 0x%02X\n",
-                         GAP_OBSERVATION_PROC,
-                         status);
-          }
-          else
-          {
-            LOG_INFO_APP("  Success: aci_gap_ext_start_scan() function with Scan procedure 0x%02X\n",
-                         GAP_OBSERVATION_PROC);
-            TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_SCANNING;
-            App_Notify_Evt(START_SCAN);
-          }
+          status = APP_BSNK_StartScan(0u);
         }
       }
     }
@@ -4123,72 +4266,64 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
     {
       BAP_Broadcast_Source_Adv_Report_Data_t *data = (BAP_Broadcast_Source_Adv_Report_Data_t*) pNotification->pInfo;
       LOG_INFO_APP(">>== CAP_BROADCAST_SOURCE_ADV_REPORT_EVT\n");
-      LOG_INFO_APP("     - Broadcasting Device with address %02X:%02X:%02X:%02X:%02X:%02X\n",
-                  data->pAdvAddress[5],
-                  data->pAdvAddress[4],
-                  data->pAdvAddress[3],
-                  data->pAdvAddress[2],
-                  data->pAdvAddress[1],
-                  data->pAdvAddress[0]);
       if(TMAPAPP_Context.BSNK.PASyncState == APP_PA_SYNC_STATE_IDLE
          && TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_IDLE)
       {
-        uint8_t parse_index = 0;
-        char name[30] = "Unknown";
-        char bid[12] = "ID:0x\0";
-        const uint8_t* name_ptr = 0;
+        uint32_t start = APP_BSNK_GetCycles();
+        uint32_t now = HAL_GetTick();
+        const uint8_t *p_name = 0;
         uint8_t name_len = 0;
+        int8_t priority;
+        uint8_t allowed = 0u;
 
-        while (parse_index + 3 < data->AdvertisingDataLength)
+        /* Reject on the Broadcast_ID already extracted by the CAP before walking the advertising data */
+        if ((APP_BSNK_IsIDAllowed(pBSNK_AllowList, BSNK_AllowListSize, data->BroadcastID) == 1u)
+            && (APP_BSNK_ParseAdvReport(data->pAdvertisingData, data->AdvertisingDataLength, &p_name, &name_len) == 1u))
         {
-          /* First priority to the Broadcast Name */
-          if (data->pAdvertisingData[parse_index + 1] == 0x30)
-          {
-            name_ptr = &data->pAdvertisingData[parse_index + 2];
-            name_len = MIN(data->pAdvertisingData[parse_index] - 1, 29);
-            break;
-          }
-          /* Second priority to the Complete Local Name */
-          else if (data->pAdvertisingData[parse_index + 1] == AD_TYPE_COMPLETE_LOCAL_NAME)
-          {
-            name_ptr = &data->pAdvertisingData[parse_index + 2];
-            name_len = MIN(data->pAdvertisingData[parse_index] - 1, 29);
-          }
-          /* Thrid priority to the Broadcast ID */
-          else if (data->pAdvertisingData[parse_index + 1] == AD_TYPE_SERVICE_DATA &&
-              data->pAdvertisingData[parse_index + 2] == 0x52 &&
-              data->pAdvertisingData[parse_index + 3] == 0x18)
+#if (CFG_TEST_VALIDATION == 1u)
+          if ((name_len < 8u) || (memcmp(p_name, "TMAP_WBA", 8u) != 0))
           {
-            sprintf(&bid[5],"%X", data->pAdvertisingData[parse_index + 6]);
-            sprintf(&bid[7],"%X", data->pAdvertisingData[parse_index + 5]);
-            sprintf(&bid[9],"%X",data->pAdvertisingData[parse_index + 4]);
+            return;
           }
-          parse_index += data->pAdvertisingData[parse_index] + 1;
+#endif /*(CFG_TEST_VALIDATION == 1u)*/
+          allowed = APP_BSNK_MatchAllowList(pBSNK_AllowList, BSNK_AllowListSize,
+                                            (p_name != 0) ? APP_BSNK_NameHash(p_name, name_len) : APP_BSNK_ANY_NAME,
+                                            data->BroadcastID,
+                                            &priority);
         }
-        if (name_ptr != 0)
+        BSNK_SelectStats.nb_reports++;
+        BSNK_SelectStats.parse_last_cycles = APP_BSNK_GetCycles() - start;
+        BSNK_SelectStats.parse_total_cycles += BSNK_SelectStats.parse_last_cycles;
+        if (BSNK_SelectStats.parse_last_cycles > BSNK_SelectStats.parse_peak_cycles)
         {
-          UTIL_MEM_cpy_8(&name[0], name_ptr, name_len);
-          name[name_len] = '\0';
+          BSNK_SelectStats.parse_peak_cycles = BSNK_SelectStats.parse_last_cycles;
         }
-        else if (bid[5] != '\0')
+
+        if (allowed == 1u)
         {
-          UTIL_MEM_cpy_8(&name[0], bid, 11);
-          name[11] = '\0';
+          LOG_INFO_APP("     - Allowed Broadcast Source with address %02X:%02X:%02X:%02X:%02X:%02X\n",
+                       data->pAdvAddress[5],
+                       data->pAdvAddress[4],
+                       data->pAdvAddress[3],
+                       data->pAdvAddress[2],
+                       data->pAdvAddress[1],
+                       data->pAdvAddress[0]);
+          APP_BSNK_AddCandidate(data, priority, now);
+          if (BSNK_ScanStats.discovery_ms == 0xFFFFFFFFu)
+          {
+            BSNK_ScanStats.discovery_ms = now - BSNK_ScanSessionTs;
+          }
+          /* Allowed source not selected yet: back to the fast scan to rank it within the selection window */
+          APP_BSNK_SetScanLevel(0u);
         }
-#if (CFG_TEST_VALIDATION == 1u)
-        if (memcmp(&name[0], "TMAP_WBA", 8u) != 0)
+        else
         {
-          return;
+          BSNK_SelectStats.nb_rejected++;
         }
-#endif /*(CFG_TEST_VALIDATION == 1u)*/
-
-        if (strcmp(&name[0], SourcesToSync[SourceID]) == 0)
+        /* Every allowed source advertising in the window has been ranked: synchronize to the best one */
+        if ((BSNK_NumCandidates > 0u) && ((now - BSNK_SelectWindowTs) >= APP_BSNK_SELECT_WINDOW_MS))
         {
-          CAP_Broadcast_AddSourceToBASS(data->AdvSID, data->AdvAddressType, (uint8_t *) &data->pAdvAddress[0],
-                                        data->BroadcastID, 0, aAPP_BroadcastCode);
-          TMAPAPP_SyncToPA(data->AdvSID, (uint8_t *) &data->pAdvAddress[0], data->AdvAddressType);
-          TMAPAPP_Context.BSNK.PASyncState = APP_PA_SYNC_STATE_SYNCHRONIZING;
-
+          APP_BSNK_SelectSource(now);
         }
       }
     }
@@ -4222,6 +4357,7 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
         TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_IDLE;
         App_Notify_Evt(STOP_SCAN);
         LOG_INFO_APP("  Success: aci_gap_terminate_gap_proc() function\n");
+        APP_BSNK_StopScanSession();
       }
     }
     break;
@@ -4254,10 +4390,11 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
                                                 &(index));
 
           TMAPAPP_Context.BSNK.base_group.pSubgroups = &(TMAPAPP_Context.BSNK.base_subgroups[0]);
-          TMAPAPP_Context.BSNK.base_subgroups[0].pCodecSpecificConf = &(TMAPAPP_Context.BSNK.codec_specific_config_subgroup[0][0]);
-          TMAPAPP_Context.BSNK.base_subgroups[0].pMetadata = &(TMAPAPP_Context.BSNK.subgroup_metadata[0][0]);
-          TMAPAPP_Context.BSNK.base_subgroups[1].pCodecSpecificConf = &(TMAPAPP_Context.BSNK.codec_specific_config_subgroup[1][0]);
-          TMAPAPP_Context.BSNK.base_subgroups[1].pMetadata = &(TMAPAPP_Context.BSNK.subgroup_metadata[1][0]);
+          for (i = 0; i < MAX_BSNK_NUM_SUBGROUPS; i++)
+          {
+            TMAPAPP_Context.BSNK.base_subgroups[i].pCodecSpecificConf = &(TMAPAPP_Context.BSNK.codec_specific_config_subgroup[i][0]);
+            TMAPAPP_Context.BSNK.base_subgroups[i].pMetadata = &(TMAPAPP_Context.BSNK.subgroup_metadata[i][0]);
+          }
 
 
           TMAPAPP_Context.BSNK.base_bis[0].pCodecSpecificConf = &(TMAPAPP_Context.BSNK.codec_specific_config_bis[0][0]);
@@ -4269,12 +4406,20 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
             LOG_INFO_APP("   Payload Len role : 0x%02x\n",base_data->BasePayloadLength);
             LOG_INFO_APP("   Presentation_delay: 0x%08x\n",TMAPAPP_Context.BSNK.base_group.PresentationDelay);
             LOG_INFO_APP("   Num_subgroups : 0x%02x\n",TMAPAPP_Context.BSNK.base_group.NumSubgroups);
+            if (TMAPAPP_Context.BSNK.base_group.NumSubgroups > MAX_BSNK_NUM_SUBGROUPS)
+            {
+              /* the subgroups are parsed in order, the last ones are dropped */
+              LOG_INFO_APP("   Only the first %d subgroups are parsed (MAX_BSNK_NUM_SUBGROUPS)\n", MAX_BSNK_NUM_SUBGROUPS);
+              TMAPAPP_Context.BSNK.base_group.NumSubgroups = MAX_BSNK_NUM_SUBGROUPS;
+            }
             base_data->pBasePayload += index;
             base_data->BasePayloadLength -= index;
 
             if(TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_IDLE)
             {
               TMAPAPP_Context.BSNK.num_sync_bis = 0;
+              TMAPAPP_Context.BSNK.sync_locations = 0x00000000;
+              memset(&TMAPAPP_Context.BSNK.subgroup_num_bis[0], 0, sizeof(TMAPAPP_Context.BSNK.subgroup_num_bis));
             }
 
             /* Parse Subgroups */
@@ -4367,8 +4512,8 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
                 if (channel_alloc == 0x00000000)
                 {
                   /* No channel alloc on BIS level, get channel alloc on subgroup level */
-                  channel_alloc = LTV_GetConfiguredAudioChannelAllocation(TMAPAPP_Context.BSNK.base_subgroups[num_total_bis].pCodecSpecificConf,
-                                                                          TMAPAPP_Context.BSNK.base_subgroups[num_total_bis].CodecSpecificConfLength);
+                  channel_alloc = LTV_GetConfiguredAudioChannelAllocation(TMAPAPP_Context.BSNK.base_subgroups[i].pCodecSpecificConf,
+                                                                          TMAPAPP_Context.BSNK.base_subgroups[i].CodecSpecificConfLength);
                 }
                 if(channel_alloc != 0x00000000)
                 {
@@ -4379,28 +4524,14 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
                 if(((TMAPAPP_Context.BSNK.base_group.NumSubgroups == 1) || (SubgroupID == i))
                    && (TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_IDLE))
                 {
-                  if (TMAPAPP_Context.BSNK.Audio_Location != 0x00000000)
-                  {
-                    /* check if the Channel allocation matches with the Sink Audio Location supported by the Broadcast Sink */
-                    if(channel_alloc != 0x00000000)
-                    {
-                      if ((TMAPAPP_Context.BSNK.Audio_Location & channel_alloc) != 0x00000000)
-                      {
-                        TMAPAPP_Context.BSNK.sync_bis_index[TMAPAPP_Context.BSNK.num_sync_bis] = TMAPAPP_Context.BSNK.base_bis[num_total_bis].BIS_Index;
-                        TMAPAPP_Context.BSNK.num_sync_bis++;
-                      }
-                    }
-                    else
-                    {
-                      TMAPAPP_Context.BSNK.sync_bis_index[TMAPAPP_Context.BSNK.num_sync_bis] = TMAPAPP_Context.BSNK.base_bis[num_total_bis].BIS_Index;
-                      TMAPAPP_Context.BSNK.num_sync_bis++;
-                    }
-                  }
-                  else
-                  {
-                    TMAPAPP_Context.BSNK.sync_bis_index[TMAPAPP_Context.BSNK.num_sync_bis] = TMAPAPP_Context.BSNK.base_bis[num_total_bis].BIS_Index;
-                    TMAPAPP_Context.BSNK.num_sync_bis++;
-                  }
+                  APP_BSNK_SelectBIS(TMAPAPP_Context.BSNK.base_bis[num_total_bis].BIS_Index, channel_alloc);
+                }
+                if (j < MAX_NUM_BIS_PER_BIG)
+                {
+                  /* kept for a language switch without parsing the BASE again */
+                  TMAPAPP_Context.BSNK.subgroup_bis_index[i][j] = TMAPAPP_Context.BSNK.base_bis[num_total_bis].BIS_Index;
+                  TMAPAPP_Context.BSNK.subgroup_bis_alloc[i][j] = channel_alloc;
+                  TMAPAPP_Context.BSNK.subgroup_num_bis[i] = j + 1u;
                 }
               }
             }
@@ -4473,6 +4604,7 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
         BAP_BIG_Sync_Established_Data_t *data = (BAP_BIG_Sync_Established_Data_t*) pNotification->pInfo;
         LOG_INFO_APP(">>== CAP_BROADCAST_BIG_SYNC_ESTABLISHED_EVT\n");
         LOG_INFO_APP("     - Status = 0x%02x\n",pNotification->Status);
+        BSNK_BIGResync = 0u;
 
         if (pNotification->Status == BLE_STATUS_SUCCESS)
         {
@@ -4483,6 +4615,7 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
                          data->pConnHandle,
                          (data->NumBISes * sizeof(uint16_t)));
           TMAPAPP_Context.BSNK.current_num_bis = data->NumBISes;
+          APP_BSNK_AssignSlots();
           TMAPAPP_Context.BSNK.BIGSyncState = APP_BIG_SYNC_STATE_SYNCHRONIZED;
 
           App_Notify_Evt(BIG_SYNC);
@@ -4499,6 +4632,32 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
     case CAP_BROADCAST_BIG_SYNC_LOST_EVT:
       {
         LOG_INFO_APP(">>== CAP_BROADCAST_BIG_SYNC_LOST_EVT\n");
+        LOG_INFO_APP("     - %d frames, %d late, decode peak L %d us R %d us, L/R skew peak %d us\n",
+                     BSNK_StereoStats.nb_frames,
+                     BSNK_StereoStats.nb_late_frames,
+                     BSNK_StereoStats.decode_peak_us[0],
+                     BSNK_StereoStats.decode_peak_us[1],
+                     BSNK_StereoStats.lr_skew_peak_us);
+        LOG_INFO_APP("     - SAI %d channel(s), DMA buffer %d bytes, software copy peak %d us (%d cycles)\n",
+                     BSNK_StereoStats.sai_channels,
+                     BSNK_StereoStats.sai_dma_bytes,
+                     BSNK_StereoStats.sw_dup_peak_us,
+                     BSNK_StereoStats.sw_dup_peak_us * (SystemCoreClock / 1000000u));
+        if (BSNK_StereoStats.sample_freq <= SAMPLE_FREQ_48000_HZ)
+        {
+          LOG_INFO_APP("     - LC3 decode at %d Hz: %d frames, peak %d us (%d cycles)\n",
+                       BSNK_SampleFreqHz[BSNK_StereoStats.sample_freq],
+                       BSNK_DecodeStats.nb_frames[BSNK_StereoStats.sample_freq],
+                       BSNK_DecodeStats.peak_us[BSNK_StereoStats.sample_freq],
+                       BSNK_DecodeStats.peak_us[BSNK_StereoStats.sample_freq] * (SystemCoreClock / 1000000u));
+        }
+        LOG_INFO_APP("     - %d language switches (%d by BIG re-sync), last %d us, peak BIG re-sync %d us, peak sink restart %d us\n",
+                     BSNK_SwitchStats.nb_switches,
+                     BSNK_SwitchStats.nb_fast,
+                     BSNK_SwitchStats.last_us,
+                     BSNK_SwitchStats.peak_fast_us,
+                     BSNK_SwitchStats.peak_full_us);
+        CODEC_CLK_DumpNfracTrace();
         TMAPAPP_Context.BSNK.BIGSyncState = APP_BIG_SYNC_STATE_IDLE;
         App_Notify_Evt(BIG_SYNC_LOST);
       }
@@ -4568,33 +4727,7 @@ static void TMAPAPP_CAPNotification(CAP_Notification_Evt_t *pNotification)
 
       if (status == BLE_STATUS_SUCCESS)
       {
-        Scan_Param_Phy_t scan_param_phy;
-        scan_param_phy.Scan_Type     = 0x00; /*Passive scanning*/
-        scan_param_phy.Scan_Interval = SCAN_INTERVAL;
-        scan_param_phy.Scan_Window   = SCAN_WINDOW;
-        /* Starts an Observation procedure */
-        status = aci_gap_ext_start_scan( 0x00,
-                                        GAP_OBSERVATION_PROC,
-                                        0x00,                         /* Address type: Public */
-                                        0x00,                         /* Filter duplicates: No */
-                                        0x00,                         /* Scan continuously until explicitly disable */
-                                        0x00,                         /* Scan continuously */
-                                        0x00,                         /* Filter policy: Accept all */
-                                        HCI_SCANNING_PHYS_LE_1M,
-                                        &scan_param_phy);
-        if (status != BLE_STATUS_SUCCESS)
-        {
-          LOG_INFO_APP("  Fail   : aci_gap_ext_start_scan() function with Scan procedure 0x%02X, result: 0x%02X\n",
-                       GAP_OBSERVATION_PROC,
-                       status);
-        }
-        else
-        {
-          LOG_INFO_APP("  Success: aci_gap_ext_start_scan() function with Scan procedure 0x%02X\n",
-                       GAP_OBSERVATION_PROC);
-          TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_SCANNING;
-          App_Notify_Evt(START_SCAN);
-        }
+        status = APP_BSNK_StartScan(0u);
       }
 
       *(pNotification->pInfo) = status;
@@ -4658,11 +4791,21 @@ static uint8_t APP_BroadcastSetupAudio(Audio_Role_t role)
   if ((sampling_freq != 0) && (frame_duration != 0xFF))
   {
     APP_StartBroadcastAudio(role);
+#if (APP_SNK_HW_SLOT_DUPLICATION == 1u)
+    /* a mono broadcast is sent on both SAI slots by the SAI mono mode */
+    Snk_Channels = BSNK_StereoStats.nb_slots;
+#else /*(APP_SNK_HW_SLOT_DUPLICATION == 1u)*/
+    Snk_Channels = 2u;
+#endif /*(APP_SNK_HW_SLOT_DUPLICATION == 1u)*/
     MX_AudioInit(role,
                  sampling_freq,
                  frame_duration,
                  (uint8_t *)aSnkBuff,
+                 Snk_Channels,
                  NULL);
+    BSNK_StereoStats.sai_channels = Snk_Channels;
+    BSNK_StereoStats.sai_dma_bytes = Sink_frame_size * sizeof(uint16_t);
+    BSNK_StereoStats.sample_freq = sampling_freq;
 
     /* AUDIO_ROLE_SINK */
     direction = DATA_PATH_OUTPUT;
@@ -4705,8 +4848,9 @@ static uint8_t APP_BroadcastSetupAudio(Audio_Role_t role)
     /* sample coded on 16bits */
     param.SampleDepth = 16;
 
-    /* SAI/I2C peripheral driver requests to set decimation to 2 (stereo buffer)*/
-    param.Decimation = 2;
+    /* The decimation is the LC3 output pointer increment: the number of interleaved channels of the SAI buffer.
+     * The LC3 library does not resample, the SAI clock follows the BASE sampling frequency instead */
+    param.Decimation = Snk_Channels;
 
     ret = CAP_Broadcast_SetupAudioDataPath(TMAPAPP_Context.BSNK.current_num_bis,
                                             &TMAPAPP_Context.BSNK.current_BIS_conn_handles[0],
@@ -4723,6 +4867,15 @@ static uint8_t APP_BroadcastSetupAudio(Audio_Role_t role)
     else
     {
       LOG_INFO_APP("  Success: CAP_Broadcast_SetupAudioDataPath() function\n");
+      LOG_INFO_APP("  %s sink on %d BIS(es), ISO & LC3 RAM %d bytes\n",
+                   (BSNK_StereoStats.nb_slots == 2u) ? "Stereo" : "Mono",
+                   TMAPAPP_Context.BSNK.current_num_bis,
+                   BSNK_StereoStats.iso_ram_bytes);
+      LOG_INFO_APP("  SAI %s, %d samples per frame: DMA buffer %d bytes, %d samples copied by software per frame\n",
+                   (Snk_Channels == 1u) ? "mono mode (slot duplication)" : "stereo",
+                   Sink_frame_size / (2u * Snk_Channels),
+                   BSNK_StereoStats.sai_dma_bytes,
+                   (BSNK_StereoStats.nb_slots < Snk_Channels) ? (Sink_frame_size / 4u) : 0u);
     }
   }
   else
@@ -4746,6 +4899,614 @@ static uint8_t APP_StartBroadcastAudio(Audio_Role_t role)
   }
   return 0;
 }
+
+/**
+  * @brief  Add a BIS of the chosen subgroup to the BIG synchronization list: one BIS per
+  *         Sink Audio Location, so that a stereo broadcast carrying left and right in two
+  *         BISes is received in true stereo
+  * @param  BISIndex: index of the BIS in the BIG
+  * @param  ChannelAlloc: channel allocation of the BIS, 0 if not configured
+  */
+static void APP_BSNK_SelectBIS(uint8_t BISIndex, Audio_Chnl_Allocation_t ChannelAlloc)
+{
+  uint8_t select = (TMAPAPP_Context.BSNK.num_sync_bis < MAX_NUM_BIS_PER_BIG);
+
+  if ((select == 1u) && (TMAPAPP_Context.BSNK.Audio_Location != 0x00000000) && (ChannelAlloc != 0x00000000))
+  {
+    /* check if the Channel allocation matches with a Sink Audio Location not received yet */
+    select = ((TMAPAPP_Context.BSNK.Audio_Location & ChannelAlloc & ~TMAPAPP_Context.BSNK.sync_locations) != 0x00000000);
+  }
+  if (select == 1u)
+  {
+    TMAPAPP_Context.BSNK.sync_bis_index[TMAPAPP_Context.BSNK.num_sync_bis] = BISIndex;
+    TMAPAPP_Context.BSNK.sync_bis_alloc[TMAPAPP_Context.BSNK.num_sync_bis] = ChannelAlloc;
+    TMAPAPP_Context.BSNK.sync_locations |= ChannelAlloc;
+    TMAPAPP_Context.BSNK.num_sync_bis++;
+  }
+}
+
+/**
+  * @brief  Assign a SAI stereo slot to each synchronized BIS (connection handles are given in
+  *         the order of the synchronization list) and reset the real-time measures
+  */
+static void APP_BSNK_AssignSlots(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < TMAPAPP_Context.BSNK.current_num_bis; i++)
+  {
+    TMAPAPP_Context.BSNK.current_BIS_slot[i] = 0;
+  }
+  if (TMAPAPP_Context.BSNK.current_num_bis >= 2u)
+  {
+    /* right only BIS goes to the right slot, the other BIS takes the remaining slot */
+    uint8_t right = ((TMAPAPP_Context.BSNK.sync_bis_alloc[0] & FRONT_RIGHT) != 0x00000000)
+                    && ((TMAPAPP_Context.BSNK.sync_bis_alloc[0] & FRONT_LEFT) == 0x00000000);
+
+    TMAPAPP_Context.BSNK.current_BIS_slot[0] = right;
+    TMAPAPP_Context.BSNK.current_BIS_slot[1] = 1u - right;
+  }
+
+  memset(&BSNK_StereoStats, 0, sizeof(BSNK_StereoStats));
+  BSNK_StereoStats.nb_slots = (TMAPAPP_Context.BSNK.current_num_bis >= 2u) ? 2u : 1u;
+  BSNK_StereoStats.iso_ram_bytes = sizeof(aLC3ChannelMemBuffer) + sizeof(aLC3StackMemBuffer)
+                                   + sizeof(aCodecPacketsMemory) + (SAI_SNK_MAX_BUFF_SIZE * sizeof(uint16_t));
+  BSNK_SlotsReady = 0x00;
+}
+
+/**
+  * @brief  Called on each SAI half buffer request: checks that every slot of the previous
+  *         frame was decoded in time and timestamps the new request
+  */
+static void APP_BSNK_FrameRequested(void)
+{
+  uint8_t expected = (BSNK_StereoStats.nb_slots == 2u) ? 0x03 : 0x01;
+
+  if ((BSNK_StereoStats.nb_frames > 0u) && (BSNK_SlotsReady != expected))
+  {
+    BSNK_StereoStats.nb_late_frames++;
+  }
+  BSNK_StereoStats.nb_frames++;
+  BSNK_SlotsReady = 0x00;
+  BSNK_FrameStartTs = CODEC_CLK_GetHostTimestamp();
+}
+
+/**
+  * @brief  Get the SAI stereo slot of a synchronized BIS
+  * @param  ConnHandle: BIS connection handle
+  * @retval slot, -1 if the handle isn't a synchronized BIS
+  */
+static int8_t APP_BSNK_GetSlot(uint16_t ConnHandle)
+{
+  int8_t slot = -1;
+
+  if (TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_SYNCHRONIZED)
+  {
+    for (uint8_t i = 0; (i < TMAPAPP_Context.BSNK.current_num_bis) && (slot < 0); i++)
+    {
+      if (TMAPAPP_Context.BSNK.current_BIS_conn_handles[i] == ConnHandle)
+      {
+        slot = (int8_t)TMAPAPP_Context.BSNK.current_BIS_slot[i];
+      }
+    }
+  }
+  return slot;
+}
+
+/**
+  * @brief  Get the broadcast sink real-time measures of the current BIG synchronization
+  * @param  pStats: measures
+  */
+void TMAPAPP_GetStereoStats(APP_BSNK_StereoStats_t *pStats)
+{
+  *pStats = BSNK_StereoStats;
+}
+
+/**
+  * @brief  Re-synchronize the BIG to the BISes of another subgroup of the parsed BASE, the PA
+  *         synchronization being kept; the audio path is set up again on the BIG sync established
+  *         event. If the new BIG sync can't be started, the BASE and BIGInfo reports of the PA
+  *         start it as after a BIG sync lost
+  * @param  SubgroupIdx: subgroup of the BASE
+  * @retval status, BLE_STATUS_SUCCESS if the BIG has been stopped for the re-synchronization
+  */
+static uint8_t APP_BSNK_ResyncBIG(uint8_t SubgroupIdx)
+{
+  uint8_t ret = HCI_COMMAND_DISALLOWED_ERR_CODE;
+  uint8_t status;
+  uint8_t i;
+
+  if ((TMAPAPP_Context.BSNK.BIGSyncState == APP_BIG_SYNC_STATE_SYNCHRONIZED)
+      && (TMAPAPP_Context.BSNK.PASyncState == APP_PA_SYNC_STATE_SYNCHRONIZED)
+      && (TMAPAPP_Context.NumConn == 0)
+      && (TMAPAPP_Context.BSNK.base_group.NumSubgroups > 1u)
+      && (SubgroupIdx < MAX_BSNK_NUM_SUBGROUPS)
+      && (TMAPAPP_Context.BSNK.subgroup_num_bis[SubgroupIdx] > 0u))
+  {
+    BSNK_BIGResync = 1u;
+    ret = CAP_Broadcast_StopBIGSync(BIG_HANDLE);
+    if (ret != BLE_STATUS_SUCCESS)
+    {
+      LOG_INFO_APP("  Fail   : CAP_Broadcast_StopBIGSync() function, result: 0x%02X\n", ret);
+      BSNK_BIGResync = 0u;
+    }
+    else
+    {
+      LOG_INFO_APP("  Success: CAP_Broadcast_StopBIGSync() function\n");
+      TMAPAPP_Context.BSNK.BIGSyncState = APP_BIG_SYNC_STATE_IDLE;
+
+      /* the SAI restarts on the new BISes, the audio clock is kept at the same frequency */
+      MX_AudioDeInit();
+      AudioClock_Init(TMAPAPP_Context.Audio_Frequency);
+
+      TMAPAPP_Context.BSNK.num_sync_bis = 0;
+      TMAPAPP_Context.BSNK.sync_locations = 0x00000000;
+      for (i = 0; i < TMAPAPP_Context.BSNK.subgroup_num_bis[SubgroupIdx]; i++)
+      {
+        APP_BSNK_SelectBIS(TMAPAPP_Context.BSNK.subgroup_bis_index[SubgroupIdx][i],
+                           TMAPAPP_Context.BSNK.subgroup_bis_alloc[SubgroupIdx][i]);
+      }
+
+      status = CAP_Broadcast_StartBIGSync(BIG_HANDLE,
+                                          TMAPAPP_Context.BSNK.PASyncHandle,
+                                          &(TMAPAPP_Context.BSNK.sync_bis_index[0]),
+                                          TMAPAPP_Context.BSNK.num_sync_bis,
+                                          &(TMAPAPP_Context.BSNK.base_group),
+                                          SubgroupIdx,
+                                          BAP_BROADCAST_ENCRYPTION,
+                                          aAPP_BroadcastCode,
+                                          BIG_MSE,
+                                          BIG_SYNC_TIMEOUT);
+      if (status != BLE_STATUS_SUCCESS)
+      {
+        LOG_INFO_APP("  Fail   : CAP_Broadcast_StartBIGSync() function, result: 0x%02X, wait for the next BIGInfo\n", status);
+      }
+      else
+      {
+        LOG_INFO_APP("  Success: CAP_Broadcast_StartBIGSync() function for %d BISes of subgroup %d\n",
+                     TMAPAPP_Context.BSNK.num_sync_bis,
+                     SubgroupIdx);
+        TMAPAPP_Context.BSNK.BIGSyncState = APP_BIG_SYNC_STATE_SYNCHRONIZING;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  First frame decoded after a language switch: updates the switch measures
+  */
+static void APP_BSNK_SwitchDone(void)
+{
+  BSNK_SwitchPending = 0u;
+  BSNK_SwitchStats.nb_switches++;
+  BSNK_SwitchStats.last_fast = BSNK_SwitchFast;
+  BSNK_SwitchStats.last_us = (APP_BSNK_GetCycles() - BSNK_SwitchStartCycles) / (SystemCoreClock / 1000000u);
+  if (BSNK_SwitchFast == 1u)
+  {
+    BSNK_SwitchStats.nb_fast++;
+    if (BSNK_SwitchStats.last_us > BSNK_SwitchStats.peak_fast_us)
+    {
+      BSNK_SwitchStats.peak_fast_us = BSNK_SwitchStats.last_us;
+    }
+  }
+  else if (BSNK_SwitchStats.last_us > BSNK_SwitchStats.peak_full_us)
+  {
+    BSNK_SwitchStats.peak_full_us = BSNK_SwitchStats.last_us;
+  }
+}
+
+/**
+  * @brief  Core clock cycles counter built on the HAL tick and the SysTick down-counter; unlike the
+  *         audio sync timer it keeps running when the audio clock is re-initialized, and unlike
+  *         DWT->CYCCNT it isn't reset by the link layer busy-waits. Wraps at 2^32 cycles
+  * @retval cycles
+  */
+static uint32_t APP_BSNK_GetCycles(void)
+{
+  uint32_t tick = HAL_GetTick();
+  uint32_t val = SysTick->VAL;
+
+  if (HAL_GetTick() != tick)
+  {
+    /* the tick incremented while reading the down-counter */
+    tick = HAL_GetTick();
+    val = SysTick->VAL;
+  }
+  return (tick * (SysTick->LOAD + 1u)) + (SysTick->LOAD - val);
+}
+
+/**
+  * @brief  Get the language switch measures
+  * @param  pStats: measures
+  */
+void TMAPAPP_GetSwitchStats(APP_BSNK_SwitchStats_t *pStats)
+{
+  *pStats = BSNK_SwitchStats;
+}
+
+/**
+  * @brief  Get the LC3 decode measures per sampling frequency
+  * @param  pStats: measures
+  */
+void TMAPAPP_GetDecodeStats(APP_BSNK_DecodeStats_t *pStats)
+{
+  *pStats = BSNK_DecodeStats;
+}
+
+/**
+  * @brief  Get the measures of the discovery scan sessions
+  * @param  pStats: measures
+  */
+void TMAPAPP_GetScanStats(APP_BSNK_ScanStats_t *pStats)
+{
+  *pStats = BSNK_ScanStats;
+}
+
+/**
+  * @brief  Scan parameters of a discovery scan level
+  * @param  Level: 0 for the fast scan, the interval being doubled at each level up to the background scan
+  * @param  pInterval: scan interval (*0.625ms)
+  * @param  pWindow: scan window (*0.625ms)
+  */
+static void APP_BSNK_GetScanParams(uint8_t Level, uint16_t *pInterval, uint16_t *pWindow)
+{
+  if (Level == 0u)
+  {
+    *pInterval = SCAN_FAST_INTERVAL;
+    *pWindow = SCAN_FAST_WINDOW;
+  }
+  else
+  {
+    *pInterval = MIN(((uint32_t) SCAN_FAST_INTERVAL) << Level, SCAN_SLOW_INTERVAL);
+    *pWindow = SCAN_SLOW_WINDOW;
+  }
+}
+
+/**
+  * @brief  Start the observation procedure at a discovery scan level, a new scan session being opened if the sink
+  *         was not scanning
+  * @param  Level: scan level, 0 for the fast scan
+  * @retval status
+  */
+static uint8_t APP_BSNK_StartScan(uint8_t Level)
+{
+  Scan_Param_Phy_t scan_param_phy;
+  uint16_t interval;
+  uint16_t window;
+  uint32_t now = HAL_GetTick();
+  uint8_t ret;
+
+  APP_BSNK_GetScanParams(Level, &interval, &window);
+  scan_param_phy.Scan_Type     = 0x00; /*Passive scanning*/
+  scan_param_phy.Scan_Interval = interval;
+  scan_param_phy.Scan_Window   = window;
+  /* Starts an Observation procedure */
+  ret = aci_gap_ext_start_scan( 0x00,
+                                GAP_OBSERVATION_PROC,
+                                0x00,                         /* Address type: Public */
+                                0x00,                         /* Filter duplicates: No */
+                                0x00,                         /* Scan continuously until explicitly disable */
+                                0x00,                         /* Scan continuously */
+                                0x00,                         /* Filter policy: Accept all */
+                                HCI_SCANNING_PHYS_LE_1M,
+                                &scan_param_phy);
+  if (ret != BLE_STATUS_SUCCESS)
+  {
+    LOG_INFO_APP("  Fail   : aci_gap_ext_start_scan() function with Scan procedure 0x%02X, result: 0x%02X\n",
+                 GAP_OBSERVATION_PROC,
+                 ret);
+  }
+  else
+  {
+    LOG_INFO_APP("  Success: aci_gap_ext_start_scan() function with Scan procedure 0x%02X, interval 0x%04X, window 0x%04X\n",
+                 GAP_OBSERVATION_PROC,
+                 interval,
+                 window);
+    if (TMAPAPP_Context.BSNK.ScanState != APP_SCAN_STATE_SCANNING)
+    {
+      BSNK_ScanSessionTs = now;
+      BSNK_ScanStats.nb_sessions++;
+      BSNK_ScanStats.radio_on_ms = 0u;
+      BSNK_ScanStats.discovery_ms = 0xFFFFFFFFu;
+      BSNK_ScanStats.nb_backoffs = 0u;
+      TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_SCANNING;
+      App_Notify_Evt(START_SCAN);
+    }
+    BSNK_ScanStats.level = Level;
+    BSNK_ScanLevelTs = now;
+    if (interval < SCAN_SLOW_INTERVAL)
+    {
+      UTIL_TIMER_Start(&BSNK_ScanBackoff_Timer);
+    }
+    else
+    {
+      UTIL_TIMER_Stop(&BSNK_ScanBackoff_Timer);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Restart the discovery scan at another level
+  * @param  Level: scan level, 0 for the fast scan
+  */
+static void APP_BSNK_SetScanLevel(uint8_t Level)
+{
+  uint16_t interval;
+  uint16_t window;
+  uint32_t now = HAL_GetTick();
+  uint8_t prev_level = BSNK_ScanStats.level;
+  uint8_t ret;
+
+  if ((TMAPAPP_Context.BSNK.ScanState != APP_SCAN_STATE_SCANNING) || (Level == BSNK_ScanStats.level))
+  {
+    return;
+  }
+
+  ret = aci_gap_terminate_gap_proc(GAP_OBSERVATION_PROC);
+  if (ret != BLE_STATUS_SUCCESS)
+  {
+    LOG_INFO_APP("  Fail   : aci_gap_terminate_gap_proc() function, result: 0x%02X\n", ret);
+    return;
+  }
+  APP_BSNK_GetScanParams(BSNK_ScanStats.level, &interval, &window);
+  BSNK_ScanStats.radio_on_ms += ((now - BSNK_ScanLevelTs) * window) / interval;
+  BSNK_ScanLevelTs = now;
+  ret = APP_BSNK_StartScan(Level);
+  if (ret != BLE_STATUS_SUCCESS)
+  {
+    /* keep scanning at the previous level, the back-off timer being re-armed for a next level change */
+    ret = APP_BSNK_StartScan(prev_level);
+  }
+  if (ret != BLE_STATUS_SUCCESS)
+  {
+    TMAPAPP_Context.BSNK.ScanState = APP_SCAN_STATE_IDLE;
+    App_Notify_Evt(STOP_SCAN);
+    APP_BSNK_StopScanSession();
+  }
+}
+
+/**
+  * @brief  End of a discovery scan session: updates and logs the session measures
+  */
+static void APP_BSNK_StopScanSession(void)
+{
+  uint16_t interval;
+  uint16_t window;
+  uint32_t now = HAL_GetTick();
+
+  UTIL_TIMER_Stop(&BSNK_ScanBackoff_Timer);
+  APP_BSNK_GetScanParams(BSNK_ScanStats.level, &interval, &window);
+  BSNK_ScanStats.radio_on_ms += ((now - BSNK_ScanLevelTs) * window) / interval;
+  BSNK_ScanStats.session_ms = now - BSNK_ScanSessionTs;
+  LOG_INFO_APP("Scan session %d: %d ms, radio on %d ms, discovery %d ms, %d back-offs\n",
+               BSNK_ScanStats.nb_sessions,
+               BSNK_ScanStats.session_ms,
+               BSNK_ScanStats.radio_on_ms,
+               BSNK_ScanStats.discovery_ms,
+               BSNK_ScanStats.nb_backoffs);
+}
+
+static void APP_BSNK_ScanBackoff_TimerCallback(void *arg)
+{
+  UTIL_SEQ_SetTask(1U << CFG_TASK_APP_SCAN_BACKOFF_ID, CFG_SEQ_PRIO_0);
+}
+
+/**
+  * @brief  End of a scan level period: the sources not reported anymore are dropped, then the best remaining
+  *         source is selected if the selection window is over, else with no allowed source left the scan backs
+  *         off toward the background scan
+  */
+static void APP_BSNK_ScanBackoffTask(void)
+{
+  uint32_t now = HAL_GetTick();
+  uint8_t num_cand = 0u;
+
+  if (TMAPAPP_Context.BSNK.PASyncState != APP_PA_SYNC_STATE_IDLE)
+  {
+    return;
+  }
+
+  for (uint8_t i = 0; i < BSNK_NumCandidates; i++)
+  {
+    if ((now - BSNK_Candidates[i].LastReportTs) < APP_BSNK_CANDIDATE_TIMEOUT_MS)
+    {
+      BSNK_Candidates[num_cand++] = BSNK_Candidates[i];
+    }
+  }
+  BSNK_NumCandidates = num_cand;
+
+  if (BSNK_NumCandidates == 0u)
+  {
+    BSNK_ScanStats.nb_backoffs++;
+    APP_BSNK_SetScanLevel(BSNK_ScanStats.level + 1u);
+  }
+  else if ((now - BSNK_SelectWindowTs) >= APP_BSNK_SELECT_WINDOW_MS)
+  {
+    /* no report closed the selection window */
+    APP_BSNK_SelectSource(now);
+  }
+  else
+  {
+    UTIL_TIMER_Start(&BSNK_ScanBackoff_Timer);
+  }
+}
+
+/**
+  * @brief  Hash of a Broadcast Name used in the allow-list (32-bit FNV-1a)
+  * @param  pName: name, not null terminated
+  * @param  Length: name length
+  * @retval hash, never APP_BSNK_ANY_NAME
+  */
+uint32_t TMAPAPP_NameHash(const uint8_t *pName, uint8_t Length)
+{
+  return APP_BSNK_NameHash(pName, Length);
+}
+
+/**
+  * @brief  Set the Broadcast Sources allow-list used at the next sink start
+  * @param  pList: entries, kept by reference until the next call. NULL restores the default list
+  * @param  NumEntries: number of entries
+  */
+void TMAPAPP_SetAllowList(const APP_BSNK_AllowEntry_t *pList, uint8_t NumEntries)
+{
+  if (pList == 0)
+  {
+    pBSNK_AllowList = &BSNK_DefaultAllowList[0];
+    BSNK_AllowListSize = NUM_DEFAULT_SOURCES;
+  }
+  else
+  {
+    pBSNK_AllowList = pList;
+    BSNK_AllowListSize = NumEntries;
+  }
+  LOG_INFO_APP("Broadcast Source allow-list of %d entries\n", BSNK_AllowListSize);
+}
+
+/**
+  * @brief  RSSI of an extended advertising report, used to rank the candidate sources
+  * @note   The Broadcast Source advertising report notified by the CAP does not carry the RSSI
+  * @param  pAdvAddress: advertiser address
+  * @param  AdvSID: advertising set identifier
+  * @param  RSSI: in dBm, 127 if not available
+  */
+void TMAPAPP_AdvReportRSSI(const uint8_t *pAdvAddress, uint8_t AdvSID, int8_t RSSI)
+{
+  for (uint8_t i = 0; i < BSNK_NumCandidates; i++)
+  {
+    if ((BSNK_Candidates[i].AdvSID == AdvSID) && (memcmp(&BSNK_Candidates[i].AdvAddress[0], pAdvAddress, 6u) == 0))
+    {
+      BSNK_Candidates[i].RSSI = RSSI;
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  Get the Broadcast Source selection measures
+  * @param  pStats: measures
+  */
+void TMAPAPP_GetSelectStats(APP_BSNK_SelectStats_t *pStats)
+{
+  *pStats = BSNK_SelectStats;
+}
+
+/**
+  * @brief  Add or refresh an allowed Broadcast Source in the candidates of the selection window
+  * @param  pReport: Broadcast Source advertising report
+  * @param  Priority: priority of the matching allow-list entry
+  * @param  Now: report timestamp (ms)
+  */
+static void APP_BSNK_AddCandidate(const BAP_Broadcast_Source_Adv_Report_Data_t *pReport, int8_t Priority, uint32_t Now)
+{
+  APP_BSNK_Candidate_t *p_cand = 0;
+
+  for (uint8_t i = 0; i < BSNK_NumCandidates; i++)
+  {
+    if ((BSNK_Candidates[i].AdvSID == pReport->AdvSID)
+        && (memcmp(&BSNK_Candidates[i].AdvAddress[0], pReport->pAdvAddress, 6u) == 0))
+    {
+      p_cand = &BSNK_Candidates[i];
+      break;
+    }
+  }
+  if (p_cand == 0)
+  {
+    if (BSNK_NumCandidates == APP_BSNK_MAX_CANDIDATES)
+    {
+      return;
+    }
+    if (BSNK_NumCandidates == 0u)
+    {
+      /* First allowed source: opens the selection window */
+      BSNK_SelectWindowTs = Now;
+    }
+    p_cand = &BSNK_Candidates[BSNK_NumCandidates++];
+    UTIL_MEM_cpy_8(&p_cand->AdvAddress[0], pReport->pAdvAddress, 6u);
+    p_cand->AdvAddressType = pReport->AdvAddressType;
+    p_cand->AdvSID = pReport->AdvSID;
+    p_cand->RSSI = RSSI_NOT_AVAILABLE;
+  }
+  p_cand->BroadcastID = pReport->BroadcastID;
+  p_cand->Priority = Priority;
+  p_cand->LastReportTs = Now;
+}
+
+/**
+  * @brief  End of the selection window: synchronize to the best ranked Broadcast Source
+  * @param  Now: current timestamp (ms)
+  */
+static void APP_BSNK_SelectSource(uint32_t Now)
+{
+  APP_BSNK_Candidate_t *p_best = 0;
+  int32_t best_score = INT32_MIN;
+  uint8_t num_not_skipped = 0u;
+
+  for (uint8_t i = 0; i < BSNK_NumCandidates; i++)
+  {
+    if (BSNK_Candidates[i].BroadcastID != BSNK_SkippedBroadcastID)
+    {
+      num_not_skipped++;
+    }
+  }
+
+  for (uint8_t i = 0; i < BSNK_NumCandidates; i++)
+  {
+    APP_BSNK_Candidate_t *p_cand = &BSNK_Candidates[i];
+    int32_t score;
+
+    /* the skipped source is taken again only if it is the only one heard */
+    if ((p_cand->BroadcastID == BSNK_SkippedBroadcastID) && (num_not_skipped > 0u))
+    {
+      continue;
+    }
+    score = (p_cand->RSSI == RSSI_NOT_AVAILABLE) ? -127 : p_cand->RSSI;
+    score += p_cand->Priority;
+    score -= (int32_t) ((Now - p_cand->LastReportTs) / APP_BSNK_RECENCY_PENALTY_MS);
+    if (score > best_score)
+    {
+      best_score = score;
+      p_best = p_cand;
+    }
+  }
+
+  if (p_best == 0)
+  {
+    /* no candidate */
+    return;
+  }
+
+  BSNK_SkippedBroadcastID = APP_BSNK_ANY_BROADCAST_ID;
+  BSNK_SelectedBroadcastID = p_best->BroadcastID;
+  BSNK_SelectStats.nb_selections++;
+  BSNK_SelectStats.last_ms = Now - BSNK_ScanStartTs;
+  if (BSNK_SelectStats.last_ms > BSNK_SelectStats.peak_ms)
+  {
+    BSNK_SelectStats.peak_ms = BSNK_SelectStats.last_ms;
+  }
+  BSNK_SelectStats.last_nb_candidates = BSNK_NumCandidates;
+  BSNK_SelectStats.last_rssi = p_best->RSSI;
+  BSNK_SelectStats.last_broadcast_id = p_best->BroadcastID;
+  LOG_INFO_APP("Select Broadcast ID 0x%06X among %d sources (RSSI %d dBm) in %d ms\n",
+               BSNK_SelectStats.last_broadcast_id,
+               BSNK_SelectStats.last_nb_candidates,
+               BSNK_SelectStats.last_rssi,
+               BSNK_SelectStats.last_ms);
+  LOG_INFO_APP("Advertising reports: %d (%d rejected), parsing mean %d cycles, peak %d cycles\n",
+               BSNK_SelectStats.nb_reports,
+               BSNK_SelectStats.nb_rejected,
+               (uint32_t)(BSNK_SelectStats.parse_total_cycles / BSNK_SelectStats.nb_reports),
+               BSNK_SelectStats.parse_peak_cycles);
+  BSNK_NumCandidates = 0u;
+
+  CAP_Broadcast_AddSourceToBASS(p_best->AdvSID, p_best->AdvAddressType, &p_best->AdvAddress[0],
+                                p_best->BroadcastID, 0, aAPP_BroadcastCode);
+  TMAPAPP_SyncToPA(p_best->AdvSID, &p_best->AdvAddress[0], p_best->AdvAddressType);
+  TMAPAPP_Context.BSNK.PASyncState = APP_PA_SYNC_STATE_SYNCHRONIZING;
+}
 #endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 
 static uint8_t TMAPAPP_BuildAdvDataPacket(uint8_t *pAdvData,
@@ -5263,10 +6024,13 @@ static uint8_t APP_UnicastSetupAudioDataPath(uint16_t ACL_ConnHandle,
        }
 
       LOG_INFO_APP("Configure Audio Periphal drivers at Sampling frequency %d\n",frequency);
+      /* the number of channels per CIS is only known on reception: keep a stereo SAI buffer */
+      Snk_Channels = 2u;
       MX_AudioInit(role,
                    frequency,
                    frame_duration,
                    (uint8_t *)aSnkBuff,
+                   Snk_Channels,
                    (uint8_t *)pSrcBuff);
     }
     if (role == AUDIO_ROLE_SOURCE)
@@ -5308,7 +6072,7 @@ static uint8_t APP_UnicastSetupAudioDataPath(uint16_t ACL_ConnHandle,
     /* input data path */
     param.SampleDepth = 16;
 
-    /* SAI/I2C peripheral driver requests to set decimation to 2*/
+    /* SAI/I2C peripheral driver requests to set decimation to the number of channels of its buffer */
 
     if (role == AUDIO_ROLE_SOURCE)
     {
@@ -5316,7 +6080,7 @@ static uint8_t APP_UnicastSetupAudioDataPath(uint16_t ACL_ConnHandle,
     }
     else
     {
-      param.Decimation = 2;
+      param.Decimation = Snk_Channels;
     }
 
     /*Data Path ID is vendor-specific transport interface : 0x01 for "Shared memory of SAI"*/
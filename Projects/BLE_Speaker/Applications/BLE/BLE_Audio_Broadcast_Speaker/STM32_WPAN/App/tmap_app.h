@@ -31,6 +31,7 @@ extern "C" {
 #include "tmap.h"
 #include "tmap_app_conf.h"
 #include "app_conf.h"
+#include "tmap_app_bsnk_adv.h"
 /* Private includes ----------------------------------------------------------*/
 
 /* Exported constants --------------------------------------------------------*/
@@ -392,13 +393,13 @@ typedef struct
 typedef struct
 {
   BAP_BASE_Group_t              base_group;
-  BAP_BASE_Subgroup_t           base_subgroups[2];
+  BAP_BASE_Subgroup_t           base_subgroups[MAX_BSNK_NUM_SUBGROUPS];
   BAP_BASE_BIS_t                base_bis[2];
   uint8_t                       codec_specific_config_bis[2][MAX_BSNK_BIS_CODEC_CONFIG_SIZE];
-  uint8_t                       codec_specific_config_subgroup[2][MAX_BSNK_SUBGROUP_CODEC_CONFIG_SIZE];
+  uint8_t                       codec_specific_config_subgroup[MAX_BSNK_NUM_SUBGROUPS][MAX_BSNK_SUBGROUP_CODEC_CONFIG_SIZE];
   uint8_t                       RTN;
   uint16_t                      max_transport_latency;
-  uint8_t                       subgroup_metadata[2][MAX_BSNK_METADATA_LEN];
+  uint8_t                       subgroup_metadata[MAX_BSNK_NUM_SUBGROUPS][MAX_BSNK_METADATA_LEN];
   Target_Phy_t                  phy;
   uint8_t                       encryption;
   uint32_t                      broadcast_code[4u];
@@ -413,8 +414,79 @@ typedef struct
   uint8_t                       PASyncHandle;
   Audio_Location_t              Audio_Location;
   uint8_t                       sync_bis_index[APP_MAX_NUM_BIS];
+  Audio_Chnl_Allocation_t       sync_bis_alloc[APP_MAX_NUM_BIS];    /* channel allocation of each BIS to sync, 0 if unknown */
+  Audio_Chnl_Allocation_t       sync_locations;                     /* audio locations already covered by the BISes to sync */
   uint8_t                       num_sync_bis;
+  uint8_t                       current_BIS_slot[APP_MAX_NUM_BIS];  /* SAI stereo slot (0: left, 1: right) of each synchronized BIS */
+  uint8_t                       subgroup_num_bis[MAX_BSNK_NUM_SUBGROUPS]; /* BISes of each parsed BASE subgroup, kept for the language switch */
+  uint8_t                       subgroup_bis_index[MAX_BSNK_NUM_SUBGROUPS][MAX_NUM_BIS_PER_BIG];
+  Audio_Chnl_Allocation_t       subgroup_bis_alloc[MAX_BSNK_NUM_SUBGROUPS][MAX_NUM_BIS_PER_BIG];
 } APP_BNSK_Context_t;
+
+/* Broadcast sink real-time measures, times taken with the audio sync timer (1 us) */
+typedef struct
+{
+  uint32_t                      nb_frames;                          /* SAI half buffers requested to the codec manager */
+  uint32_t                      nb_late_frames;                     /* frames with a slot not decoded before the next SAI request */
+  uint8_t                       nb_slots;                           /* 2: true stereo from two BISes, 1: mono duplicated on both slots */
+  uint32_t                      decode_last_us[2];                  /* SAI request to decoded data, per slot */
+  uint32_t                      decode_peak_us[2];
+  uint32_t                      lr_skew_last_us;                    /* between left & right decoded data of a frame */
+  uint32_t                      lr_skew_peak_us;
+  uint32_t                      iso_ram_bytes;                      /* LC3 channels & stack, ISO packets pools and SAI sink buffer */
+  uint8_t                       sai_channels;                       /* 1: SAI mono mode duplicates the samples on both slots */
+  uint32_t                      sai_dma_bytes;                      /* SAI sink double buffer used for the frame duration */
+  uint32_t                      sw_dup_last_us;                     /* software mono to stereo copy of a frame */
+  uint32_t                      sw_dup_peak_us;
+  uint8_t                       sample_freq;                        /* BASE Sampling_Frequency type, the LC3 output and
+                                                                     * the SAI running at this rate */
+} APP_BSNK_StereoStats_t;
+
+/* LC3 decode measures per BASE Sampling_Frequency type (index), kept across the sink sessions */
+typedef struct
+{
+  uint32_t                      nb_frames[SAMPLE_FREQ_48000_HZ + 1u];
+  uint32_t                      peak_us[SAMPLE_FREQ_48000_HZ + 1u];  /* SAI request to the last slot decoded */
+} APP_BSNK_DecodeStats_t;
+
+/* Language switch measures, from the switch request to the first decoded frame of the new subgroup */
+typedef struct
+{
+  uint32_t                      nb_switches;
+  uint32_t                      nb_fast;                            /* BIG only re-sync, the PA sync and the parsed BASE being kept */
+  uint8_t                       last_fast;
+  uint32_t                      last_us;
+  uint32_t                      peak_fast_us;
+  uint32_t                      peak_full_us;                       /* sink stop, scan, PA sync, BASE parsing and BIG sync */
+} APP_BSNK_SwitchStats_t;
+
+/* Broadcast Source selection measures, selection times taken with the HAL tick (1 ms) */
+typedef struct
+{
+  uint32_t                      nb_selections;
+  uint32_t                      last_ms;                            /* scan start to PA sync request */
+  uint32_t                      peak_ms;
+  uint8_t                       last_nb_candidates;                 /* matching sources ranked in the window */
+  int8_t                        last_rssi;
+  uint32_t                      last_broadcast_id;
+  uint32_t                      nb_reports;                         /* Broadcast Source advertising reports parsed */
+  uint32_t                      nb_rejected;                        /* reports not matching the allow-list */
+  uint32_t                      parse_last_cycles;                  /* report parsing and allow-list matching, in core
+                                                                     * clock cycles (HAL tick and SysTick counter) */
+  uint32_t                      parse_peak_cycles;
+  uint64_t                      parse_total_cycles;
+} APP_BSNK_SelectStats_t;
+
+/* Discovery scan session measures, from the scan start to the scan stop, times taken with the HAL tick (1 ms) */
+typedef struct
+{
+  uint32_t                      nb_sessions;
+  uint32_t                      session_ms;
+  uint32_t                      radio_on_ms;                        /* scan windows time at the successive levels */
+  uint32_t                      discovery_ms;                       /* first allowed source report, 0xFFFFFFFF if none */
+  uint8_t                       nb_backoffs;
+  uint8_t                       level;                              /* 0: fast scan, the interval doubling per level */
+} APP_BSNK_ScanStats_t;
 #endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 
 typedef struct
@@ -586,7 +658,17 @@ uint8_t TMAPAPP_StartSink(void);
 uint8_t TMAPAPP_StopSink(void);
 void TMAPAPP_NextSource(void);
 void TMAPAPP_SetBroadcastMode(APP_BroadcastMode_t mode);
-void TMAPAPP_SwitchLanguage(void);
+uint8_t TMAPAPP_SwitchLanguage(void);
+#if ((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)
+void TMAPAPP_GetStereoStats(APP_BSNK_StereoStats_t *pStats);
+void TMAPAPP_GetSwitchStats(APP_BSNK_SwitchStats_t *pStats);
+void TMAPAPP_GetDecodeStats(APP_BSNK_DecodeStats_t *pStats);
+uint32_t TMAPAPP_NameHash(const uint8_t *pName, uint8_t Length);
+void TMAPAPP_SetAllowList(const APP_BSNK_AllowEntry_t *pList, uint8_t NumEntries);
+void TMAPAPP_AdvReportRSSI(const uint8_t *pAdvAddress, uint8_t AdvSID, int8_t RSSI);
+void TMAPAPP_GetSelectStats(APP_BSNK_SelectStats_t *pStats);
+void TMAPAPP_GetScanStats(APP_BSNK_ScanStats_t *pStats);
+#endif /*((APP_TMAP_ROLE & TMAP_ROLE_BROADCAST_MEDIA_RECEIVER) == TMAP_ROLE_BROADCAST_MEDIA_RECEIVER)*/
 void TMAPAPP_ClearDatabase(void);
 #ifdef __cplusplus
 }
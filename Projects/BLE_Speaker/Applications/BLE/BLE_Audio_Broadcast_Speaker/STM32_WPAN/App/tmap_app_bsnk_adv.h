@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file    tmap_app_bsnk_adv.h
+  * @author  MCD Application Team
+  * @brief   Broadcast Sink filtering of the Broadcast Source advertising
+  *          reports: advertising data parsing and allow-list matching.
+  *          Shared by tmap_app.c and its host benchmark tmap_app_bsnk_bench.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#ifndef TMAP_APP_BSNK_ADV_H
+#define TMAP_APP_BSNK_ADV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define APP_BSNK_ANY_NAME                       (0x00000000u)
+#define APP_BSNK_ANY_BROADCAST_ID               (0xFFFFFFFFu)
+
+#define AD_TYPE_BROADCAST_NAME                  (0x30u)
+#ifndef AD_TYPE_COMPLETE_LOCAL_NAME
+#define AD_TYPE_COMPLETE_LOCAL_NAME             0x09U             /* as in ble_std.h */
+#endif /* AD_TYPE_COMPLETE_LOCAL_NAME */
+
+/* Exported types ------------------------------------------------------------*/
+/* Broadcast Source allow-list entry, a source matches when both its name hash and its Broadcast_ID match */
+typedef struct
+{
+  uint32_t                      NameHash;                           /* TMAPAPP_NameHash() of the Broadcast Name, or
+                                                                     * APP_BSNK_ANY_NAME */
+  uint32_t                      BroadcastID;                        /* or APP_BSNK_ANY_BROADCAST_ID */
+  int8_t                        Priority;                           /* dB added to the RSSI when ranking the sources */
+} APP_BSNK_AllowEntry_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Hash of a Broadcast Name used in the allow-list (32-bit FNV-1a)
+  * @param  pName: name, not null terminated
+  * @param  Length: name length
+  * @retval hash, never APP_BSNK_ANY_NAME
+  */
+static inline uint32_t APP_BSNK_NameHash(const uint8_t *pName, uint8_t Length)
+{
+  uint32_t hash = 2166136261u;
+
+  for (uint8_t i = 0; i < Length; i++)
+  {
+    hash ^= pName[i];
+    hash *= 16777619u;
+  }
+
+  return (hash == APP_BSNK_ANY_NAME) ? 1u : hash;
+}
+
+/**
+  * @brief  Check if a Broadcast_ID may match an entry of the allow-list, whatever the name
+  * @param  pList: allow-list
+  * @param  ListSize: number of entries
+  * @param  BroadcastID: advertised Broadcast_ID
+  * @retval 1 if the Broadcast_ID is allowed, 0 otherwise
+  */
+static inline uint8_t APP_BSNK_IsIDAllowed(const APP_BSNK_AllowEntry_t *pList, uint8_t ListSize, uint32_t BroadcastID)
+{
+  for (uint8_t i = 0; i < ListSize; i++)
+  {
+    if ((pList[i].BroadcastID == APP_BSNK_ANY_BROADCAST_ID) || (pList[i].BroadcastID == BroadcastID))
+    {
+      return 1u;
+    }
+  }
+  return 0u;
+}
+
+/**
+  * @brief  Walk once the AD structures of a Broadcast Source advertising data to find its name, the Broadcast Name
+  *         taking precedence over the Complete Local Name
+  * @param  pAdvData: advertising data
+  * @param  AdvDataLength: advertising data length
+  * @param  ppName: name found, not null terminated, NULL if none
+  * @param  pNameLength: name length
+  * @retval 1 if the advertising data is well formed, 0 to reject the report
+  */
+static inline uint8_t APP_BSNK_ParseAdvReport(const uint8_t *pAdvData, uint8_t AdvDataLength,
+                                              const uint8_t **ppName, uint8_t *pNameLength)
+{
+  uint8_t parse_index = 0;
+
+  *ppName = 0;
+  *pNameLength = 0;
+  while (parse_index < AdvDataLength)
+  {
+    uint8_t ad_len = pAdvData[parse_index];
+
+    if (ad_len == 0u)
+    {
+      /* Early termination of the significant part */
+      break;
+    }
+    if ((parse_index + ad_len) >= AdvDataLength)
+    {
+      /* AD structure overflowing the report */
+      return 0u;
+    }
+    if (pAdvData[parse_index + 1u] == AD_TYPE_BROADCAST_NAME)
+    {
+      *ppName = &pAdvData[parse_index + 2u];
+      *pNameLength = ad_len - 1u;
+      break;
+    }
+    if (pAdvData[parse_index + 1u] == AD_TYPE_COMPLETE_LOCAL_NAME)
+    {
+      *ppName = &pAdvData[parse_index + 2u];
+      *pNameLength = ad_len - 1u;
+    }
+    parse_index += ad_len + 1u;
+  }
+  return 1u;
+}
+
+/**
+  * @brief  Look for a Broadcast Source in the allow-list
+  * @param  pList: allow-list
+  * @param  ListSize: number of entries
+  * @param  NameHash: hash of the advertised name
+  * @param  BroadcastID: advertised Broadcast_ID
+  * @param  pPriority: priority of the matching entry
+  * @retval 1 if the source is allowed, 0 otherwise
+  */
+static inline uint8_t APP_BSNK_MatchAllowList(const APP_BSNK_AllowEntry_t *pList, uint8_t ListSize,
+                                              uint32_t NameHash, uint32_t BroadcastID, int8_t *pPriority)
+{
+  for (uint8_t i = 0; i < ListSize; i++)
+  {
+    if (((pList[i].NameHash == APP_BSNK_ANY_NAME) || (pList[i].NameHash == NameHash))
+        && ((pList[i].BroadcastID == APP_BSNK_ANY_BROADCAST_ID) || (pList[i].BroadcastID == BroadcastID)))
+    {
+      *pPriority = pList[i].Priority;
+      return 1u;
+    }
+  }
+  return 0u;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMAP_APP_BSNK_ADV_H */
@@ -0,0 +1,341 @@
+/**
+  ******************************************************************************
+  * @file    tmap_app_bsnk_bench.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the Broadcast Sink filtering of the Broadcast
+  *          Source advertising reports of tmap_app.c (tmap_app_bsnk_adv.h):
+  *          the report sets go through the same steps as in the
+  *          CAP_BROADCAST_SOURCE_ADV_REPORT_EVT handler (Broadcast_ID reject,
+  *          APP_BSNK_ParseAdvReport, name hash, APP_BSNK_MatchAllowList) and
+  *          the time per report is printed per set and allow-list size.
+  *          Not part of the firmware projects, build and run on the host:
+  *            gcc -std=c11 -O2 -Wall -o tmap_app_bsnk_bench tmap_app_bsnk_bench.c
+  *            ./tmap_app_bsnk_bench [capture.txt]
+  *          A capture file holds one report per line, as logged by a sniffer:
+  *            <Broadcast_ID hex> <advertising data hex bytes>
+  *          e.g. "0A1B2C 0616521823AB0A 083047617465203132"; it is run as one more
+  *          set. Without capture the built-in sets below are run and their
+  *          filtering results are checked.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tmap_app_bsnk_adv.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_NB_RUNS           200000          /* passes over each set */
+#define BENCH_MAX_REPORTS       64
+#define BENCH_MAX_ADV_LEN       251             /* extended advertising data in one report */
+#define BENCH_ALLOW_MAX         16
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t broadcast_id;
+  uint8_t length;
+  uint8_t data[BENCH_MAX_ADV_LEN];
+  int8_t expected;              /* allowed with the default allow-list: 1 or 0, -1 if not checked */
+} BENCH_Report_t;
+
+typedef struct
+{
+  char const *name;
+  BENCH_Report_t reports[BENCH_MAX_REPORTS];
+  uint8_t nb_reports;
+} BENCH_Set_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* Default sources of tmap_app.c */
+static const char *const Bench_DefaultSources[] = {"Public_TV_1", "Music_Player_1", "Music_Player_2"};
+static APP_BSNK_AllowEntry_t Bench_AllowList[BENCH_ALLOW_MAX];
+static BENCH_Set_t Bench_Sets[5];
+static uint8_t Bench_NbSets;
+static volatile uint32_t Bench_Sink;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Append an AD structure to a report
+  */
+static void bench_add_ad(BENCH_Report_t *p_report, uint8_t type, const void *p_value, uint8_t length)
+{
+  p_report->data[p_report->length++] = length + 1u;
+  p_report->data[p_report->length++] = type;
+  memcpy(&p_report->data[p_report->length], p_value, length);
+  p_report->length += length;
+}
+
+/**
+  * @brief  Broadcast Source advertising data: Broadcast Audio Announcement with its Broadcast_ID,
+  *         Public Broadcast Announcement and the name, optionally behind manufacturer data
+  */
+static BENCH_Report_t *bench_new_source(BENCH_Set_t *p_set, uint32_t broadcast_id, uint8_t name_type,
+                                        const char *p_name, uint8_t manuf_len, int8_t expected)
+{
+  static const uint8_t pba[] = {0x56, 0x18, 0x02, 0x03, 0x02, 0x01, 0x00};   /* UUID 0x1856, HQ audio, program info */
+  BENCH_Report_t *p_report = &p_set->reports[p_set->nb_reports++];
+  uint8_t baa[5] = {0x52, 0x18, (uint8_t)broadcast_id, (uint8_t)(broadcast_id >> 8), (uint8_t)(broadcast_id >> 16)};
+  uint8_t manuf[BENCH_MAX_ADV_LEN];
+
+  memset(p_report, 0, sizeof(*p_report));
+  p_report->broadcast_id = broadcast_id;
+  p_report->expected = expected;
+  if (manuf_len > 0u)
+  {
+    for (uint8_t i = 0; i < manuf_len; i++)
+    {
+      manuf[i] = (uint8_t)(0x30u + i);
+    }
+    bench_add_ad(p_report, 0xFFu, manuf, manuf_len);
+  }
+  bench_add_ad(p_report, 0x16u, baa, sizeof(baa));
+  bench_add_ad(p_report, 0x16u, pba, sizeof(pba));
+  if (p_name != NULL)
+  {
+    bench_add_ad(p_report, name_type, p_name, (uint8_t)strlen(p_name));
+  }
+  return p_report;
+}
+
+static void bench_build_sets(void)
+{
+  static const char *const others[] = {"Gate_12_EN", "Gate_12_FR", "Lobby_TV", "Cinema_3", "Conference", "Bar_Screen"};
+  BENCH_Set_t *p_set;
+  BENCH_Report_t *p_report;
+
+  /* crowded place: many sources, a few allowed, Broadcast Name */
+  p_set = &Bench_Sets[Bench_NbSets++];
+  p_set->name = "crowded";
+  for (uint8_t i = 0; i < 24u; i++)
+  {
+    uint8_t allowed = ((i % 8u) == 0u) ? 1u : 0u;
+
+    (void)bench_new_source(p_set, 0x100000u + i, AD_TYPE_BROADCAST_NAME,
+                           allowed ? Bench_DefaultSources[i % 3u] : others[i % 6u], 0u, (int8_t)allowed);
+  }
+
+  /* sources only named by their Complete Local Name */
+  p_set = &Bench_Sets[Bench_NbSets++];
+  p_set->name = "local name";
+  for (uint8_t i = 0; i < 16u; i++)
+  {
+    uint8_t allowed = ((i % 4u) == 0u) ? 1u : 0u;
+
+    (void)bench_new_source(p_set, 0x200000u + i, AD_TYPE_COMPLETE_LOCAL_NAME,
+                           allowed ? Bench_DefaultSources[i % 3u] : others[i % 6u], 0u, (int8_t)allowed);
+  }
+
+  /* long reports: name behind manufacturer data, and unnamed sources */
+  p_set = &Bench_Sets[Bench_NbSets++];
+  p_set->name = "long";
+  for (uint8_t i = 0; i < 16u; i++)
+  {
+    uint8_t allowed = ((i % 4u) == 1u) ? 1u : 0u;
+
+    (void)bench_new_source(p_set, 0x300000u + i, AD_TYPE_BROADCAST_NAME,
+                           ((i % 4u) == 3u) ? NULL : (allowed ? Bench_DefaultSources[i % 3u] : others[i % 6u]),
+                           (uint8_t)(40u + (i * 4u)), (int8_t)allowed);
+  }
+
+  /* malformed: AD structure overflowing the report, early termination */
+  p_set = &Bench_Sets[Bench_NbSets++];
+  p_set->name = "malformed";
+  for (uint8_t i = 0; i < 8u; i++)
+  {
+    uint8_t name_ad;
+
+    p_report = bench_new_source(p_set, 0x400000u + i, AD_TYPE_BROADCAST_NAME, Bench_DefaultSources[0], 0u, 0);
+    name_ad = p_report->length - (uint8_t)strlen(Bench_DefaultSources[0]) - 2u;
+    if ((i % 2u) == 0u)
+    {
+      /* rejected by the parser */
+      p_report->data[name_ad] += 40u;
+    }
+    else
+    {
+      /* significant part ends before the name: unnamed source, not in a list of names */
+      p_report->data[name_ad] = 0u;
+    }
+  }
+}
+
+static int bench_hex(char c)
+{
+  return isdigit((unsigned char)c) ? (c - '0') : (tolower((unsigned char)c) - 'a' + 10);
+}
+
+/**
+  * @brief  Load a captured report set, one "<Broadcast_ID> <advertising data>" report per line
+  * @retval number of reports loaded
+  */
+static int bench_load_capture(const char *p_path)
+{
+  FILE *p_file = fopen(p_path, "r");
+  BENCH_Set_t *p_set = &Bench_Sets[Bench_NbSets];
+  char line[1024];
+
+  if (p_file == NULL)
+  {
+    printf("cannot open %s\n", p_path);
+    return 0;
+  }
+  p_set->name = "capture";
+  while ((fgets(line, sizeof(line), p_file) != NULL) && (p_set->nb_reports < BENCH_MAX_REPORTS))
+  {
+    BENCH_Report_t *p_report = &p_set->reports[p_set->nb_reports];
+    char *p_cur = line;
+    char *p_end;
+
+    memset(p_report, 0, sizeof(*p_report));
+    p_report->broadcast_id = (uint32_t)strtoul(p_cur, &p_end, 16);
+    p_report->expected = -1;
+    if (p_end == p_cur)
+    {
+      continue;
+    }
+    for (p_cur = p_end; (*p_cur != '\0') && (p_report->length < BENCH_MAX_ADV_LEN); p_cur++)
+    {
+      if (isxdigit((unsigned char)p_cur[0]) && isxdigit((unsigned char)p_cur[1]))
+      {
+        p_report->data[p_report->length++] = (uint8_t)((bench_hex(p_cur[0]) << 4) | bench_hex(p_cur[1]));
+        p_cur++;
+      }
+    }
+    p_set->nb_reports++;
+  }
+  fclose(p_file);
+  if (p_set->nb_reports > 0u)
+  {
+    Bench_NbSets++;
+  }
+  return p_set->nb_reports;
+}
+
+/**
+  * @brief  Allow-list of the default sources, completed with entries matching no report
+  */
+static void bench_build_allow_list(uint8_t size)
+{
+  for (uint8_t i = 0; i < size; i++)
+  {
+    char name[16];
+
+    if (i < 3u)
+    {
+      strcpy(name, Bench_DefaultSources[i]);
+    }
+    else
+    {
+      (void)snprintf(name, sizeof(name), "Unknown_%u", (unsigned)i);
+    }
+    Bench_AllowList[i].NameHash = APP_BSNK_NameHash((const uint8_t *)name, (uint8_t)strlen(name));
+    Bench_AllowList[i].BroadcastID = APP_BSNK_ANY_BROADCAST_ID;
+    Bench_AllowList[i].Priority = (int8_t)i;
+  }
+}
+
+/**
+  * @brief  Steps of the CAP_BROADCAST_SOURCE_ADV_REPORT_EVT handler of tmap_app.c
+  * @retval 1 if the source is allowed
+  */
+static uint8_t bench_filter(const BENCH_Report_t *p_report, uint8_t allow_size)
+{
+  const uint8_t *p_name = 0;
+  uint8_t name_len = 0;
+  int8_t priority = 0;
+  uint8_t allowed = 0u;
+
+  if ((APP_BSNK_IsIDAllowed(Bench_AllowList, allow_size, p_report->broadcast_id) == 1u)
+      && (APP_BSNK_ParseAdvReport(p_report->data, p_report->length, &p_name, &name_len) == 1u))
+  {
+    allowed = APP_BSNK_MatchAllowList(Bench_AllowList, allow_size,
+                                      (p_name != 0) ? APP_BSNK_NameHash(p_name, name_len) : APP_BSNK_ANY_NAME,
+                                      p_report->broadcast_id,
+                                      &priority);
+  }
+  return allowed;
+}
+
+static double bench_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+  static const uint8_t allow_sizes[] = {3u, 8u, BENCH_ALLOW_MAX};
+  int errors = 0;
+
+  bench_build_sets();
+  if ((argc >= 2) && (bench_load_capture(argv[1]) == 0))
+  {
+    return 1;
+  }
+
+  /* filtering results with the default allow-list */
+  bench_build_allow_list(3u);
+  for (uint8_t s = 0; s < Bench_NbSets; s++)
+  {
+    for (uint8_t r = 0; r < Bench_Sets[s].nb_reports; r++)
+    {
+      const BENCH_Report_t *p_report = &Bench_Sets[s].reports[r];
+      uint8_t allowed = bench_filter(p_report, 3u);
+
+      if ((p_report->expected >= 0) && (allowed != (uint8_t)p_report->expected))
+      {
+        printf("%s report %u: allowed %u, expected %d\n", Bench_Sets[s].name, (unsigned)r, allowed, p_report->expected);
+        errors++;
+      }
+    }
+  }
+
+  printf("%-12s %8s %6s %8s %12s\n", "set", "reports", "allow", "allowed", "ns/report");
+  for (uint8_t a = 0; a < (uint8_t)sizeof(allow_sizes); a++)
+  {
+    bench_build_allow_list(allow_sizes[a]);
+    for (uint8_t s = 0; s < Bench_NbSets; s++)
+    {
+      const BENCH_Set_t *p_set = &Bench_Sets[s];
+      uint32_t nb_allowed = 0;
+      double start;
+      double elapsed;
+
+      for (uint8_t r = 0; r < p_set->nb_reports; r++)
+      {
+        nb_allowed += bench_filter(&p_set->reports[r], allow_sizes[a]);
+      }
+      start = bench_now_ns();
+      for (int run = 0; run < BENCH_NB_RUNS; run++)
+      {
+        for (uint8_t r = 0; r < p_set->nb_reports; r++)
+        {
+          Bench_Sink += bench_filter(&p_set->reports[r], allow_sizes[a]);
+        }
+      }
+      elapsed = bench_now_ns() - start;
+      printf("%-12s %8u %6u %8u %12.1f\n", p_set->name, (unsigned)p_set->nb_reports, (unsigned)allow_sizes[a],
+             (unsigned)nb_allowed, elapsed / ((double)BENCH_NB_RUNS * p_set->nb_reports));
+    }
+  }
+  printf("%s\n", (errors == 0) ? "PASSED" : "FAILED");
+
+  return (errors == 0) ? 0 : 1;
+}
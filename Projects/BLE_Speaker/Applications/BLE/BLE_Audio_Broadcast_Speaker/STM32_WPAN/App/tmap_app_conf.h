@@ -149,6 +149,22 @@ extern "C" {
                                                                                  */
 #define APP_DELAY_SNK_MAX                       (APP_DELAY_SNK_MIN + 0u)        /* No extra buffering of audio data*/
 
+/**
+ * Mono sink output: when set, a mono broadcast is decoded in a mono SAI buffer and the SAI mono mode
+ * duplicates each sample on both slots. When reset, the decoded samples are copied to the second slot
+ * by software (the copy duration is then measured, see APP_BSNK_StereoStats_t)
+ */
+#define APP_SNK_HW_SLOT_DUPLICATION             (1u)
+
+/**
+ * Broadcast Source selection: the sources matching the allow-list are ranked by RSSI, priority and recency
+ * during a selection window opened by the first matching advertising report, then the best one is synchronized
+ */
+#define APP_BSNK_SELECT_WINDOW_MS               (300u)          /* around 3 extended advertising intervals */
+#define APP_BSNK_MAX_CANDIDATES                 (4u)            /* sources ranked in a selection window */
+#define APP_BSNK_RECENCY_PENALTY_MS             (50u)           /* 1 dB of score lost per period without report */
+#define APP_BSNK_CANDIDATE_TIMEOUT_MS           (1000u)         /* source dropped when not reported for this time */
+
 /**
  * Server Preferred QoS Settings used in Unicast mode
  */
@@ -203,6 +219,7 @@ extern "C" {
 /**
  * Broadcast Sink Settings
  */
+#define MAX_BSNK_NUM_SUBGROUPS                  (2u)    /* Maximum number of subgroups of the BASE parsed by TMAP Broadcast Media Receiver role, the next ones are ignored */
 #define MAX_BSNK_SUBGROUP_CODEC_CONFIG_SIZE     (19u)   /* Maximum size of the Codec Specific Configuration for each subgroup used by TMAP Broadcast Media Receiver role */
 #define MAX_BSNK_BIS_CODEC_CONFIG_SIZE          (6u)    /* Maximum size of the Codec Specific Configuration for each BIS in each subgroup used by TMAP Broadcast Media Receiver role */
 #define MAX_BSNK_METADATA_LEN                   (50u)   /* Size of the metadata associated to the subgroup used by TMAP Broadcast Media Receiver role */
@@ -24,6 +24,8 @@
 #include "app_conf.h"
 #include "log_module.h"
 #include "stm32wbaxx_it.h"
+#include "codec_if_nfrac_pi.h"
+#include "codec_if_timer_heap.h"
 
 #if CODEC_LC3_NUM_ENCODER_CHANNEL == 0
 #include "LC3_encoder.h"
@@ -67,12 +69,19 @@
 #define AS_COMPARE_MAX          1000000         /* 1s */
 #define AS_ACCEPTABLE_WINDOWS   100u            /* windows in ticks around the interrupt for generating the event to the codec */
 
+/**
+  * @brief  Values used for the trace of the PLL N fractional regulation (gains in app_conf.h, see codec_if_nfrac_pi.h)
+  */
+#define NFRAC_TRACE_SIZE        64              /* last corrections kept for the trace dump, power of 2 */
+
 /* Private typedef -----------------------------------------------------------*/
 typedef struct
 {
-  uint32_t timestamp;
-  uint8_t is_active;
-} AUDIO_Timer_t;
+  uint32_t timestamp;   /* audio timer, 1us */
+  int16_t error;        /* requested NFRAC - NFRAC applied before the correction */
+  uint16_t applied;     /* NFRAC written to the PLL */
+  uint8_t locked;
+} NFRAC_Trace_t;
 
 /* Private macros ------------------------------------------------------------*/
 #define CRITICAL_BEGIN( )       M_BEGIN uint32_t primask_ = __get_PRIMASK( ); \
@@ -98,12 +107,25 @@ uint8_t IsTimerAutoreloading = 0;
 
 static uint8_t Codec_irq_mask_req = 0x00;
 
-static AUDIO_Timer_t Audio_Timer_List[MAX_TIMER_NB] = {0};
+/* timers found more than AS_ACCEPTABLE_WINDOWS late at a compare interrupt are dropped without
+ * notification to the codec manager, only counted in missed_cnt (see codec_if_timer_heap.h)
+ */
+static AUDIO_TimerHeap_t Audio_Timers = {0};
 
 static const float Codec_Exe_clock_Mhz[SAMPLE_FREQ_NUMBER] = LC3_EXE_CLOCK_MHZ;
 
+/* PLL N fractional regulation */
+static uint8_t NfracValid = 0;
+static NFRAC_PI_t NfracPi;
+static uint32_t NfracStartTs;
+static uint32_t NfracLockTimeUs;
+static uint32_t NfracNbCorrections;
+static NFRAC_Trace_t NfracTrace[NFRAC_TRACE_SIZE];
+
 /* Private functions prototype------------------------------------------------*/
 static void TIMAudio_Init(void);
+static uint16_t nfrac_correct(uint16_t n_frac);
+static void program_compare(uint32_t trigger_ts);
 
 /* Private user code ---------------------------------------------------------*/
 
@@ -300,8 +322,10 @@ uint16_t CODEC_CLK_GetPLLNfrac( void )
 void CODEC_CLK_SetPLLNfrac( uint16_t n_frac )
 {
   volatile uint32_t cnt = 10;
+  uint16_t applied = nfrac_correct(n_frac);
+
   __HAL_RCC_PLL1_FRACN_DISABLE();
-  __HAL_RCC_PLL1_FRACN_CONFIG((uint32_t)(n_frac));
+  __HAL_RCC_PLL1_FRACN_CONFIG((uint32_t)(applied));
   /* need to delay before enabling the register*/
   while(cnt != 0)
   {
@@ -310,6 +334,76 @@ void CODEC_CLK_SetPLLNfrac( uint16_t n_frac )
   __HAL_RCC_PLL1_FRACN_ENABLE();
 }
 
+/**
+  * @brief  Log the PLL N fractional correction state and its last corrections (timestamp, error, applied, locked),
+  *         with the number of audio timer events missed
+  * @param none
+  * @retval none
+  */
+void CODEC_CLK_DumpNfracTrace( void )
+{
+  uint32_t nb = MIN(NfracNbCorrections, NFRAC_TRACE_SIZE);
+
+  LOG_INFO_APP("NFRAC nominal %u, %lu corrections, %s, lock time %lu us, %lu audio timer events missed\n",
+               NfracPi.nominal,
+               (unsigned long)NfracNbCorrections,
+               (NfracPi.locked == 1) ? "locked" : "unlocked",
+               (unsigned long)NfracLockTimeUs,
+               (unsigned long)Audio_Timers.missed_cnt);
+  for (uint32_t i = NfracNbCorrections - nb; i < NfracNbCorrections; i++)
+  {
+    NFRAC_Trace_t entry = NfracTrace[i & (NFRAC_TRACE_SIZE - 1)];
+
+    LOG_INFO_APP("NFRAC,%lu,%d,%u,%u\n", (unsigned long)entry.timestamp, entry.error, entry.applied, entry.locked);
+    UNUSED(entry);
+  }
+}
+
+/**
+  * @brief  Regulate the NFRAC requested by the clock corrector (see codec_if_nfrac_pi.h), track the lock time and
+  *         record the correction in the trace
+  * @note  The regulation restarts from the current NFRAC, the nominal one, when the PLL has been reconfigured
+  *        (other audio frequency)
+  * @param n_frac : NFRAC requested by the codec manager
+  * @retval NFRAC to be written
+  */
+static uint16_t nfrac_correct(uint16_t n_frac)
+{
+  uint16_t current = CODEC_CLK_GetPLLNfrac();
+  uint32_t now = CODEC_CLK_GetHostTimestamp();
+  uint8_t was_locked;
+  NFRAC_Trace_t *p_entry;
+
+  if ((NfracValid == 0) || (current != NfracPi.applied))
+  {
+    /* first correction since the PLL configuration: its fractional part is the nominal one */
+    NfracValid = 1;
+    nfrac_pi_reset(&NfracPi, current);
+    NfracStartTs = now;
+    NfracLockTimeUs = 0;
+  }
+
+  was_locked = NfracPi.locked;
+  (void)nfrac_pi_step(&NfracPi, n_frac, CODEC_NFRAC_FILTER_ALPHA_Q8, CODEC_NFRAC_PI_KP_Q8, CODEC_NFRAC_PI_KI_Q8);
+  if ((was_locked == 0) && (NfracPi.locked == 1))
+  {
+    NfracLockTimeUs = now - NfracStartTs;
+  }
+  else if ((was_locked == 1) && (NfracPi.locked == 0))
+  {
+    NfracStartTs = now;
+  }
+
+  p_entry = &NfracTrace[NfracNbCorrections & (NFRAC_TRACE_SIZE - 1)];
+  p_entry->timestamp = now;
+  p_entry->error = NfracPi.error;
+  p_entry->applied = NfracPi.applied;
+  p_entry->locked = NfracPi.locked;
+  NfracNbCorrections++;
+
+  return NfracPi.applied;
+}
+
 /**
   * @brief Function called by the codec manager for requesting a event with a specified 32 bits timestamps
   * @note The code should call CODEC_CLK_trigger_event_notify() with the corresponding ID for notifying the event
@@ -327,53 +421,51 @@ int32_t CODEC_CLK_RequestTimerEvent( uint8_t ID, uint32_t trigger_ts )
     return -1;
   }
 
-  Audio_Timer_List[ID].timestamp = trigger_ts;
-  Audio_Timer_List[ID].is_active = 1;
-
-  uint8_t is_closest = 1;
-
   CRITICAL_BEGIN();
-  for (int32_t i=0 ; i < MAX_TIMER_NB ; i++)
+  timer_heap_set(&Audio_Timers, ID, trigger_ts);
+
+  /* The new ID is the next one if no other timer must run before */
+  if (!TS_IS_BEFORE(timer_heap_top_timestamp(&Audio_Timers), trigger_ts))
   {
-    /* check if it exist another timer that must run before */
-    if ((Audio_Timer_List[i].is_active == 1) && ((Audio_Timer_List[i].timestamp - trigger_ts) > 0x80000000)){
-      is_closest = 0;
-    }
+    program_compare(trigger_ts);
   }
+  CRITICAL_END();
 
-  /* The new ID is the next one */
-  if (is_closest == 1)
-  {
-    /* reconfigure audio timer */
-    if (IS_RCC_AS_RUNING)
-    {
-      uint32_t tmp_ascor = MIN((trigger_ts - CODEC_CLK_GetHostTimestamp()), AS_COMPARE_MAX);
+  return 0;
+}
 
-      /* reprogram the IP only if necessary */
-      if ((RCC->ASCOR != tmp_ascor) || (RCC->ASCAR != AS_AUTORELOAD))
-      {
-        AudioTimerCnt += RCC->ASCNTR; /* incremented AudioTimerCnt since the cnt register will be reset */
+/**
+  * @brief  Reconfigure the audio timer compare for the next event
+  * @note   To be called in critical section
+  * @param  trigger_ts : 32 bits timestamp of the next event
+  * @retval none
+  */
+static void program_compare(uint32_t trigger_ts)
+{
+  if (IS_RCC_AS_RUNING)
+  {
+    uint32_t tmp_ascor = MIN((trigger_ts - CODEC_CLK_GetHostTimestamp()), AS_COMPARE_MAX);
 
-        /* clear CEN lead to resetting all register */
-        CLEAR_BIT(RCC->ASCR, RCC_ASCR_CEN);
-        WAIT_3_CYCLES();
-        WRITE_REG(RCC->ASARR, AS_AUTORELOAD);
-        WRITE_REG(RCC->ASCR, ((CLOCK_PRESCALER-1) << RCC_ASCR_PSC_Pos) + (AS_CAPTURE_PRESCALER << RCC_ASCR_CPS_Pos));
-        WRITE_REG(RCC->ASIER, RCC_ASIER_COIE | RCC_ASIER_CAIE);
-        WRITE_REG(RCC->ASCOR, tmp_ascor);
+    /* reprogram the IP only if necessary */
+    if ((RCC->ASCOR != tmp_ascor) || (RCC->ASCAR != AS_AUTORELOAD))
+    {
+      AudioTimerCnt += RCC->ASCNTR; /* incremented AudioTimerCnt since the cnt register will be reset */
 
-        SET_BIT(RCC->ASCR, RCC_ASCR_CEN);
-      }
+      /* clear CEN lead to resetting all register */
+      CLEAR_BIT(RCC->ASCR, RCC_ASCR_CEN);
+      WAIT_3_CYCLES();
+      WRITE_REG(RCC->ASARR, AS_AUTORELOAD);
+      WRITE_REG(RCC->ASCR, ((CLOCK_PRESCALER-1) << RCC_ASCR_PSC_Pos) + (AS_CAPTURE_PRESCALER << RCC_ASCR_CPS_Pos));
+      WRITE_REG(RCC->ASIER, RCC_ASIER_COIE | RCC_ASIER_CAIE);
+      WRITE_REG(RCC->ASCOR, tmp_ascor);
 
-      IsTimerAutoreloading = 0;
+      SET_BIT(RCC->ASCR, RCC_ASCR_CEN);
     }
-  }
-  CRITICAL_END();
 
-  return 0;
+    IsTimerAutoreloading = 0;
+  }
 }
 
-
 static void TIMAudio_Init(void)
 {
   /* select clock source */
@@ -408,42 +500,31 @@ static void manage_compare_it(void)
 {
   /* Read value that has been set */
   uint32_t current_timestamp = AudioTimerCnt + RCC->ASCOR;
-  uint8_t next_id = 0xff;
-  uint32_t delta = 0xffffffff;
+  uint8_t expired_id;
 
-  for (int32_t i = 0 ; i < MAX_TIMER_NB ; i++)
+  /* the expired timers are on top of the heap: at most MAX_TIMER_NB removals of O(log n) */
+  do
   {
-    if (Audio_Timer_List[i].is_active == 1)
+    CRITICAL_BEGIN();
+    expired_id = timer_heap_pop_expired(&Audio_Timers, current_timestamp, AS_ACCEPTABLE_WINDOWS);
+    CRITICAL_END();
+
+    if (expired_id != TIMER_HEAP_NO_ID)
     {
-      /* check if this interrupt was concerning this path */
-      if ((Audio_Timer_List[i].timestamp - current_timestamp) < AS_ACCEPTABLE_WINDOWS ||
-          (Audio_Timer_List[i].timestamp - current_timestamp) > (0u - AS_ACCEPTABLE_WINDOWS))
-
-      {
-        Audio_Timer_List[i].is_active = 0;
-        CODEC_CLK_trigger_event_notify(i);
-      }
-      else
-      {
-        /* check if this path may be the next one */
-        uint32_t tmp_delta = Audio_Timer_List[i].timestamp - current_timestamp;
-        if (tmp_delta < delta)
-        {
-          next_id = i;
-          delta = tmp_delta;
-        }
-      }
+      CODEC_CLK_trigger_event_notify(expired_id);
     }
-  }
+  } while (expired_id != TIMER_HEAP_NO_ID);
 
   /* polling on register to ensure COMPARE and CNT are not equal anymore */
   /* at this time, we expect CNT must be running, and we never get stuck here */
   while (AudioTimerCnt + RCC->ASCNTR == current_timestamp)
   {}
 
-  if (next_id != 0xff)
+  if (Audio_Timers.size > 0u)
   {
-    CODEC_CLK_RequestTimerEvent(next_id, Audio_Timer_List[next_id].timestamp);
+    CRITICAL_BEGIN();
+    program_compare(timer_heap_top_timestamp(&Audio_Timers));
+    CRITICAL_END();
   }
   else
   {
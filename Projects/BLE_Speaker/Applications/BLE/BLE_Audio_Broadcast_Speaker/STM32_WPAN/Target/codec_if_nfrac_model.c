@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    codec_if_nfrac_model.c
+  * @author  MCD Application Team
+  * @brief   Host model of the PLL N fractional regulation of codec_if.c
+  *          (codec_if_nfrac_pi.h): lock time and steady-state jitter of the
+  *          applied NFRAC for a few gain sets, with a stand-in of the codec
+  *          manager clock corrector closing the loop on a drifting audio PLL.
+  *          Not part of the firmware projects, build and run on the host:
+  *            gcc -std=c11 -Wall -o codec_if_nfrac_model codec_if_nfrac_model.c -lm
+  *            ./codec_if_nfrac_model [alpha_q8 kp_q8 ki_q8]
+  *          Without arguments the gain sets below are checked against their
+  *          lock time and jitter limits.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "codec_if_nfrac_pi.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define MODEL_NOMINAL           0x1000          /* NFRAC of the PLL configuration */
+#define MODEL_PERIOD_US         10000.0         /* corrections period: one per 10 ms frame */
+#define MODEL_PPM_PER_LSB       5.0             /* audio clock deviation per NFRAC LSB */
+#define MODEL_DRIFT_PPM         40.0            /* crystal offset to be compensated */
+#define MODEL_START_PHASE_US    50.0            /* phase error when the corrector starts */
+#define MODEL_JITTER_US         2.0             /* sync event timestamp jitter, peak */
+#define MODEL_CORR_KP           2.0             /* corrector stand-in: LSB per us of phase error */
+#define MODEL_CORR_KI           0.1             /* corrector stand-in: LSB per us of accumulated phase error */
+#define MODEL_NB_CORRECTIONS    3000
+#define MODEL_STEADY_START      2000            /* jitter measured over the last corrections */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  char const *name;
+  int32_t alpha_q8;
+  int32_t kp_q8;
+  int32_t ki_q8;
+  int max_lock;                 /* corrections */
+  double max_jitter;            /* applied NFRAC rms deviation, LSB */
+} MODEL_GainSet_t;
+
+typedef struct
+{
+  int lock;                     /* corrections until the first lock, -1 if never locked */
+  double jitter;                /* applied NFRAC rms deviation in steady state, LSB */
+  double phase_rms;             /* phase error rms in steady state, us */
+} MODEL_Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const MODEL_GainSet_t Model_GainSets[] =
+{
+  /* name        alpha  kp   ki  lock  jitter */
+  {"direct",     256,   0, 256,   40,   3.0},
+  {"filtered",   128,   0, 128,   60,   2.0},
+  {"pi",          64,  64,  32,  150,   1.5},
+};
+
+static uint32_t Model_Seed;
+
+/* Private functions ---------------------------------------------------------*/
+static double model_noise(void)
+{
+  Model_Seed = (Model_Seed * 1664525u) + 1013904223u;
+  return ((double)(Model_Seed >> 8) / (double)(1u << 24)) * 2.0 - 1.0;
+}
+
+/**
+  * @brief  Closed loop run: the corrector stand-in requests an NFRAC from the measured phase error of the
+  *         sync events, the regulation under test writes the PLL, whose deviation from the frequency
+  *         that compensates the drift makes the phase error move
+  */
+static MODEL_Result_t model_run(int32_t alpha_q8, int32_t kp_q8, int32_t ki_q8)
+{
+  MODEL_Result_t result = {-1, 0.0, 0.0};
+  NFRAC_PI_t pi;
+  double ideal = MODEL_NOMINAL - (MODEL_DRIFT_PPM / MODEL_PPM_PER_LSB);
+  double phase_us = MODEL_START_PHASE_US;
+  double phase_sum = 0.0;
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  double phase_sq = 0.0;
+  int nb = 0;
+
+  Model_Seed = 1;
+  nfrac_pi_reset(&pi, MODEL_NOMINAL);
+  for (int k = 0; k < MODEL_NB_CORRECTIONS; k++)
+  {
+    double measured = phase_us + (MODEL_JITTER_US * model_noise());
+    double request = MODEL_NOMINAL - (MODEL_CORR_KP * measured) - (MODEL_CORR_KI * phase_sum);
+    uint16_t applied;
+
+    phase_sum += measured;
+    request = (request < 0.0) ? 0.0 : ((request > NFRAC_MAX) ? NFRAC_MAX : request);
+    applied = nfrac_pi_step(&pi, (uint16_t)lround(request), alpha_q8, kp_q8, ki_q8);
+    phase_us += (applied - ideal) * MODEL_PPM_PER_LSB * 1e-6 * MODEL_PERIOD_US;
+
+    if ((result.lock < 0) && (pi.locked == 1))
+    {
+      result.lock = k + 1;
+    }
+    if (k >= MODEL_STEADY_START)
+    {
+      sum += applied;
+      sum_sq += (double)applied * applied;
+      phase_sq += phase_us * phase_us;
+      nb++;
+    }
+  }
+  result.jitter = sqrt((sum_sq / nb) - ((sum / nb) * (sum / nb)));
+  result.phase_rms = sqrt(phase_sq / nb);
+
+  return result;
+}
+
+/**
+  * @brief  With the default gains the requests are applied unchanged, clamped to the 13 bits of the register
+  * @retval number of errors
+  */
+static int test_direct(void)
+{
+  NFRAC_PI_t pi;
+  int errors = 0;
+
+  Model_Seed = 7;
+  nfrac_pi_reset(&pi, MODEL_NOMINAL);
+  for (int k = 0; (k < 10000) && (errors == 0); k++)
+  {
+    uint16_t request = (uint16_t)(Model_Seed >> 19);
+    uint16_t expected = (request > NFRAC_MAX) ? NFRAC_MAX : request;
+    uint16_t applied;
+
+    (void)model_noise();
+    applied = nfrac_pi_step(&pi, request, 256, 0, 256);
+    if (applied != expected)
+    {
+      printf("direct: request %u applied %u\n", request, applied);
+      errors++;
+    }
+  }
+
+  return errors;
+}
+
+int main(int argc, char *argv[])
+{
+  int errors = 0;
+
+  if (argc == 4)
+  {
+    MODEL_Result_t result = model_run(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]));
+
+    printf("lock %d corrections, jitter %.2f LSB rms, phase %.2f us rms\n", result.lock, result.jitter, result.phase_rms);
+    return 0;
+  }
+
+  errors += test_direct();
+  printf("%-10s %5s %4s %4s %6s %8s %9s\n", "gains", "alpha", "kp", "ki", "lock", "jitter", "phase us");
+  for (size_t i = 0; i < (sizeof(Model_GainSets) / sizeof(Model_GainSets[0])); i++)
+  {
+    MODEL_GainSet_t const *p_set = &Model_GainSets[i];
+    MODEL_Result_t result = model_run(p_set->alpha_q8, p_set->kp_q8, p_set->ki_q8);
+
+    printf("%-10s %5d %4d %4d %6d %8.2f %9.2f\n", p_set->name, (int)p_set->alpha_q8, (int)p_set->kp_q8, (int)p_set->ki_q8,
+           result.lock, result.jitter, result.phase_rms);
+    if ((result.lock < 0) || (result.lock > p_set->max_lock) || (result.jitter > p_set->max_jitter))
+    {
+      printf("%s: out of limits (lock <= %d, jitter <= %.2f)\n", p_set->name, p_set->max_lock, p_set->max_jitter);
+      errors++;
+    }
+  }
+  printf("%s\n", (errors == 0) ? "PASSED" : "FAILED");
+
+  return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    codec_if_nfrac_pi.h
+  * @author  MCD Application Team
+  * @brief   Filtered PI regulation of the PLL N fractional value requested by
+  *          the codec manager clock corrector, with its lock detection.
+  *          Shared by codec_if.c and its host model codec_if_nfrac_model.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#ifndef CODEC_IF_NFRAC_PI_H
+#define CODEC_IF_NFRAC_PI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define NFRAC_MAX               0x1FFF          /* PLL1FRACN is 13 bits */
+#define NFRAC_LOCK_THRESHOLD    8               /* locked when the error stays within +/- this value ... */
+#define NFRAC_LOCK_COUNT        8               /* ... for this number of consecutive corrections */
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  The error is the NFRAC requested by the corrector minus the NFRAC currently applied: the
+  *         prebuilt codec manager doesn't expose the phase error of the sync events, its request is
+  *         the frequency it needs. The error goes through a first order low-pass (alpha) and a PI;
+  *         the integral term holds the offset from the nominal NFRAC, so the applied NFRAC follows
+  *         the request without static error.
+  *         With alpha = 1, Kp = 0 and Ki = 1 the request is applied unchanged; Ki < 1 makes the
+  *         applied NFRAC a first order follower of the request with a bandwidth of about
+  *         Ki / (2 * pi * T), T being the corrections period.
+  */
+typedef struct
+{
+  int32_t filtered_err_q8;      /* low-pass filtered error, Q8 */
+  int32_t integral_q8;          /* applied NFRAC - nominal NFRAC, Q8 */
+  uint16_t nominal;             /* NFRAC of the PLL configuration */
+  uint16_t applied;             /* last NFRAC written */
+  int16_t error;                /* last error */
+  uint8_t stable_cnt;
+  uint8_t locked;
+} NFRAC_PI_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Restart the regulation from the nominal NFRAC of a new PLL configuration
+  * @param  p_pi : regulation state
+  * @param  nominal : NFRAC of the PLL configuration
+  * @retval none
+  */
+static inline void nfrac_pi_reset(NFRAC_PI_t *p_pi, uint16_t nominal)
+{
+  p_pi->filtered_err_q8 = 0;
+  p_pi->integral_q8 = 0;
+  p_pi->nominal = nominal;
+  p_pi->applied = nominal;
+  p_pi->error = 0;
+  p_pi->stable_cnt = 0;
+  p_pi->locked = 0;
+}
+
+/**
+  * @brief  Division by 256 rounded to the nearest, half away from zero
+  */
+static inline int32_t nfrac_pi_round_q8(int32_t value_q8)
+{
+  return (value_q8 >= 0) ? ((value_q8 + 128) / 256) : ((value_q8 - 128) / 256);
+}
+
+/**
+  * @brief  One correction: filter the error, update the PI and the lock state
+  * @note   The gains are Q8 values between 0 and 256 (0.0 to 1.0)
+  * @param  p_pi : regulation state
+  * @param  request : NFRAC requested by the clock corrector
+  * @param  alpha_q8 : error low-pass coefficient
+  * @param  kp_q8 : proportional gain
+  * @param  ki_q8 : integral gain
+  * @retval NFRAC to be written, within [0, NFRAC_MAX]
+  */
+static inline uint16_t nfrac_pi_step(NFRAC_PI_t *p_pi, uint16_t request, int32_t alpha_q8, int32_t kp_q8, int32_t ki_q8)
+{
+  int32_t error = (int32_t)request - (int32_t)p_pi->applied;
+  int32_t output;
+
+  p_pi->filtered_err_q8 += (alpha_q8 * ((error * 256) - p_pi->filtered_err_q8)) / 256;
+  p_pi->integral_q8 += (ki_q8 * p_pi->filtered_err_q8) / 256;
+  if (p_pi->integral_q8 > (NFRAC_MAX * 256))
+  {
+    p_pi->integral_q8 = NFRAC_MAX * 256;
+  }
+  else if (p_pi->integral_q8 < -(NFRAC_MAX * 256))
+  {
+    p_pi->integral_q8 = -(NFRAC_MAX * 256);
+  }
+
+  output = (int32_t)p_pi->nominal + nfrac_pi_round_q8(p_pi->integral_q8 + ((kp_q8 * p_pi->filtered_err_q8) / 256));
+  if (output < 0)
+  {
+    output = 0;
+  }
+  else if (output > NFRAC_MAX)
+  {
+    output = NFRAC_MAX;
+  }
+  p_pi->applied = (uint16_t)output;
+  p_pi->error = (int16_t)error;
+
+  /* lock detection on the error */
+  if ((error <= NFRAC_LOCK_THRESHOLD) && (error >= -NFRAC_LOCK_THRESHOLD))
+  {
+    if (p_pi->stable_cnt < NFRAC_LOCK_COUNT)
+    {
+      p_pi->stable_cnt++;
+    }
+    if (p_pi->stable_cnt == NFRAC_LOCK_COUNT)
+    {
+      p_pi->locked = 1;
+    }
+  }
+  else
+  {
+    p_pi->stable_cnt = 0;
+    p_pi->locked = 0;
+  }
+
+  return p_pi->applied;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CODEC_IF_NFRAC_PI_H */
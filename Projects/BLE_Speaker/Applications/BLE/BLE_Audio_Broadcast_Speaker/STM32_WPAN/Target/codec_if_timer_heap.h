@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file    codec_if_timer_heap.h
+  * @author  MCD Application Team
+  * @brief   Audio timers of the codec manager ordered in a min-heap on their
+  *          32 bits timestamps, wrap-safe.
+  *          Shared by codec_if.c and its host test codec_if_timer_test.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+#ifndef CODEC_IF_TIMER_HEAP_H
+#define CODEC_IF_TIMER_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifndef MAX_TIMER_NB
+#error "MAX_TIMER_NB must be defined before including codec_if_timer_heap.h"
+#endif /* MAX_TIMER_NB */
+
+/* Exported constants --------------------------------------------------------*/
+#define TIMER_HEAP_NO_ID        0xffu
+
+/* Exported macros -----------------------------------------------------------*/
+/* wrap-safe ordering of 32 bits timestamps less than 2^31 ticks apart */
+#define TS_IS_BEFORE(a, b)      ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t timestamp;
+  uint8_t is_active;
+  uint8_t heap_pos;     /* position in heap[] when active */
+} AUDIO_Timer_t;
+
+/**
+  * @brief  The next event is always the timer of heap[0].
+  *         A timer found late at a compare interrupt, outside of the acceptance window, is dropped:
+  *         the codec manager is not notified of it, it is only counted in missed_cnt.
+  */
+typedef struct
+{
+  AUDIO_Timer_t list[MAX_TIMER_NB];     /* indexed by path ID */
+  uint8_t heap[MAX_TIMER_NB];           /* IDs of the active timers, min-heap on their timestamps */
+  uint8_t size;                         /* number of active timers */
+  uint32_t missed_cnt;                  /* late timers dropped without notification */
+} AUDIO_TimerHeap_t;
+
+/* Exported functions --------------------------------------------------------*/
+static inline void timer_heap_swap(AUDIO_TimerHeap_t *p_heap, uint8_t pos_a, uint8_t pos_b)
+{
+  uint8_t id = p_heap->heap[pos_a];
+
+  p_heap->heap[pos_a] = p_heap->heap[pos_b];
+  p_heap->heap[pos_b] = id;
+  p_heap->list[p_heap->heap[pos_a]].heap_pos = pos_a;
+  p_heap->list[p_heap->heap[pos_b]].heap_pos = pos_b;
+}
+
+static inline void timer_heap_sift_up(AUDIO_TimerHeap_t *p_heap, uint8_t pos)
+{
+  while (pos > 0u)
+  {
+    uint8_t parent = (pos - 1u) / 2u;
+
+    if (!TS_IS_BEFORE(p_heap->list[p_heap->heap[pos]].timestamp,
+                      p_heap->list[p_heap->heap[parent]].timestamp))
+    {
+      break;
+    }
+    timer_heap_swap(p_heap, pos, parent);
+    pos = parent;
+  }
+}
+
+static inline void timer_heap_sift_down(AUDIO_TimerHeap_t *p_heap, uint8_t pos)
+{
+  for (;;)
+  {
+    uint8_t child = (2u * pos) + 1u;
+    uint8_t smallest = pos;
+
+    if ((child < p_heap->size)
+        && TS_IS_BEFORE(p_heap->list[p_heap->heap[child]].timestamp,
+                        p_heap->list[p_heap->heap[smallest]].timestamp))
+    {
+      smallest = child;
+    }
+    child++;
+    if ((child < p_heap->size)
+        && TS_IS_BEFORE(p_heap->list[p_heap->heap[child]].timestamp,
+                        p_heap->list[p_heap->heap[smallest]].timestamp))
+    {
+      smallest = child;
+    }
+    if (smallest == pos)
+    {
+      break;
+    }
+    timer_heap_swap(p_heap, pos, smallest);
+    pos = smallest;
+  }
+}
+
+/**
+  * @brief  Timestamp of the next event
+  * @note   To be called with a non empty heap
+  * @param  p_heap : timers
+  * @retval 32 bits timestamp
+  */
+static inline uint32_t timer_heap_top_timestamp(AUDIO_TimerHeap_t const *p_heap)
+{
+  return p_heap->list[p_heap->heap[0]].timestamp;
+}
+
+/**
+  * @brief  Activate a timer or move an active one to a new timestamp
+  * @note   To be called in critical section
+  * @param  p_heap : timers
+  * @param  ID : path identifier, lower than MAX_TIMER_NB
+  * @param  trigger_ts : 32 bits timestamp
+  * @retval none
+  */
+static inline void timer_heap_set(AUDIO_TimerHeap_t *p_heap, uint8_t ID, uint32_t trigger_ts)
+{
+  AUDIO_Timer_t *p_timer = &p_heap->list[ID];
+
+  if (p_timer->is_active == 1u)
+  {
+    uint8_t earlier = TS_IS_BEFORE(trigger_ts, p_timer->timestamp);
+
+    p_timer->timestamp = trigger_ts;
+    if (earlier)
+    {
+      timer_heap_sift_up(p_heap, p_timer->heap_pos);
+    }
+    else
+    {
+      timer_heap_sift_down(p_heap, p_timer->heap_pos);
+    }
+  }
+  else
+  {
+    p_timer->timestamp = trigger_ts;
+    p_timer->is_active = 1u;
+    p_timer->heap_pos = p_heap->size;
+    p_heap->heap[p_heap->size++] = ID;
+    timer_heap_sift_up(p_heap, p_timer->heap_pos);
+  }
+}
+
+/**
+  * @brief  Deactivate the next timer
+  * @note   To be called in critical section with a non empty heap
+  * @param  p_heap : timers
+  * @retval none
+  */
+static inline void timer_heap_remove_top(AUDIO_TimerHeap_t *p_heap)
+{
+  p_heap->list[p_heap->heap[0]].is_active = 0u;
+  p_heap->size--;
+  if (p_heap->size > 0u)
+  {
+    p_heap->heap[0] = p_heap->heap[p_heap->size];
+    p_heap->list[p_heap->heap[0]].heap_pos = 0u;
+    timer_heap_sift_down(p_heap, 0u);
+  }
+}
+
+/**
+  * @brief  Deactivate the next timer if it is concerned by the compare interrupt
+  * @note   To be called in critical section. Timers more than window ticks late are dropped on the
+  *         way, silently: their expiry is never reported, they are only counted in missed_cnt
+  * @param  p_heap : timers
+  * @param  current_timestamp : timestamp of the compare interrupt
+  * @param  window : ticks around current_timestamp in which a timer is expired
+  * @retval ID of the expired timer, TIMER_HEAP_NO_ID if none
+  */
+static inline uint8_t timer_heap_pop_expired(AUDIO_TimerHeap_t *p_heap, uint32_t current_timestamp, uint32_t window)
+{
+  uint8_t id = TIMER_HEAP_NO_ID;
+  uint8_t searching = 1u;
+
+  while ((searching == 1u) && (p_heap->size > 0u))
+  {
+    uint32_t delta = timer_heap_top_timestamp(p_heap) - current_timestamp;
+
+    /* check if this interrupt was concerning this path */
+    if ((delta < window) || (delta > (0u - window)))
+    {
+      id = p_heap->heap[0];
+      timer_heap_remove_top(p_heap);
+      searching = 0u;
+    }
+    else if (TS_IS_BEFORE(timer_heap_top_timestamp(p_heap), current_timestamp))
+    {
+      /* missed: it would never match a compare and would hide the next events */
+      timer_heap_remove_top(p_heap);
+      p_heap->missed_cnt++;
+    }
+    else
+    {
+      searching = 0u;
+    }
+  }
+
+  return id;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CODEC_IF_TIMER_HEAP_H */
@@ -0,0 +1,167 @@
+/**
+  ******************************************************************************
+  * @file    codec_if_timer_test.c
+  * @author  MCD Application Team
+  * @brief   Host test of the audio timers min-heap of codec_if.c
+  *          (codec_if_timer_heap.h): events are served in the wrap-safe order
+  *          of their 32 bits timestamps and late timers are dropped without
+  *          being served, only counted.
+  *          Not part of the firmware projects, build and run on the host:
+  *            gcc -std=c11 -Wall -o codec_if_timer_test codec_if_timer_test.c
+  *            ./codec_if_timer_test
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define MAX_TIMER_NB            4u              /* MAX_PATH_NB + 1 of the codec manager */
+#define AS_ACCEPTABLE_WINDOWS   100u            /* as in codec_if.c */
+
+#define TEST_NB_RUNS            200000
+#define TEST_NB_SETS            6
+
+#include "codec_if_timer_heap.h"
+
+/* Private variables ---------------------------------------------------------*/
+static AUDIO_TimerHeap_t Audio_Timers;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Earliest active timer, found by a linear search
+  * @retval ID of the earliest timer, TIMER_HEAP_NO_ID if none
+  */
+static uint8_t earliest_timer(void)
+{
+  uint8_t best = TIMER_HEAP_NO_ID;
+
+  for (uint8_t i = 0; i < MAX_TIMER_NB; i++)
+  {
+    if ((Audio_Timers.list[i].is_active == 1)
+        && ((best == TIMER_HEAP_NO_ID) || TS_IS_BEFORE(Audio_Timers.list[i].timestamp, Audio_Timers.list[best].timestamp)))
+    {
+      best = i;
+    }
+  }
+  return best;
+}
+
+/**
+  * @brief  Random timers set and moved around the 32 bits wrap, then served one by one at their timestamp
+  * @retval number of errors
+  */
+static int test_wrap_ordering(void)
+{
+  int errors = 0;
+
+  srand(1);
+  for (int run = 0; (run < TEST_NB_RUNS) && (errors == 0); run++)
+  {
+    /* half of the runs straddle the wrap */
+    uint32_t base = ((rand() & 1) != 0) ? (0xFFFFFF00u + (uint32_t)(rand() % 512)) : (uint32_t)rand();
+    uint32_t prev_ts = 0;
+    uint8_t first = 1;
+
+    for (int k = 0; k < TEST_NB_SETS; k++)
+    {
+      timer_heap_set(&Audio_Timers, (uint8_t)(rand() % MAX_TIMER_NB), base + (uint32_t)(rand() % 100000));
+    }
+    while ((Audio_Timers.size > 0u) && (errors == 0))
+    {
+      uint8_t best = earliest_timer();
+      uint32_t ts = Audio_Timers.list[Audio_Timers.heap[0]].timestamp;
+
+      if (ts != Audio_Timers.list[best].timestamp)
+      {
+        printf("run %d: heap top 0x%08X, earliest 0x%08X\n", run, (unsigned)ts, (unsigned)Audio_Timers.list[best].timestamp);
+        errors++;
+      }
+      else if ((first == 0) && TS_IS_BEFORE(ts, prev_ts))
+      {
+        printf("run %d: 0x%08X served after 0x%08X\n", run, (unsigned)ts, (unsigned)prev_ts);
+        errors++;
+      }
+      else if (timer_heap_pop_expired(&Audio_Timers, ts, AS_ACCEPTABLE_WINDOWS) == TIMER_HEAP_NO_ID)
+      {
+        printf("run %d: timer at 0x%08X not served at its timestamp\n", run, (unsigned)ts);
+        errors++;
+      }
+      prev_ts = ts;
+      first = 0;
+    }
+  }
+  if (Audio_Timers.missed_cnt != 0u)
+  {
+    printf("%u timers missed while served on time\n", (unsigned)Audio_Timers.missed_cnt);
+    errors++;
+  }
+
+  return errors;
+}
+
+/**
+  * @brief  Timers late by more than AS_ACCEPTABLE_WINDOWS across the wrap are dropped without being served, only counted
+  * @retval number of errors
+  */
+static int test_missed(void)
+{
+  int errors = 0;
+  uint8_t id;
+
+  Audio_Timers.missed_cnt = 0;
+  timer_heap_set(&Audio_Timers, 0, 0xFFFFFFF0u);
+  timer_heap_set(&Audio_Timers, 1, 500u);
+  timer_heap_set(&Audio_Timers, 2, 1000u);
+  timer_heap_set(&Audio_Timers, 3, 5000u);
+
+  id = timer_heap_pop_expired(&Audio_Timers, 1000u, AS_ACCEPTABLE_WINDOWS);
+  if ((id != 2) || (Audio_Timers.missed_cnt != 2u) || (Audio_Timers.size != 1u))
+  {
+    printf("missed: id %d, %u missed, %d left\n", id, (unsigned)Audio_Timers.missed_cnt, Audio_Timers.size);
+    errors++;
+  }
+  /* dropped silently: deactivated without ever being returned */
+  if ((Audio_Timers.list[0].is_active != 0u) || (Audio_Timers.list[1].is_active != 0u))
+  {
+    printf("missed: late timers still active\n");
+    errors++;
+  }
+  /* too early: nothing served, nothing dropped */
+  id = timer_heap_pop_expired(&Audio_Timers, 1000u, AS_ACCEPTABLE_WINDOWS);
+  if ((id != TIMER_HEAP_NO_ID) || (Audio_Timers.missed_cnt != 2u) || (Audio_Timers.size != 1u))
+  {
+    printf("early: id %d, %u missed, %d left\n", id, (unsigned)Audio_Timers.missed_cnt, Audio_Timers.size);
+    errors++;
+  }
+  id = timer_heap_pop_expired(&Audio_Timers, 5000u + AS_ACCEPTABLE_WINDOWS - 1u, AS_ACCEPTABLE_WINDOWS);
+  if ((id != 3) || (Audio_Timers.size != 0u))
+  {
+    printf("window: id %d, %d left\n", id, Audio_Timers.size);
+    errors++;
+  }
+
+  return errors;
+}
+
+int main(void)
+{
+  int errors = test_wrap_ordering();
+
+  errors += test_missed();
+  printf("%s\n", (errors == 0) ? "PASSED" : "FAILED");
+
+  return (errors == 0) ? 0 : 1;
+}
@@ -996,7 +996,8 @@ void Stop_TxAudio(void)
 
 static void App_AudioKit_OutProcessMngr(void)
 {
-  /* copy data to audio kit in */
+  /* hand over the decoded frame to audio kit in (UTIL_AUDIO_IN_ZERO_COPY: no copy); the LC3 half
+     requested below is never the one handed over, it is only rewritten after the next interrupt */
   UTIL_AUDIO_CAPTURE_TxComplete_cb((pOutLC3data-&aLC3OutBuff[0])*sizeof(uint16_t), MAIN_PATH);
 
   pOutLC3data += Sink_frame_size/2;
@@ -40,6 +40,9 @@ extern "C" {
 
 #define STM32_AUDIO_USE_EXTERN_BUFF
 
+/* main path: AudioChain reads the LC3 decoded samples in place in aLC3OutBuff (no capture copy nor buffer) */
+#define UTIL_AUDIO_IN_ZERO_COPY
+
 //#define USE_WAVEFILE_IN
 
 #endif /* __STM32_AUDIO_CONF_H */
@@ -142,6 +142,7 @@ typedef struct
 typedef struct
 {
   bool                          isMono2Stereo;
+  bool                          isZeroCopy;       /* buffInfo points on the DMA half just completed instead of holding a copy */
   uint8_t                       isDmaInterleaved;
   uint8_t                       nbCh;
   uint8_t                       nbHwCh;
@@ -229,6 +230,7 @@ VAR_DECLARE_ALIGN4_AT_SECTION(int8_t,  UtilAudio_InBuffAlternate[UTIL_AUDIO_OUT_
   static void s_inTxCplt_16bitDeInt_to_16bitInt_processCh(int16_t *pInSample, int16_t *pOutSample, uint8_t nbCh, uint8_t idxChannel, uint32_t nbSamples, uint16_t dmaResoBytes);
 
   static void s_inTxCplt_pcmbitInterleaved_cb(uint32_t                 const offsetSpleBytes, int32_t const instance);   /* if data from DMA is already pcm16-bit interleaved (LineIn or MDF)*/
+  static void s_inTxCplt_pcmbitInterleaved_zeroCopy_cb(uint32_t        const offsetSpleBytes, int32_t const instance);   /* same without copy: the DMA half is handed over to the audio buffer */
   static void s_inTxCplt_pcm16bitInterleaved_m2s_cb(uint32_t           const offsetSpleBytes, int32_t const instance);   /* if data from DMA is already pcm16-bit interleaved (LineIn or MDF)*/
   static void s_inTxCplt_pcm32bitInterleaved_m2s_cb(uint32_t           const offsetSpleBytes, int32_t const instance);   /* if data from DMA is already pcm16-bit interleaved (LineIn or MDF)*/
 
@@ -1537,14 +1539,46 @@ static int32_t s_capture_init_pcm(UTIL_AUDIO_context_t *const pContext)
       break;
   }
 
-  error =  AudioBuffer_create(&pContext->rec.buffInfo,
-                              pContext->rec.nbCh,
-                              UTIL_AUDIO_IN_FREQUENCY,
-                              pContext->rec.nbSamples,
-                              ABUFF_FORMAT_TIME,
-                              bufferType,
-                              ABUFF_FORMAT_INTERLEAVED,
-                              UTIL_AUDIO_MEMPOOL);
+  bool isZeroCopy = false;
+  #ifdef UTIL_AUDIO_IN_ZERO_COPY /* For main path */
+  /* only possible if the DMA samples have already the audio buffer format (no conversion) */
+  isZeroCopy = (pContext == &ContextStatic)                                                    &&
+               (UTIL_AUDIO_IN_IS_DMA_DATA_INTERLEAVED == 1U)                                   &&
+               (!pContext->rec.isMono2Stereo)                                                  &&
+               ((UTIL_AUDIO_IN_DMA_BIT_RESOLUTION / 8U) == (uint32_t)ABUFF_SAMPLES_SIZE(bufferType));
+  #endif
+  pContext->rec.isZeroCopy = isZeroCopy;
+
+  if (isZeroCopy)
+  {
+    /* no samples allocation: the audio buffer will point on the DMA half buffers */
+    error = AudioBuffer_init(&pContext->rec.buffInfo, UTIL_AUDIO_MEMPOOL);
+    if (AudioError_isOk(error))
+    {
+      error = AudioBuffer_config(&pContext->rec.buffInfo,
+                                 pContext->rec.nbCh,
+                                 UTIL_AUDIO_IN_FREQUENCY,
+                                 pContext->rec.nbSamples,
+                                 ABUFF_FORMAT_TIME,
+                                 bufferType,
+                                 ABUFF_FORMAT_INTERLEAVED);
+    }
+    if (AudioError_isOk(error))
+    {
+      error = AudioBuffer_setPdata(&pContext->rec.buffInfo, pBuff);
+    }
+  }
+  else
+  {
+    error =  AudioBuffer_create(&pContext->rec.buffInfo,
+                                pContext->rec.nbCh,
+                                UTIL_AUDIO_IN_FREQUENCY,
+                                pContext->rec.nbSamples,
+                                ABUFF_FORMAT_TIME,
+                                bufferType,
+                                ABUFF_FORMAT_INTERLEAVED,
+                                UTIL_AUDIO_MEMPOOL);
+  }
 
   if (AudioError_isOk(error))
   {
@@ -1591,6 +1625,10 @@ static int32_t s_capture_init_pcm(UTIL_AUDIO_context_t *const pContext)
       {
         pContext->rec.txCpltCb = s_inTxCplt_pcm16bitInterleaved_m2s_cb;
       }
+      else if (pContext->rec.isZeroCopy)
+      {
+        pContext->rec.txCpltCb = s_inTxCplt_pcmbitInterleaved_zeroCopy_cb;
+      }
       else
       {
         pContext->rec.txCpltCb = s_inTxCplt_pcmbitInterleaved_cb;
@@ -1602,6 +1640,10 @@ static int32_t s_capture_init_pcm(UTIL_AUDIO_context_t *const pContext)
       {
         pContext->rec.txCpltCb = s_inTxCplt_pcm32bitInterleaved_m2s_cb;
       }
+      else if (pContext->rec.isZeroCopy)
+      {
+        pContext->rec.txCpltCb = s_inTxCplt_pcmbitInterleaved_zeroCopy_cb;
+      }
       else
       {
         pContext->rec.txCpltCb = s_inTxCplt_pcmbitInterleaved_cb;
@@ -1820,6 +1862,18 @@ static void s_inTxCplt_pcmbitInterleaved_cb(uint32_t const offsetSpleBytes, int3
   memcpy(pOutSample_u8, pInSample_u8, pContext->rec.halfOffsetBytes);
 }
 
+/* The DMA half just completed becomes the audio buffer data: the producer must not write
+   this half again before the next callback, i.e. before the consumer has read it */
+static void s_inTxCplt_pcmbitInterleaved_zeroCopy_cb(uint32_t const offsetSpleBytes, int32_t const instance)
+{
+  uint8_t *pInSample_u8 = (uint8_t *)ContextStatic.rec.pBaseAddr + offsetSpleBytes;
+
+  if (AudioError_isError(AudioBuffer_setPdata(&ContextStatic.rec.buffInfo, pInSample_u8)))
+  {
+    UTIL_AUDIO_error();
+  }
+}
+
 static void s_inTxCplt_pcm16bitInterleaved_m2s_cb(uint32_t const offsetSpleBytes, int32_t const instance)
 {
   uint32_t nbMicConnected = UTIL_AUDIO_IN_HW_CH_NB;
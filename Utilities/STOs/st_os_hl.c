@@ -391,6 +391,62 @@ bool st_os_hl_is_task_triggered(void *const pHdle)
 }
 
 
+/**
+* @brief  returns stack and queue peak levels of a task since its creation
+* @param  pHdle:       anonymous OS Thread handler pointer
+* @param  pStackFree:  returned minimum free stack in bytes (0 if high water mark is not available)
+* @param  pQueueMax:   returned max number of messages in queue
+* @retval true if stack high water mark is available, else false
+*/
+bool st_os_hl_task_get_levels(void *const pHdle, uint32_t *const pStackFree, uint32_t *const pQueueMax)
+{
+  context_triggeredTask_t *const pTaskHdle = (context_triggeredTask_t *)pHdle;
+  bool                           ok        = false;
+
+  *pStackFree = 0UL;
+  *pQueueMax  = 0UL;
+  if (pTaskHdle != NULL)
+  {
+    #if defined(INCLUDE_uxTaskGetStackHighWaterMark) && (INCLUDE_uxTaskGetStackHighWaterMark != 0)
+    *pStackFree = st_os_task_get_stack_high_water_mark(&pTaskHdle->task.stos) * sizeof(StackType_t);
+    ok          = true;
+    #endif
+    *pQueueMax  = pTaskHdle->queue.msgMax;
+  }
+  return ok;
+}
+
+
+/**
+* @brief  restarts the queue peak level measure of a task; the stack high water mark can't be restarted
+*         (it is the deepest stack use since the task creation)
+* @param  pHdle:       anonymous OS Thread handler pointer
+* @retval None
+*/
+void st_os_hl_task_reset_queue_max(void *const pHdle)
+{
+  context_triggeredTask_t *const pTaskHdle = (context_triggeredTask_t *)pHdle;
+
+  if (pTaskHdle != NULL)
+  {
+    pTaskHdle->queue.msgMax = pTaskHdle->queue.msg;
+  }
+}
+
+
+/**
+* @brief  returns the number of messages waiting in the queue of a task
+* @param  pHdle: anonymous OS Thread handler pointer
+* @retval queue level, 0 if no task
+*/
+uint32_t st_os_hl_task_get_queue_level(void *const pHdle)
+{
+  context_triggeredTask_t const *const pTaskHdle = (context_triggeredTask_t const *)pHdle;
+
+  return (pTaskHdle != NULL) ? pTaskHdle->queue.msg : 0UL;
+}
+
+
 /**
 * @brief  sends task Pushed message
 * @param  pHdle: anonymous OS Thread handler pointer
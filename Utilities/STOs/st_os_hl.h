@@ -166,6 +166,14 @@ void st_os_hl_task_thread(void               *const pHdle,
 
 bool st_os_hl_is_task_triggered(void *const pHdle);
 
+bool st_os_hl_task_get_levels(void          *const pHdle,                                          /* CMSISOS task handle pointer */
+                              uint32_t      *const pStackFree,                                     /* returned min free stack in bytes */
+                              uint32_t      *const pQueueMax);                                     /* returned max queue level */
+
+void st_os_hl_task_reset_queue_max(void     *const pHdle);                                         /* CMSISOS task handle pointer */
+
+uint32_t st_os_hl_task_get_queue_level(void *const pHdle);                                         /* CMSISOS task handle pointer */
+
 
 /* Prototypes of weak or extern functions used by st_os_hl------------------- */
 void StartIdleMonitor(void);